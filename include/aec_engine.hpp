@@ -0,0 +1,195 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <fftw3.h>
+#include <sys/types.h>
+#include <array>
+#include <atomic>
+#include <complex>
+#include <semaphore>
+#include <span>
+#include <thread>
+#include <vector>
+
+/*
+  Acoustic echo canceller working in float. The echo path is modelled by a partitioned block frequency domain
+  adaptive filter and a copy of it that is only updated while the adaptation is doing better, so double talk can not
+  make the output diverge. What is left of the echo is removed by a spectral suppressor.
+
+  The delay between the probe and the microphone is estimated from the correlation of their envelopes and compensated
+  before the filter, so the filter only has to cover the echo tail. When both microphone channels carry the same
+  signal a single filter is used for them.
+
+  The suppressor works on frames of two blocks weighted by a square root Hann window and overlap-added, so its output
+  is one block late.
+*/
+
+class AecEngine {
+ public:
+  AecEngine();
+  AecEngine(const AecEngine&) = delete;
+  auto operator=(const AecEngine&) -> AecEngine& = delete;
+  AecEngine(const AecEngine&&) = delete;
+  auto operator=(const AecEngine&&) -> AecEngine& = delete;
+  ~AecEngine();
+
+  // Allocates the filters. Every block given to process must be frame_size long.
+
+  void init(const uint& rate, const uint& frame_size, const uint& filter_length_ms);
+
+  void reset();
+
+  void set_residual_echo_suppression(const int& value);  // dB
+
+  void set_near_end_suppression(const int& value);  // dB
+
+  /*
+    The right channel is processed in a worker thread when two filters are in use. The caller never waits for it: the
+    results are given one block later. When the worker is late its result is dropped and the right channel takes the
+    output of the left filter until the worker is free again.
+  */
+
+  void set_multithreading(const bool& state);
+
+  void process(std::span<const float> mic_left,
+               std::span<const float> mic_right,
+               std::span<const float> probe,
+               std::span<float> out_left,
+               std::span<float> out_right);
+
+  [[nodiscard]] auto get_delay() const -> uint;  // frames
+
+  [[nodiscard]] auto get_latency() const -> uint;  // frames
+
+ private:
+  // The delayed far end spectra of every partition and the far end statistics a block is filtered with.
+
+  struct FarEnd {
+    std::vector<std::complex<float>> spectra;  // n_partitions * n_bins, partition p at p * n_bins
+
+    std::vector<float> power;  // n_bins
+
+    float energy = 0.0F;
+  };
+
+  struct Channel {
+    std::vector<std::complex<float>> background, foreground;  // n_partitions * n_bins
+
+    std::vector<std::complex<float>> error_spectrum;
+
+    std::vector<float> error_power, echo_power, gain;
+
+    std::vector<float> error_background, error_foreground, echo;
+
+    std::vector<float> echo_previous, error_previous, overlap;  // last half of the suppressor frames
+
+    float energy_background = 0.0F, energy_foreground = 0.0F;
+
+    float leak = 0.0F;  // fraction of the echo estimate that is still in the error
+
+    uint constrained_partition = 0U;
+
+    // fftw plans may only be executed on arrays with the alignment of the ones used to create them
+
+    float* time = nullptr;
+
+    fftwf_complex* freq = nullptr;
+  };
+
+  bool initialized = false;
+  bool shared = false;
+
+  uint rate = 0U;
+  uint block_size = 0U;
+  uint fft_size = 0U;
+  uint n_bins = 0U;
+  uint n_partitions = 0U;
+  uint max_delay = 0U;  // blocks
+  uint delay = 0U;      // blocks
+  uint n_history = 0U;  // far end spectra kept for the filter and the delay compensation
+  uint head = 0U;
+
+  uint n_envelope = 0U;
+  uint envelope_pos = 0U;
+  uint envelope_filled = 0U;
+  uint search_countdown = 0U;
+  uint delay_candidate = 0U;
+
+  float far_energy = 0.0F;  // of the last probe block
+  float residual_floor = 1e-3F;
+  float near_end_floor = 1e-3F;
+
+  std::vector<float> far_time;
+
+  std::vector<std::complex<float>> far_spectra;  // n_history * n_bins
+
+  std::vector<float> far_power;
+
+  std::vector<float> far_envelope, mic_envelope;
+
+  std::vector<float> window;  // fft_size
+
+  std::array<Channel, 2U> channels;
+
+  fftwf_plan forward = nullptr;
+  fftwf_plan backward = nullptr;
+
+  std::thread worker;
+
+  std::atomic<bool> quit_worker = false;
+
+  std::binary_semaphore worker_start{0}, worker_done{0};
+
+  bool worker_busy = false;
+  bool worker_late = false;  // the worker missed a block and its result is dropped
+
+  FarEnd far_block, worker_far;  // the worker owns worker_far while it is busy
+
+  std::vector<float> worker_mic, worker_out;  // owned by the worker while it is busy
+
+  std::vector<float> pending_left;  // left output of the last block, given with the worker result
+
+  void free_buffers();
+
+  void stop_worker();
+
+  void wait_worker();
+
+  void push_far_end(std::span<const float> probe);
+
+  void gather_far_end(FarEnd& far);
+
+  void estimate_delay(std::span<const float> mic_left, std::span<const float> mic_right, std::span<const float> probe);
+
+  void shift_filters(const int& partitions);
+
+  void filter(Channel& c,
+              const FarEnd& far,
+              std::span<const std::complex<float>> weights,
+              std::span<const float> mic,
+              std::span<float> error);
+
+  void adapt(Channel& c, const FarEnd& far);
+
+  void suppress(Channel& c, std::span<float> output);
+
+  void process_channel(Channel& c, const FarEnd& far, std::span<const float> mic, std::span<float> output);
+};
@@ -24,7 +24,6 @@
 #include <sys/types.h>
 #include <span>
 #include <string>
-#include <thread>
 #include <vector>
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
@@ -92,8 +91,6 @@ class AutoGain : public PluginBase {
 
   ebur128_state* ebur_state = nullptr;
 
-  std::vector<std::thread> mythreads;
-
   auto init_ebur128() -> bool;
 
   static auto parse_reference_key(const std::string& key) -> Reference;
@@ -0,0 +1,117 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <array>
+#include <span>
+#include <utility>
+#include <vector>
+
+/*
+  Parametric equalizer made of a cascade of second order sections. Both channels are stored side by side in each
+  coefficient and state array so that every section filters the two channels with the same vector instructions.
+*/
+
+class BiquadEqualizer {
+ public:
+  // The order matches the bandtype and bandmode enums of the equalizer channel schema.
+
+  enum class BandType {
+    off,
+    bell,
+    hi_pass,
+    hi_shelf,
+    lo_pass,
+    lo_shelf,
+    notch,
+    resonance,
+    allpass,
+    bandpass,
+    ladder_pass,
+    ladder_rej
+  };
+
+  enum class BandMode { rlc_bt, rlc_mt, bwc_bt, bwc_mt, lrx_bt, lrx_mt, apo_dr };
+
+  struct Band {
+    BandType type = BandType::off;
+    BandMode mode = BandMode::rlc_bt;
+    uint slope = 1U;  // from 1 to 4
+    double frequency = 1000.0;
+    double gain = 0.0;   // dB
+    double q = 4.36;
+    double width = 4.0;  // octaves
+    bool solo = false;
+    bool mute = false;
+  };
+
+  BiquadEqualizer() = default;
+  BiquadEqualizer(const BiquadEqualizer&) = delete;
+  auto operator=(const BiquadEqualizer&) -> BiquadEqualizer& = delete;
+  BiquadEqualizer(const BiquadEqualizer&&) = delete;
+  auto operator=(const BiquadEqualizer&&) -> BiquadEqualizer& = delete;
+  ~BiquadEqualizer() = default;
+
+  void set_rate(const uint& value);
+
+  void set_n_samples(const uint& value);
+
+  void set_bands(const std::vector<Band>& left, const std::vector<Band>& right);
+
+  /*
+    Takes the bands and the sections designed by other, which has to use the same rate, and gives it the old ones.
+    The filter state of the sections both have is kept. Nothing is allocated, so the realtime thread only waits for a
+    few swaps.
+  */
+
+  void swap_design(BiquadEqualizer& other);
+
+  void reset();
+
+  [[nodiscard]] auto get_rate() const -> uint;
+
+  [[nodiscard]] auto get_bands() const -> std::pair<std::vector<Band>, std::vector<Band>>;
+
+  void process(std::span<float>& left_in,
+               std::span<float>& right_in,
+               std::span<float>& left_out,
+               std::span<float>& right_out);
+
+  // Magnitude response in dB of the given channel (0 left, 1 right) at the given frequencies.
+
+  [[nodiscard]] auto get_response(const std::vector<double>& frequencies, const uint& channel) const
+      -> std::vector<double>;
+
+ private:
+  using Lanes = std::array<double, 2U>;
+
+  uint rate = 0U;
+
+  std::vector<Band> bands_left, bands_right;
+
+  std::vector<Lanes> b0, b1, b2, a1, a2;
+
+  std::vector<Lanes> z1, z2;
+
+  std::vector<double> buffer;  // interleaved
+
+  void design();
+};
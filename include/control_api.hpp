@@ -0,0 +1,124 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+#include <sigc++/connection.h>
+#include <sys/types.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "effects_base.hpp"
+#include "plugin_base.hpp"
+
+/*
+  D-Bus object exported next to the application object, at <application path>/Control, so that other programs can
+  automate the effects without touching dconf. Chains are "input" and "output" and effects are named like in the
+  "plugins" key, for example "equalizer#0". The channels of the equalizer are "equalizer#0/leftchannel" and
+  "equalizer#0/rightchannel". Parameters are the GSettings keys of the effect.
+
+  Writes go to the settings objects the effects share with the window, so they are applied right away and the values
+  reach dconf in batches. A batch is validated before any of its values is written.
+
+  Meter subscriptions belong to the client that made them and are dropped when it leaves the bus.
+*/
+
+class ControlApi {
+ public:
+  ControlApi(GDBusConnection* connection, const std::string& application_path, EffectsBase* sie, EffectsBase* soe);
+  ControlApi(const ControlApi&) = delete;
+  auto operator=(const ControlApi&) -> ControlApi& = delete;
+  ControlApi(const ControlApi&&) = delete;
+  auto operator=(const ControlApi&&) -> ControlApi& = delete;
+  ~ControlApi();
+
+ private:
+  static constexpr uint max_meter_rate = 100U;  // Hz
+
+  // Written by the realtime thread and read by the timer that sends the signal.
+
+  struct Levels {
+    std::atomic<float> input_left, input_right, output_left, output_right;
+  };
+
+  using SubscriptionKey = std::tuple<std::string, std::string, std::string>;  // sender, chain, effect
+
+  struct Subscription {
+    ControlApi* api = nullptr;
+
+    SubscriptionKey key;
+
+    std::weak_ptr<PluginBase> plugin;
+
+    std::shared_ptr<Levels> levels;
+
+    std::vector<sigc::connection> connections;
+
+    guint source_id = 0U;
+  };
+
+  GDBusConnection* connection = nullptr;
+
+  std::string object_path;
+
+  EffectsBase *sie = nullptr, *soe = nullptr;
+
+  guint registration_id = 0U;
+
+  std::map<std::string, guint> name_watchers;
+
+  std::map<SubscriptionKey, std::unique_ptr<Subscription>> subscriptions;
+
+  static void on_method_call(GDBusConnection* connection,
+                             const gchar* sender,
+                             const gchar* object_path,
+                             const gchar* interface_name,
+                             const gchar* method_name,
+                             GVariant* parameters,
+                             GDBusMethodInvocation* invocation,
+                             gpointer user_data);
+
+  auto get_effects(const std::string& chain) const -> EffectsBase*;
+
+  // Returns a new reference or nullptr with error set.
+
+  auto get_settings(const std::string& chain, const std::string& effect, std::string& error) const -> GSettings*;
+
+  auto list_parameters(const std::string& chain, const std::string& effect, std::string& error) const -> GVariant*;
+
+  auto get_parameters(const std::string& chain,
+                      const std::string& effect,
+                      GVariant* keys,
+                      std::string& error) const -> GVariant*;
+
+  auto set_parameters(GVariant* changes, std::string& error) const -> bool;
+
+  auto subscribe(const std::string& sender, const std::string& chain, const std::string& effect, const uint& rate)
+      -> std::string;
+
+  void unsubscribe(const SubscriptionKey& key);
+
+  void emit_levels(Subscription* subscription);
+};
@@ -19,16 +19,22 @@
 
 #pragma once
 
+#include <glib.h>
+#include <sigc++/connection.h>
+#include <sigc++/signal.h>
 #include <sys/types.h>
 #include <zita-convolver.h>
+#include <atomic>
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <span>
 #include <string>
-#include <thread>
 #include <vector>
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 class Convolver : public PluginBase {
  public:
@@ -52,17 +58,37 @@ class Convolver : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto get_tail_seconds() -> float override;
+
+  [[nodiscard]] auto get_quantum_preference(const uint& graph_rate) const -> QuantumPreference override;
+
   bool do_autogain = false;
 
   const std::string irs_ext = ".irs";
 
   auto search_irs_path(const std::string& name) -> std::string;
 
+  bool bake_linear_section = false;
+
+  /*
+    Bakeable effects placed right before this instance. Their impulse response is measured in a worker thread and
+    merged into the kernel. The section is baked again when their parameters change.
+  */
+
+  void set_linear_section(const std::vector<std::string>& names,
+                          const std::vector<std::shared_ptr<PluginBase>>& section);
+
+  // Effects whose response is currently merged into the kernel.
+  [[nodiscard]] auto get_baked_section() const -> std::vector<std::string>;
+
+  // Emitted when the effects merged into the kernel change and the pipeline has to be relinked.
+  sigc::signal<void()> section_changed;
+
  private:
   std::string local_dir_irs;
   std::vector<std::string> system_data_dir_irs;
 
-  bool kernel_is_initialized = false;
+  std::atomic<bool> kernel_is_initialized = false;
   bool n_samples_is_power_of_2 = true;
   bool zita_ready = false;
   bool ready = false;
@@ -73,6 +99,8 @@ class Convolver : public PluginBase {
   uint latency_n_frames = 0U;
 
   std::vector<float> kernel_L, kernel_R;
+
+  std::atomic<uint> kernel_size = 0U;  // frames, read by the realtime thread for the tail
   std::vector<float> original_kernel_L, original_kernel_R;
   std::vector<float> data_L, data_R;
 
@@ -80,7 +108,25 @@ class Convolver : public PluginBase {
 
   Convproc* conv = nullptr;
 
-  std::vector<std::thread> mythreads;
+  std::vector<std::string> section_names, baked_section_names;
+
+  std::vector<std::weak_ptr<PluginBase>> section_plugins;
+
+  std::vector<sigc::connection> section_connections;
+
+  std::vector<float> section_kernel_L, section_kernel_R;
+
+  uint section_rate = 0U;
+
+  // The kernel is built in the worker pool while the section is changed in the main thread.
+
+  mutable std::mutex section_mutex;
+
+  std::atomic<uint> bake_serial = 0U;
+
+  std::shared_ptr<WorkerPool::Task> bake_task;
+
+  guint bake_source_id = 0U;
 
   void read_kernel_file();
 
@@ -94,6 +140,22 @@ class Convolver : public PluginBase {
 
   void prepare_kernel();
 
+  void build_kernel();
+
+  void rebuild_kernel();
+
+  void do_rebuild_kernel();
+
+  void schedule_bake();
+
+  void bake_section();
+
+  void on_section_baked(const uint& serial,
+                        const std::vector<std::string>& names,
+                        const uint& baked_rate,
+                        const std::vector<float>& left,
+                        const std::vector<float>& right);
+
   template <typename T1>
   void do_convolution(T1& data_left, T1& data_right) {
     std::span conv_left_in(conv->inpdata(0), get_zita_buffer_size());
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -29,4 +30,14 @@ namespace ui::convolver {
 auto read_kernel(std::filesystem::path irs_dir, const std::string& irs_ext, const std::string& file_name)
     -> std::tuple<int, std::vector<float>, std::vector<float>>;
 
+/*
+  Linear convolution of two impulse responses through FFT overlap-add. The longer input is split in blocks that are
+  convolved with the shorter one. The callback receives the fraction of the work already done after each block and
+  returning false from it cancels the operation. An empty vector is returned in this case.
+*/
+
+auto fft_convolve(const std::vector<float>& a,
+                  const std::vector<float>& b,
+                  const std::function<bool(const float&)>& on_progress = nullptr) -> std::vector<float>;
+
 }
\ No newline at end of file
@@ -55,6 +55,8 @@ class Crystalizer : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  [[nodiscard]] auto get_quantum_preference(const uint& graph_rate) const -> QuantumPreference override;
+
  private:
   bool n_samples_is_power_of_2 = true;
   bool filters_are_ready = false;
@@ -1,5 +1,5 @@
 /*
- *  Copyright © 2023 Torge Matthies
+ *  Copyright © 2017-2024 Wellington Wallace
  *
  *  This file is part of Easy Effects.
  *
@@ -19,14 +19,29 @@
 
 #pragma once
 
+#include <sys/types.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <span>
 #include <string>
+#include <thread>
 #include <vector>
 #include "ladspa_wrapper.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "resampler.hpp"
+#include "ring_buffer.hpp"
+
+/*
+  The model runs in a worker thread on frames of its native size. The realtime thread only moves samples in and out
+  of two lock free rings. The output ring starts with enough silence to cover one quantum, one frame and the
+  resampling, so the latency is fixed and known.
+
+  The rings and buffers of a rate are built in the worker pool and swapped in with a short lock. They accept blocks of
+  up to max_quantum, so quantum changes do not go through setup(). The realtime thread never waits for the lock. It
+  outputs silence while the lock is taken, as the undelayed input would not line up with the delayed output.
+*/
 
 class DeepFilterNet : public PluginBase {
  public:
@@ -50,15 +65,53 @@ class DeepFilterNet : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  [[nodiscard]] auto get_quantum_preference(const uint& graph_rate) const -> QuantumPreference override;
+
  private:
+  static constexpr uint model_rate = 48000U;
+  static constexpr uint model_frame_size = 480U;
+
   std::unique_ptr<ladspa::LadspaWrapper> ladspa_wrapper;
 
-  bool resample = false;
-  bool resampler_ready = true;
+  struct Engine {
+    uint rate = 0U;
+
+    uint n_samples = 0U;
+
+    uint latency_n_frames = 0U;
+
+    size_t n_missing = 0U;  // samples the realtime thread had to replace by silence
+
+    bool grow_requested = false;  // a larger quantum arrived and a new engine was asked for
+
+    std::vector<float> interleaved;  // realtime thread scratch
+
+    RingBuffer ring_in, ring_out;  // interleaved at the graph rate
+
+    // Used only by the worker
+
+    std::unique_ptr<Resampler> resampler_in, resampler_out;
+
+    std::vector<float> chunk, pending, frame_in_l, frame_in_r, frame_out_l, frame_out_r, frame_out;
+  };
+
+  bool ready = false;
+  bool notify_latency = false;
+
+  // Replaced only while holding both mutexes. The worker reads it under worker_mutex and process under data_mutex.
+
+  std::unique_ptr<Engine> engine;
+
+  std::mutex worker_mutex;
+
+  std::thread worker;
+
+  std::atomic<bool> quit_worker = false;
+  std::atomic<bool> work_pending = false;
+
+  static auto make_engine(const uint& graph_rate, const uint& quantum) -> std::unique_ptr<Engine>;
 
-  std::unique_ptr<Resampler> resampler_inL, resampler_outL;
-  std::unique_ptr<Resampler> resampler_inR, resampler_outR;
+  void reconfigure(const uint& graph_rate, const uint& quantum);
 
-  std::vector<float> resampled_outL, resampled_outR;
-  std::vector<float> carryover_l, carryover_r;
+  void drain();
 };
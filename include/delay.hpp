@@ -47,6 +47,8 @@ class Delay : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto get_tail_seconds() -> float override;
+
  private:
   uint latency_n_frames = 0U;
 };
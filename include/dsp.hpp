@@ -0,0 +1,69 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <utility>
+
+/*
+  Small kernels used by the effects on every quantum. On x86_64 each one is compiled for SSE2, AVX2 and AVX-512 and
+  the best version for the running CPU is picked when the program is loaded. NEON is used on aarch64.
+*/
+
+namespace dsp {
+
+void scale(std::span<float> data, const float& gain);
+
+// Largest sample of each channel in a single pass over both of them.
+
+auto peak(std::span<const float> left, std::span<const float> right) -> std::pair<float, float>;
+
+// True when no sample of either channel is above threshold in absolute value.
+
+auto is_silent(std::span<const float> left, std::span<const float> right, const float& threshold) -> bool;
+
+void interleave(std::span<const float> left, std::span<const float> right, std::span<float> output);
+
+void deinterleave(std::span<const float> input, std::span<float> left, std::span<float> right);
+
+// Samples outside of [-1, 1) are saturated instead of wrapping around.
+
+void float_to_int16(std::span<const float> input, std::span<int16_t> output);
+
+void int16_to_float(std::span<const int16_t> input, std::span<float> output);
+
+// output = gain_a * a + gain_b * b. The output may be one of the inputs.
+
+void mix(std::span<const float> a,
+         const float& gain_a,
+         std::span<const float> b,
+         const float& gain_b,
+         std::span<float> output);
+
+/*
+  Equal-power crossfade from the processed signal in wet to the signal in dry. The dry level moves from level towards
+  target by step per sample and the final level is returned.
+*/
+
+auto crossfade(std::span<float> wet, std::span<const float> dry, float level, const float& target, const float& step)
+    -> float;
+
+}  // namespace dsp
@@ -19,18 +19,14 @@
 
 #pragma once
 
-#include <speex/speex_echo.h>
-#include <climits>
+#include <sys/types.h>
 #include <span>
 #include <string>
-#include <vector>
+#include "aec_engine.hpp"
+#include "frame_adapter.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
-#include <speex/speex_preprocess.h>
-#include <speex/speexdsp_config_types.h>
-#include <sys/types.h>
-
 class EchoCanceller : public PluginBase {
  public:
   EchoCanceller(const std::string& tag,
@@ -55,30 +51,25 @@ class EchoCanceller : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto get_tail_seconds() -> float override;
+
+  [[nodiscard]] auto get_quantum_preference(const uint& graph_rate) const -> QuantumPreference override;
+
  private:
   bool notify_latency = false;
   bool ready = false;
 
   uint filter_length_ms = 100U;
   uint latency_n_frames = 0U;
+  uint aec_rate = 0U;
 
-  int residual_echo_suppression = -10;
-  int near_end_suppression = -10;
-
-  const float inv_short_max = 1.0F / (SHRT_MAX + 1.0F);
-
-  std::vector<spx_int16_t> data_L;
-  std::vector<spx_int16_t> data_R;
-  std::vector<spx_int16_t> probe_mono;
-  std::vector<spx_int16_t> filtered_L;
-  std::vector<spx_int16_t> filtered_R;
+  static constexpr uint frame_size_ms = 10U;
 
-  SpeexEchoState* echo_state_L = nullptr;
-  SpeexEchoState* echo_state_R = nullptr;
+  AecEngine aec;
 
-  SpeexPreprocessState *state_left = nullptr, *state_right = nullptr;
+  FrameAdapter adapter = FrameAdapter(4U, 2U);  // left, right, probe left and probe right
 
-  void free_speex();
+  void init_aec();
 
-  void init_speex();
+  void cancel_echo(std::span<const std::span<float>> frame_in, std::span<const std::span<float>> frame_out);
 };
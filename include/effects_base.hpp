@@ -24,9 +24,11 @@
 #include <pipewire/proxy.h>
 #include <sigc++/connection.h>
 #include <sigc++/signal.h>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include "autogain.hpp"
 #include "bass_enhancer.hpp"
@@ -108,10 +110,39 @@ class EffectsBase {
 
   void reset_settings();
 
+  // The pipeline stays linked while bypassed. Each effect fades to its dry signal and stops running its DSP.
+  void set_bypass(const bool& state);
+
   sigc::signal<void(const float&)> pipeline_latency;
 
+  /*
+    The level meter and the spectrum are linked only while a window shows them. Otherwise every quantum would still
+    go through two extra nodes.
+  */
+
+  void set_meters_enabled(const bool& state);
+
+  // Emitted when the nodes that have to be linked change. For example when the meters or a baked section change.
+  sigc::signal<void()> relink_required;
+
+  /*
+    Filters of the given names are created, connected to PipeWire and configured for the rate and quantum of the graph
+    ahead of time, so that a preset using them can be linked without instantiating anything. They are never
+    disconnected while pinned. Their parameters are the ones of their instance until the preset is loaded.
+  */
+
+  void set_pinned_filters(const std::vector<std::string>& names);
+
   auto get_plugins_map() -> std::map<std::string, std::shared_ptr<PluginBase>>;
 
+  // Instantiates the effect of the given name. The offline renderer calls it with a null PipeManager.
+
+  static auto make_plugin(const std::string& name,
+                          const std::string& tag,
+                          const std::string& base_path,
+                          PipeManager* pipe_manager,
+                          PipelineType pipe_type) -> std::shared_ptr<PluginBase>;
+
   template <typename T>
   auto get_plugin_instance(const std::string& name) -> std::shared_ptr<T> {
     return std::dynamic_pointer_cast<T>(plugins[name]);
@@ -122,8 +153,16 @@ class EffectsBase {
 
   std::string schema_base_path;
 
+  bool bypass = false;
+
+  bool meters_enabled = false;
+
   std::map<std::string, std::shared_ptr<PluginBase>> plugins;
 
+  std::deque<std::string> standby_plugins;
+
+  std::vector<std::string> pinned_plugins;
+
   std::vector<pw_proxy*> list_proxies, list_proxies_listen_mic;
 
   std::vector<sigc::connection> connections;
@@ -132,6 +171,20 @@ class EffectsBase {
 
   void create_filters_if_necessary();
 
+  auto create_filter(const std::string& name) -> std::shared_ptr<PluginBase>;
+
+  void release_unused_filters(const std::vector<std::string>& selected_plugins);
+
+  // Rate and quantum of the graph, taken from a filter that already runs or from the PipeWire defaults.
+  auto get_graph_clock() -> std::pair<uint, uint>;
+
+  /*
+    Updates the linear sections of the Convolvers in the list and returns the effects already merged into a kernel.
+    They must not be linked.
+  */
+
+  auto bake_linear_sections(const std::vector<std::string>& list) -> std::vector<std::string>;
+
   void remove_unused_filters();
 
   void activate_filters();
@@ -139,4 +192,23 @@ class EffectsBase {
   void deactivate_filters();
 
   void broadcast_pipeline_latency();
+
+  // Asks PipeWire for a quantum that suits the effects of the pipeline. Selected by the quantum-profile key.
+  void update_quantum_request();
+
+  auto get_meter_node_ids() -> std::vector<uint>;
+
+  /*
+    The routing-rules key holds (pattern, target) pairs. The pattern is a glob matched against the application id, the
+    application name, the binary and the node name of a stream. The target is "effects" or "device". The first rule
+    that matches decides where the stream goes. Streams without a matching rule follow the blocklist and the
+    process-all-outputs or process-all-inputs preferences.
+  */
+
+  enum class Route { none, effects, device };
+
+  auto get_route(const NodeInfo& node_info) -> Route;
+
+  // Moves the existing streams to the place their rules ask for.
+  void apply_routing_rules();
 };
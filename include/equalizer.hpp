@@ -23,10 +23,12 @@
 #include <glib.h>
 #include <sys/types.h>
 #include <cstddef>
+#include <memory>
 #include <span>
 #include <string>
 #include <utility>
 #include <vector>
+#include "biquad_equalizer.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_equalizer.hpp"
@@ -56,17 +58,38 @@ class Equalizer : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto prepare_bake() -> Bake override;
+
   void sort_bands();
 
-  static constexpr uint max_bands = 32U;
+  // Magnitude response in dB of the current bands. It is computed by the built-in engine for both engines.
+
+  auto get_frequency_response(const std::vector<double>& frequencies)
+      -> std::pair<std::vector<double>, std::vector<double>>;
+
+  static constexpr uint max_bands = 128U;
+
+  // Bands offered by the LSP plugin. Above this the built-in biquad engine is used.
+
+  static constexpr uint lv2_max_bands = 32U;
 
  private:
   GSettings *settings_left = nullptr, *settings_right = nullptr;
 
   uint latency_n_frames = 0U;
 
+  bool use_biquad = false;
+
+  float balance_left = 1.0F, balance_right = 1.0F;
+
+  std::unique_ptr<BiquadEqualizer> biquad;
+
   std::vector<gulong> gconnections_unified;
 
+  guint biquad_source_id = 0U;
+
+  bool response_pending = false;
+
   template <size_t n>
   constexpr void bind_band() {
     using namespace tags::equalizer;
@@ -108,4 +131,11 @@ class Equalizer : public PluginBase {
   }
 
   void on_split_channels();
+
+  auto read_bands(GSettings* channel_settings, const double& pitch) -> std::vector<BiquadEqualizer::Band>;
+
+  void update_biquad();
+
+  // The bands are read and designed once per burst of changes, like a preset load, in an idle callback.
+  void schedule_biquad_update(const bool& response);
 };
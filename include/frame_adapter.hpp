@@ -0,0 +1,117 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/*
+  Runs a processing callback on frames of fixed size no matter the size of the blocks PipeWire gives us. The input is
+  accumulated until a frame is complete and the processed frames are queued in a ring buffer. The ring buffer starts
+  with one frame of silence, so the latency is always one frame and does not change with the quantum.
+*/
+
+class FrameAdapter {
+ public:
+  FrameAdapter(const uint& n_inputs, const uint& n_outputs);
+  FrameAdapter(const FrameAdapter&) = delete;
+  auto operator=(const FrameAdapter&) -> FrameAdapter& = delete;
+  FrameAdapter(const FrameAdapter&&) = delete;
+  auto operator=(const FrameAdapter&&) -> FrameAdapter& = delete;
+  ~FrameAdapter() = default;
+
+  void set_frame_size(const uint& value);
+
+  // Largest block that will be given to process. The queued samples are kept when it changes.
+
+  void set_max_block_size(const uint& value);
+
+  void reset();
+
+  [[nodiscard]] auto get_frame_size() const -> uint;
+
+  [[nodiscard]] auto get_latency() const -> uint;  // frames
+
+  /*
+    The callback receives one span per input and per output, all of them frame_size long. It is called once for each
+    frame completed by this block.
+  */
+
+  template <typename Callback>
+  void process(std::span<const std::span<float>> inputs,
+               std::span<const std::span<float>> outputs,
+               Callback&& callback) {
+    if (frame_size == 0U || inputs.empty()) {
+      for (const auto& out : outputs) {
+        std::ranges::fill(out, 0.0F);
+      }
+
+      return;
+    }
+
+    const auto size = inputs[0].size();
+
+    size_t offset = 0U;
+
+    while (offset < size) {
+      const auto count = std::min(static_cast<size_t>(frame_size - n_filled), size - offset);
+
+      for (size_t c = 0U; c < inputs.size() && c < in_frames.size(); c++) {
+        std::copy_n(inputs[c].begin() + offset, count, in_frames[c].begin() + n_filled);
+      }
+
+      n_filled += count;
+      offset += count;
+
+      if (n_filled == frame_size) {
+        callback(std::span<const std::span<float>>(in_frames), std::span<const std::span<float>>(out_frames));
+
+        push_frame();
+
+        n_filled = 0U;
+      }
+    }
+
+    pop(outputs, size);
+  }
+
+ private:
+  uint frame_size = 0U;
+  uint max_block_size = 0U;
+  uint n_filled = 0U;  // samples waiting in the input frames
+
+  size_t read_pos = 0U;
+  size_t n_queued = 0U;
+
+  std::vector<std::vector<float>> in_buffers, out_buffers, ring;
+
+  std::vector<std::span<float>> in_frames, out_frames;
+
+  [[nodiscard]] auto capacity() const -> size_t;
+
+  void allocate_ring();
+
+  void push_frame();
+
+  void pop(std::span<const std::span<float>> outputs, const size_t& count);
+};
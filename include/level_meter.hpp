@@ -24,7 +24,6 @@
 #include <sys/types.h>
 #include <span>
 #include <string>
-#include <thread>
 #include <vector>
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
@@ -51,6 +50,8 @@ class LevelMeter : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto get_tail_seconds() -> float override;
+
   void reset_history();
 
   sigc::signal<void(const double,  // momentary
@@ -81,7 +82,5 @@ class LevelMeter : public PluginBase {
 
   ebur128_state* ebur_state = nullptr;
 
-  std::vector<std::thread> mythreads;
-
   auto init_ebur128() -> bool;
 };
@@ -88,6 +88,8 @@ class Lv2Wrapper {
 
   [[nodiscard]] auto get_rate() const -> uint;
 
+  // The next run() processes as many samples as the connected buffers hold. At most the maximum block length.
+
   void connect_data_ports(std::span<float>& left_in,
                           std::span<float>& right_in,
                           std::span<float>& left_out,
@@ -110,6 +112,14 @@ class Lv2Wrapper {
 
   auto get_control_port_value(const std::string& symbol) -> float;
 
+  // Values of the input control ports in port order. Only valid on the thread that sets them.
+  [[nodiscard]] auto get_control_values() const -> std::vector<float>;
+
+  // Restores values taken by get_control_values() from a wrapper hosting the same plugin.
+  void set_control_values(const std::vector<float>& values);
+
+  [[nodiscard]] auto get_plugin_uri() const -> std::string;
+
   auto has_instance() -> bool;
 
   void load_ui();
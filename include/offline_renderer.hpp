@@ -0,0 +1,77 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <sys/types.h>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "pipeline_type.hpp"
+#include "plugin_base.hpp"
+
+/*
+  Applies the effects of the current preset to audio files. The effects are instantiated without PipeWire nodes and
+  run in large blocks. The files of a directory are rendered in parallel.
+*/
+
+class OfflineRenderer {
+ public:
+  explicit OfflineRenderer(PipelineType pipe_type);
+  OfflineRenderer(const OfflineRenderer&) = delete;
+  auto operator=(const OfflineRenderer&) -> OfflineRenderer& = delete;
+  OfflineRenderer(const OfflineRenderer&&) = delete;
+  auto operator=(const OfflineRenderer&&) -> OfflineRenderer& = delete;
+  ~OfflineRenderer() = default;
+
+  /*
+    Input and output are either two files or two directories. The output keeps the format, rate and number of
+    channels of the input. Returns false if any file could not be rendered.
+  */
+
+  auto render(const std::filesystem::path& input, const std::filesystem::path& output) -> bool;
+
+ private:
+  struct Job {
+    std::filesystem::path input_path, output_path;
+
+    std::vector<std::shared_ptr<PluginBase>> chain;
+
+    bool success = false;
+  };
+
+  const std::string log_tag = "offline: ";
+
+  PipelineType pipeline_type;
+
+  std::string schema_base_path;
+
+  std::vector<std::string> plugin_names;
+
+  auto create_chain(const uint& rate) -> std::vector<std::shared_ptr<PluginBase>>;
+
+  void render_jobs(std::span<Job> jobs);
+
+  auto render_file(Job& job) const -> bool;
+
+  static void dispatch_main_context();
+};
@@ -25,7 +25,10 @@
 #include <sigc++/signal.h>
 #include <spa/utils/hook.h>
 #include <sys/types.h>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <span>
@@ -71,6 +74,12 @@ class PluginBase {
     PluginBase* pb = nullptr;
   };
 
+  enum class DspState { idle, processing, configuring };
+
+  // The buffers used by the realtime thread are allocated once for PipeWire's largest quantum.
+
+  static constexpr uint max_quantum = 8192U;
+
   const std::string log_tag;
 
   std::string name, package;
@@ -89,12 +98,32 @@ class PluginBase {
 
   uint rate = 0U;
 
+  /*
+    Rate and quantum changes are applied in two steps. The realtime thread stores the new values and wakes the setup
+    thread, which calls setup() while dsp_state is configuring. The realtime thread never waits for it. It passes the
+    audio through until the effect is configured for the current rate and quantum.
+  */
+
+  std::atomic<uint> requested_rate = 0U, requested_n_samples = 0U;
+
+  std::atomic<bool> setup_requested = false;
+
+  std::atomic<DspState> dsp_state = DspState::idle;
+
+  // process() accepts any quantum up to max_quantum. A quantum change alone does not need a new setup().
+  bool quantum_independent = false;
+
   bool package_installed = true;
 
   bool bypass = false;
 
+  bool global_bypass = false;
+
   bool connected_to_pw = false;
 
+  // Linear time-invariant effects that do not mix the channels can be folded into a Convolver kernel.
+  bool bakeable = false;
+
   bool send_notifications = false;
 
   float delta_t = 0.0F;
@@ -107,12 +136,41 @@ class PluginBase {
 
   std::vector<float> dummy_left, dummy_right;
 
+  // Used only by the realtime thread while crossfading between the processed and the dry signals.
+
+  float dry_level = 0.0F;
+
+  // Input frames of digital silence the realtime thread has seen in a row, counted up to the tail of the effect.
+
+  uint silent_frames = 0U;
+
+  /*
+    Tail plus latency, negative when the effect always runs. The virtual getters may search the LV2 ports, so they are
+    only called by update_tail() and the realtime thread reads this copy.
+  */
+
+  std::atomic<float> idle_after_seconds = -1.0F;
+
+  std::vector<float> dry_left, dry_right;
+
+  // Past input of the realtime thread. The dry signal is read from it delayed by the latency of the effect.
+
+  std::vector<float> dry_history_left, dry_history_right;
+
+  size_t dry_history_pos = 0U;
+
   [[nodiscard]] auto get_node_id() const -> uint;
 
   void set_active(const bool& state) const;
 
   void set_post_messages(const bool& state);
 
+  // Clients of the control interface keep the level signals coming while the window is closed.
+
+  void add_meter_subscriber();
+
+  void remove_meter_subscriber();
+
   auto connect_to_pw() -> bool;
 
   void disconnect_from_pw();
@@ -125,6 +183,12 @@ class PluginBase {
 
   void set_native_ui_update_frequency(const uint& value);
 
+  // Safe to call from the realtime thread.
+  void request_setup(const uint& new_rate, const uint& new_n_samples);
+
+  // Called by the setup thread.
+  void apply_requested_setup();
+
   virtual void setup();
 
   virtual void process(std::span<float>& left_in,
@@ -139,13 +203,65 @@ class PluginBase {
                        std::span<float>& probe_left,
                        std::span<float>& probe_right);
 
+  // Used instead of process() while the input is silent and the tail of the effect is over.
+
+  void process_idle(std::span<float>& left_out, std::span<float>& right_out);
+
   virtual void update_probe_links();
 
   virtual auto get_latency_seconds() -> float;
 
+  /*
+    Time the output takes to fade out once the input is silent, not counting the latency. After that the effect is not
+    run until the input has sound again. A negative value means that it always runs.
+  */
+
+  virtual auto get_tail_seconds() -> float;
+
+  /*
+    Quantum the effect processes without extra buffering. Frame based effects fit any multiple of frames. When
+    power_of_two is set any power of two not smaller than frames fits. frames == 0 means that every quantum fits.
+  */
+
+  struct QuantumPreference {
+    uint frames = 0U;
+
+    bool power_of_two = false;
+  };
+
+  [[nodiscard]] virtual auto get_quantum_preference(const uint& graph_rate) const -> QuantumPreference;
+
+  // Sets the node.latency property of the filter to quantum/graph_rate. A quantum of 0 removes it.
+
+  void set_node_latency(const uint& quantum, const uint& graph_rate);
+
+  using Bake = std::function<bool(const uint& bake_rate, std::vector<float>& left, std::vector<float>& right)>;
+
+  /*
+    Takes a copy of the current parameters on the main thread, where they are changed. The returned function runs the
+    given signals through an offline copy of the effect with them and may be called on any thread. The realtime
+    instance is not touched. It is empty if the effect can not be baked.
+  */
+
+  virtual auto prepare_bake() -> Bake;
+
+  /*
+    Used by the offline renderer on effects created without a PipeManager. prepare_offline() has to be called before
+    the first block and returns once the jobs the setup sent to the worker pool are done. Callbacks the setup added to
+    the default main context still have to be dispatched by the caller. Every block has block_size samples.
+  */
+
+  void prepare_offline(const uint& offline_rate, const uint& block_size);
+
+  void process_offline(std::span<float>& left_in,
+                       std::span<float>& right_in,
+                       std::span<float>& left_out,
+                       std::span<float>& right_out);
+
   sigc::signal<void(const float, const float)> input_level;
   sigc::signal<void(const float, const float)> output_level;
   sigc::signal<void()> latency;
+  sigc::signal<void()> response_changed;
 
  protected:
   std::mutex data_mutex;
@@ -160,6 +276,10 @@ class PluginBase {
 
   bool post_messages = false;
 
+  bool window_messages = false;
+
+  uint meter_subscribers = 0U;
+
   uint n_ports = 4U;
 
   float input_gain = 1.0F;
@@ -169,12 +289,19 @@ class PluginBase {
 
   std::vector<gulong> gconnections;
 
+  uint node_latency_quantum = 0U;
+
   void setup_input_output_gain();
 
   void initialize_listener();
 
   void notify();
 
+  // Refreshes idle_after_seconds. Called when the parameters, the rate or the latency change, never in the realtime
+  // thread.
+
+  void update_tail();
+
   void get_peaks(const std::span<float>& left_in,
                  const std::span<float>& right_in,
                  std::span<float>& left_out,
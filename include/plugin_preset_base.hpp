@@ -25,7 +25,9 @@
 #include <glibconfig.h>
 #include <nlohmann/json.hpp>
 #include <nlohmann/json_fwd.hpp>
+#include <sys/types.h>
 #include <string>
+#include <vector>
 #include "preset_type.hpp"
 #include "util.hpp"
 
@@ -52,6 +54,18 @@ class PluginPresetBase {
   }
 
   void read(const nlohmann::json& json) {
+    stage(json);
+
+    apply();
+  }
+
+  /*
+    The preset values are kept in memory by stage() and only written when apply() is called. This allows the
+    PresetsManager to stage all the plugins of a preset before writing any of them. Dropping the wrapper without
+    calling apply() discards the staged values.
+  */
+
+  void stage(const nlohmann::json& json) {
     /*
       Old presets do not have the filter instance id.
     */
@@ -63,13 +77,15 @@ class PluginPresetBase {
     // For simplicity, exceptions raised while reading presets parameters
     // should be handled outside this method.
 
-    g_settings_delay(settings);
+    revert();
 
     load(json);
-
-    g_settings_apply(settings);
   }
 
+  void apply();
+
+  void revert();
+
  protected:
   int index = 0;
 
@@ -79,6 +95,9 @@ class PluginPresetBase {
 
   PresetType preset_type;
 
+  // Settings objects that are written in delayed mode when the staged values are applied.
+  std::vector<GSettings*> transaction_settings;
+
   virtual void save(nlohmann::json& json) = 0;
 
   virtual void load(const nlohmann::json& json) = 0;
@@ -134,13 +153,13 @@ class PluginPresetBase {
 
     if (is_different(current_value, new_value)) {
       if constexpr (std::is_same_v<T, double>) {
-        g_settings_set_double(settings, key.c_str(), new_value);
+        stage_value(settings, key, g_variant_new_double(new_value));
       } else if constexpr (std::is_same_v<T, int>) {
-        g_settings_set_int(settings, key.c_str(), new_value);
+        stage_value(settings, key, g_variant_new_int32(new_value));
       } else if constexpr (std::is_same_v<T, bool>) {
-        g_settings_set_boolean(settings, key.c_str(), new_value);
+        stage_value(settings, key, g_variant_new_boolean(static_cast<gboolean>(new_value)));
       } else if constexpr (std::is_same_v<T, gchar*>) {
-        g_settings_set_string(settings, key.c_str(), new_value);
+        stage_value(settings, key, g_variant_new_string(new_value));
       }
     }
 
@@ -150,7 +169,24 @@ class PluginPresetBase {
     }
   }
 
+  // Takes the ownership of a floating value.
+  void stage_value(GSettings* settings, const std::string& key, GVariant* value);
+
  private:
+  // Gsettings should have a maximum of 256 delayed changes in delay mode (see issue #2215).
+  // apply() sends the staged values at the half of it like util::reset_all_keys_except does.
+  static constexpr uint max_delayed_changes = 128U;
+
+  struct StagedValue {
+    GSettings* settings = nullptr;
+
+    std::string key;
+
+    GVariant* value = nullptr;
+  };
+
+  std::vector<StagedValue> staged_values;
+
   /*
     Very naive test for equal values...
   */
@@ -0,0 +1,92 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+
+/*
+  Parsed presets and autoload files are kept in memory and compiled to MessagePack files inside the user cache
+  directory. Each compiled file records the size and modification time of the json it was built from, so editing the
+  json (by hand, by an import or by saving a preset) invalidates it. Text parsing only happens once per file version.
+*/
+
+class PresetsCache {
+ public:
+  PresetsCache();
+  PresetsCache(const PresetsCache&) = delete;
+  auto operator=(const PresetsCache&) -> PresetsCache& = delete;
+  PresetsCache(const PresetsCache&&) = delete;
+  auto operator=(const PresetsCache&&) -> PresetsCache& = delete;
+  ~PresetsCache() = default;
+
+  // Throws nlohmann::json exceptions when the json file can not be parsed, the same way `is >> json` does.
+  void read(const std::filesystem::path& input_file, nlohmann::json& json);
+
+  // Drops the entry and its compiled file. Called when the json is written or removed, so that compiled files of
+  // deleted presets do not stay in the cache directory.
+
+  void invalidate(const std::filesystem::path& input_file);
+
+ private:
+  static constexpr uint32_t format_version = 1U;
+
+  static constexpr std::array<char, 4U> magic = {'E', 'E', 'P', 'C'};
+
+  struct Header {
+    std::array<char, 4U> magic{};
+
+    uint32_t version = 0U;
+
+    int64_t source_mtime = 0;
+
+    uint64_t source_size = 0U;
+
+    uint64_t payload_size = 0U;
+  };
+
+  struct Entry {
+    int64_t source_mtime = 0;
+
+    uint64_t source_size = 0U;
+
+    nlohmann::json json;
+  };
+
+  std::filesystem::path cache_dir;
+
+  std::map<std::string, Entry> entries;
+
+  auto get_compiled_path(const std::filesystem::path& input_file) const -> std::filesystem::path;
+
+  auto read_compiled(const std::filesystem::path& compiled_file,
+                     const int64_t& source_mtime,
+                     const uint64_t& source_size,
+                     nlohmann::json& json) const -> bool;
+
+  void write_compiled(const std::filesystem::path& compiled_file,
+                      const int64_t& source_mtime,
+                      const uint64_t& source_size,
+                      const nlohmann::json& json) const;
+};
@@ -30,6 +30,8 @@
 #include <vector>
 #include "plugin_preset_base.hpp"
 #include "preset_type.hpp"
+#include "presets_cache.hpp"
+#include "resource_catalog.hpp"
 
 class PresetsManager {
  public:
@@ -90,7 +92,12 @@ class PresetsManager {
 
   auto read_plugins_preset(const PresetType& preset_type,
                            const std::vector<std::string>& plugins,
-                           const nlohmann::json& json) -> bool;
+                           const nlohmann::json& json,
+                           std::vector<std::unique_ptr<PluginPresetBase>>& staged_wrappers) -> bool;
+
+  // Parses and checks a preset and returns its effects list so that its filters can be kept in standby. The
+  // parameters stay in the presets cache until the preset is loaded. No plugin settings are written.
+  auto prepare_standby_preset(const PresetType& preset_type, const std::string& name) -> std::vector<std::string>;
 
   void import_from_filesystem(const PresetType& preset_type, const std::string& file_path);
 
@@ -116,6 +123,8 @@ class PresetsManager {
 
   auto get_autoload_profiles(const PresetType& preset_type) -> std::vector<nlohmann::json>;
 
+  void prepare_autoload_cache();
+
   auto preset_file_exists(const PresetType& preset_type, const std::string& name) -> bool;
 
   sigc::signal<void(const std::string& preset_name)> user_output_preset_created;
@@ -140,8 +149,16 @@ class PresetsManager {
 
   GFileMonitor *autoload_output_monitor = nullptr, *autoload_input_monitor = nullptr;
 
+  PresetsCache presets_cache;
+
   static void create_user_directory(const std::filesystem::path& path);
 
+  // Full path of an impulse response or RNNoise model shipped by a community package. Empty when it is not found.
+
+  auto search_community_addon(const ResourceCatalog::Type& type,
+                              const std::string& package,
+                              const std::string& filename) -> std::string;
+
   auto import_addons_from_community_package(const PresetType& preset_type,
                                             const std::filesystem::path& path,
                                             const std::string& package) -> bool;
@@ -154,7 +171,7 @@ class PresetsManager {
 
   void save_blocklist(const PresetType& preset_type, nlohmann::json& json);
 
-  auto load_blocklist(const PresetType& preset_type, const nlohmann::json& json) -> bool;
+  auto load_blocklist(const PresetType& preset_type, const nlohmann::json& json, GSettings* settings) -> bool;
 
   void notify_error(const PresetError& preset_error, const std::string& plugin_name = "");
 
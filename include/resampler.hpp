@@ -21,11 +21,14 @@
 
 #include <samplerate.h>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
 class Resampler {
  public:
-  Resampler(const int& input_rate, const int& output_rate);
+  // Multichannel data is interleaved.
+
+  Resampler(const int& input_rate, const int& output_rate, const int& channels = 1);
   Resampler(const Resampler&) = delete;
   auto operator=(const Resampler&) -> Resampler& = delete;
   Resampler(const Resampler&&) = delete;
@@ -37,13 +40,13 @@ class Resampler {
     output.resize(std::ceil(1.5 * resample_ratio * input.size()));
 
     // The number of frames of data pointed to by data_in
-    src_data.input_frames = input.size();
+    src_data.input_frames = static_cast<long>(input.size() / channels);
 
     // A pointer to the input data samples
     src_data.data_in = input.data();
 
     // Maximum number of frames pointed to by data_out
-    src_data.output_frames = static_cast<long>(output.size());
+    src_data.output_frames = static_cast<long>(output.size() / channels);
 
     // A pointer to the output data samples
     src_data.data_out = output.data();
@@ -56,14 +59,22 @@ class Resampler {
 
     src_process(src_state, &src_data);
 
-    output.resize(src_data.output_frames_gen);
+    output.resize(src_data.output_frames_gen * channels);
 
     return output;
   }
 
+  // Grows the output buffer for inputs of up to n_frames so that process() does not allocate.
+
+  void reserve(const size_t& n_frames) {
+    output.reserve(static_cast<size_t>(std::ceil(1.5 * resample_ratio * static_cast<double>(n_frames * channels))));
+  }
+
  private:
   double resample_ratio = 1.0;
 
+  size_t channels = 1U;
+
   SRC_STATE* src_state = nullptr;
 
   SRC_DATA src_data{};
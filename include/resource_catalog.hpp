@@ -0,0 +1,130 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+#include <sigc++/signal.h>
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "worker_pool.hpp"
+
+/*
+  Index of the presets, impulse responses and RNNoise models installed by community packages in the system data
+  directories. It is built by the worker pool and rebuilt when the monitors of the scanned directories report a change,
+  so finding a file does not walk the filesystem. Until the first build is done ready() returns false and the callers
+  search the directories themselves.
+*/
+
+class ResourceCatalog {
+ public:
+  enum class Type { input_preset, output_preset, irs, rnnoise };
+
+  struct Entry {
+    std::string package;
+
+    std::filesystem::path path;
+
+    uint64_t size = 0U;
+
+    int64_t mtime = 0;
+
+    uint rate = 0U;  // impulse responses only
+
+    uint channels = 0U;  // impulse responses only
+  };
+
+  ResourceCatalog(const ResourceCatalog&) = delete;
+  auto operator=(const ResourceCatalog&) -> ResourceCatalog& = delete;
+  ResourceCatalog(const ResourceCatalog&&) = delete;
+  auto operator=(const ResourceCatalog&&) -> ResourceCatalog& = delete;
+  ~ResourceCatalog();
+
+  static auto get() -> ResourceCatalog&;
+
+  // Starts a new build. It has to be called from the main thread, which also receives the monitor events.
+
+  void refresh();
+
+  [[nodiscard]] auto ready() const -> bool;
+
+  // filename includes the extension. Like before, only the package folder and two levels below it are searched.
+
+  auto find(const Type& type, const std::string& package, const std::string& filename) const -> std::optional<Entry>;
+
+  auto list(const Type& type) const -> std::vector<Entry>;
+
+  // Emitted in the main thread after each build.
+
+  sigc::signal<void()> changed;
+
+ private:
+  ResourceCatalog();
+
+  // Presets are listed instead of searched by name, so their key is the full path. Packages may ship presets with the
+  // same name in different folders.
+
+  using Key = std::tuple<Type, std::string, std::string>;
+
+  struct Index {
+    std::map<Key, Entry> entries;
+
+    std::vector<std::filesystem::path> directories;
+  };
+
+  std::atomic<bool> is_ready = false;
+
+  uint generation = 0U;
+
+  guint refresh_source_id = 0U;
+
+  mutable std::mutex mutex;
+
+  std::map<Key, Entry> entries;
+
+  std::vector<std::pair<Type, std::filesystem::path>> roots;
+
+  // The easyeffects folder of each data directory. It is monitored so that roots created later are scanned.
+
+  std::vector<std::filesystem::path> parents;
+
+  std::vector<GFileMonitor*> monitors;
+
+  static void scan_directory(Index& index,
+                             const WorkerPool::Task& task,
+                             const Type& type,
+                             const std::string& package,
+                             const std::filesystem::path& dir,
+                             const uint& scan_level);
+
+  void set_monitors(const std::vector<std::filesystem::path>& directories);
+
+  void schedule_refresh();
+};
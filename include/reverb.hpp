@@ -46,5 +46,7 @@ class Reverb : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  auto get_tail_seconds() -> float override;
+
  private:
 };
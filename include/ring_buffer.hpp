@@ -0,0 +1,64 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/*
+  Lock free ring of samples for one producer and one consumer running in different threads. The producer only calls
+  write and write_available and the consumer only calls read, skip and read_available.
+*/
+
+class RingBuffer {
+ public:
+  RingBuffer() = default;
+  RingBuffer(const RingBuffer&) = delete;
+  auto operator=(const RingBuffer&) -> RingBuffer& = delete;
+  RingBuffer(const RingBuffer&&) = delete;
+  auto operator=(const RingBuffer&&) -> RingBuffer& = delete;
+  ~RingBuffer() = default;
+
+  // resize and reset may only be called while neither side is using the ring
+
+  void resize(const size_t& capacity);
+
+  void reset();
+
+  auto write(std::span<const float> data) -> size_t;
+
+  auto read(std::span<float> data) -> size_t;
+
+  auto skip(const size_t& count) -> size_t;
+
+  [[nodiscard]] auto read_available() const -> size_t;
+
+  [[nodiscard]] auto write_available() const -> size_t;
+
+ private:
+  std::vector<float> buffer;
+
+  // total number of samples written and read since the last reset
+
+  std::atomic<size_t> write_count = 0U;
+  std::atomic<size_t> read_count = 0U;
+};
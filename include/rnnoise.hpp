@@ -28,6 +28,7 @@
 #include <span>
 #include <string>
 #include <vector>
+#include "dsp.hpp"
 #include "pipe_manager.hpp"
 #ifdef ENABLE_RNNOISE
 #include <rnnoise.h>
@@ -59,6 +60,8 @@ class RNNoise : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  [[nodiscard]] auto get_quantum_preference(const uint& graph_rate) const -> QuantumPreference override;
+
   void init_release();
 
   auto search_model_path(const std::string& name) -> std::string;
@@ -121,7 +124,7 @@ class RNNoise : public PluginBase {
 
       if (data_L.size() == blocksize) {
         if (state_left != nullptr) {
-          std::ranges::for_each(data_L, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
+          dsp::scale(data_L, static_cast<float>(SHRT_MAX + 1));
 
           data_tmp = data_L;
 
@@ -135,20 +138,12 @@ class RNNoise : public PluginBase {
             if (vad_grace_left >= 0) {
               --vad_grace_left;
 
-              for (size_t i = 0U; i < data_L.size(); i++) {
-                data_L[i] = data_L[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
-
-                data_L[i] *= inv_short_max;
-              }
+              dsp::mix(data_L, wet_ratio * inv_short_max, data_tmp, (1.0F - wet_ratio) * inv_short_max, data_L);
             } else {
               std::ranges::for_each(data_L, [&](auto& v) { v = 0.0F; });
             }
           } else {
-            for (size_t i = 0U; i < data_L.size(); i++) {
-              data_L[i] = data_L[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
-
-              data_L[i] *= inv_short_max;
-            }
+            dsp::mix(data_L, wet_ratio * inv_short_max, data_tmp, (1.0F - wet_ratio) * inv_short_max, data_L);
           }
         }
 
@@ -165,7 +160,7 @@ class RNNoise : public PluginBase {
 
       if (data_R.size() == blocksize) {
         if (state_right != nullptr) {
-          std::ranges::for_each(data_R, [](auto& v) { v *= static_cast<float>(SHRT_MAX + 1); });
+          dsp::scale(data_R, static_cast<float>(SHRT_MAX + 1));
 
           data_tmp = data_R;
 
@@ -179,20 +174,12 @@ class RNNoise : public PluginBase {
             if (vad_grace_right >= 0) {
               --vad_grace_right;
 
-              for (size_t i = 0U; i < data_R.size(); i++) {
-                data_R[i] = data_R[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
-
-                data_R[i] *= inv_short_max;
-              }
+              dsp::mix(data_R, wet_ratio * inv_short_max, data_tmp, (1.0F - wet_ratio) * inv_short_max, data_R);
             } else {
               std::ranges::for_each(data_R, [&](auto& v) { v = 0.0F; });
             }
           } else {
-            for (size_t i = 0U; i < data_R.size(); i++) {
-              data_R[i] = data_R[i] * wet_ratio + data_tmp[i] * (1.0F - wet_ratio);
-
-              data_R[i] *= inv_short_max;
-            }
+            dsp::mix(data_R, wet_ratio * inv_short_max, data_tmp, (1.0F - wet_ratio) * inv_short_max, data_R);
           }
         }
 
@@ -0,0 +1,70 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+/*
+  Checks that the realtime code does not allocate memory, lock mutexes or sleep. When the program is built with the
+  enable-rt-sanitizer option these calls are recorded with their backtrace while the calling thread is inside a
+  ScopedRealtime block. A report of the call sites is written when the program exits, to the file given in the
+  EE_RT_SANITIZER_REPORT environment variable or to the standard error. In the normal build the guards do nothing.
+*/
+
+namespace rt_sanitizer {
+
+#ifdef ENABLE_RT_SANITIZER
+
+class ScopedRealtime {
+ public:
+  ScopedRealtime();
+  ScopedRealtime(const ScopedRealtime&) = delete;
+  auto operator=(const ScopedRealtime&) -> ScopedRealtime& = delete;
+  ScopedRealtime(const ScopedRealtime&&) = delete;
+  auto operator=(const ScopedRealtime&&) -> ScopedRealtime& = delete;
+  ~ScopedRealtime();
+
+ private:
+  bool previous = false;
+};
+
+// Code that runs inside a realtime block but is allowed to block. For example the offline renderer.
+
+class ScopedAllowed {
+ public:
+  ScopedAllowed();
+  ScopedAllowed(const ScopedAllowed&) = delete;
+  auto operator=(const ScopedAllowed&) -> ScopedAllowed& = delete;
+  ScopedAllowed(const ScopedAllowed&&) = delete;
+  auto operator=(const ScopedAllowed&&) -> ScopedAllowed& = delete;
+  ~ScopedAllowed();
+
+ private:
+  bool previous = false;
+};
+
+#else
+
+class ScopedRealtime {};
+
+class ScopedAllowed {};
+
+#endif
+
+}  // namespace rt_sanitizer
@@ -0,0 +1,42 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <gio/gio.h>
+
+/*
+  The effects and their windows share one GSettings object per schema path. The shared objects are in delayed mode:
+  every reader in the process sees a new value as soon as it is written, and the pending values are sent to dconf at
+  most every flush_interval milliseconds instead of on each slider movement. Objects are not kept alive by the store.
+  Their pending values are written when the last reference is dropped.
+*/
+
+namespace settings_store {
+
+// Returns a new reference. Callers release it with g_object_unref like any other GSettings.
+
+auto get(const char* schema_id, const char* path) -> GSettings*;
+
+// Writes all pending values to dconf now. Needed before other GSettings objects read or write the same paths.
+
+void flush();
+
+}  // namespace settings_store
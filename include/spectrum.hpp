@@ -51,7 +51,16 @@ class Spectrum : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
-  sigc::signal<void(uint, uint, std::vector<double>)> power;  // rate, nbands, magnitudes
+  auto get_tail_seconds() -> float override;
+
+  /*
+    Magnitudes in dB at the display frequencies. The fft bins are reduced to the display points here so that the window
+    only receives what it draws. The serial changes whenever the frequencies returned by get_frequencies() change.
+  */
+
+  sigc::signal<void(uint, std::vector<float>)> power;  // serial, magnitudes
+
+  [[nodiscard]] auto get_frequencies() -> std::vector<double>;
 
  private:
   bool fftw_ready = false;
@@ -61,9 +70,28 @@ class Spectrum : public PluginBase {
   fftwf_complex* complex_output = nullptr;
 
   std::vector<float> real_input;
-  std::vector<double> output;
+  std::vector<float> output;
 
   uint n_bands = 8192U;
 
+  uint n_points = 100U;
+
+  double min_frequency = 20.0;
+  double max_frequency = 20000.0;
+
+  uint axis_serial = 0U;
+
+  std::vector<double> frequencies;
+
+  std::vector<float> points;
+
+  // Sparse matrix from the fft bins to the display points. The weights of point k are in [offsets[k], offsets[k + 1]).
+
+  std::vector<uint> weight_offsets, weight_bins;
+
+  std::vector<float> weight_values;
+
   std::deque<float> deque_in_mono;
+
+  void init_display_points();
 };
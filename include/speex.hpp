@@ -22,10 +22,10 @@
 #include <speex/speex_preprocess.h>
 #include <speex/speexdsp_config_types.h>
 #include <sys/types.h>
-#include <climits>
 #include <span>
 #include <string>
 #include <vector>
+#include "frame_adapter.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 
@@ -51,19 +51,27 @@ class Speex : public PluginBase {
 
   auto get_latency_seconds() -> float override;
 
+  [[nodiscard]] auto get_quantum_preference(const uint& graph_rate) const -> QuantumPreference override;
+
  private:
   bool speex_ready = false;
+  bool notify_latency = false;
 
   int enable_denoise = 0, noise_suppression = -15, enable_agc = 0, enable_vad = 0, vad_probability_start = 95,
       vad_probability_continue = 90, enable_dereverb = 0;
 
   uint latency_n_frames = 0U;
+  uint speex_rate = 0U;
 
-  const float inv_short_max = 1.0F / (SHRT_MAX + 1);
+  static constexpr uint frame_size_ms = 10U;
 
   std::vector<spx_int16_t> data_L, data_R;
 
   SpeexPreprocessState *state_left = nullptr, *state_right = nullptr;
 
+  FrameAdapter adapter = FrameAdapter(2U, 2U);
+
   void free_speex();
+
+  void remove_noise(std::span<const std::span<float>> frame_in, std::span<const std::span<float>> frame_out);
 };
@@ -32,17 +32,15 @@ class StreamInputEffects : public EffectsBase {
   auto operator=(const StreamInputEffects&&) -> StreamInputEffects& = delete;
   ~StreamInputEffects() override;
 
-  void set_bypass(const bool& state);
-
   void set_listen_to_mic(const bool& state);
 
  private:
-  bool bypass = false;
-
-  void connect_filters(const bool& bypass = false);
+  void connect_filters();
 
   void disconnect_filters();
 
+  void relink();
+
   auto apps_want_to_play() -> bool;
 
   void on_app_added(NodeInfo node_info);
@@ -32,15 +32,13 @@ class StreamOutputEffects : public EffectsBase {
   auto operator=(const StreamOutputEffects&&) -> StreamOutputEffects& = delete;
   ~StreamOutputEffects() override;
 
-  void set_bypass(const bool& state);
-
  private:
-  bool bypass = false;
-
-  void connect_filters(const bool& bypass = false);
+  void connect_filters();
 
   void disconnect_filters();
 
+  void relink();
+
   auto apps_want_to_play() -> bool;
 
   void on_app_added(NodeInfo node_info);
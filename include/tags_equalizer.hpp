@@ -26,98 +26,236 @@ namespace tags::equalizer {
 // bands
 
 constexpr auto band_id = std::to_array(
-    {"band0",  "band1",  "band2",  "band3",  "band4",  "band5",  "band6",  "band7",  "band8",  "band9",  "band10",
-     "band11", "band12", "band13", "band14", "band15", "band16", "band17", "band18", "band19", "band20", "band21",
-     "band22", "band23", "band24", "band25", "band26", "band27", "band28", "band29", "band30", "band31"});
-
-constexpr auto band_type =
-    std::to_array({{"band0-type"},  {"band1-type"},  {"band2-type"},  {"band3-type"},
-                   {"band4-type"},  {"band5-type"},  {"band6-type"},  {"band7-type"},
-                   {"band8-type"},  {"band9-type"},  {"band10-type"}, {"band11-type"},
-                   {"band12-type"}, {"band13-type"}, {"band14-type"}, {"band15-type"},
-                   {"band16-type"}, {"band17-type"}, {"band18-type"}, {"band19-type"},
-                   {"band20-type"}, {"band21-type"}, {"band22-type"}, {"band23-type"},
-                   {"band24-type"}, {"band25-type"}, {"band26-type"}, {"band27-type"},
-                   {"band28-type"}, {"band29-type"}, {"band30-type"}, std::to_array("band31-type")});
-
-constexpr auto band_mode =
-    std::to_array({{"band0-mode"},  {"band1-mode"},  {"band2-mode"},  {"band3-mode"},
-                   {"band4-mode"},  {"band5-mode"},  {"band6-mode"},  {"band7-mode"},
-                   {"band8-mode"},  {"band9-mode"},  {"band10-mode"}, {"band11-mode"},
-                   {"band12-mode"}, {"band13-mode"}, {"band14-mode"}, {"band15-mode"},
-                   {"band16-mode"}, {"band17-mode"}, {"band18-mode"}, {"band19-mode"},
-                   {"band20-mode"}, {"band21-mode"}, {"band22-mode"}, {"band23-mode"},
-                   {"band24-mode"}, {"band25-mode"}, {"band26-mode"}, {"band27-mode"},
-                   {"band28-mode"}, {"band29-mode"}, {"band30-mode"}, std::to_array("band31-mode")});
-
-constexpr auto band_slope =
-    std::to_array({{"band0-slope"},  {"band1-slope"},  {"band2-slope"},  {"band3-slope"},
-                   {"band4-slope"},  {"band5-slope"},  {"band6-slope"},  {"band7-slope"},
-                   {"band8-slope"},  {"band9-slope"},  {"band10-slope"}, {"band11-slope"},
-                   {"band12-slope"}, {"band13-slope"}, {"band14-slope"}, {"band15-slope"},
-                   {"band16-slope"}, {"band17-slope"}, {"band18-slope"}, {"band19-slope"},
-                   {"band20-slope"}, {"band21-slope"}, {"band22-slope"}, {"band23-slope"},
-                   {"band24-slope"}, {"band25-slope"}, {"band26-slope"}, {"band27-slope"},
-                   {"band28-slope"}, {"band29-slope"}, {"band30-slope"}, std::to_array("band31-slope")});
-
-constexpr auto band_solo =
-    std::to_array({{"band0-solo"},  {"band1-solo"},  {"band2-solo"},  {"band3-solo"},
-                   {"band4-solo"},  {"band5-solo"},  {"band6-solo"},  {"band7-solo"},
-                   {"band8-solo"},  {"band9-solo"},  {"band10-solo"}, {"band11-solo"},
-                   {"band12-solo"}, {"band13-solo"}, {"band14-solo"}, {"band15-solo"},
-                   {"band16-solo"}, {"band17-solo"}, {"band18-solo"}, {"band19-solo"},
-                   {"band20-solo"}, {"band21-solo"}, {"band22-solo"}, {"band23-solo"},
-                   {"band24-solo"}, {"band25-solo"}, {"band26-solo"}, {"band27-solo"},
-                   {"band28-solo"}, {"band29-solo"}, {"band30-solo"}, std::to_array("band31-solo")});
-
-constexpr auto band_mute =
-    std::to_array({{"band0-mute"},  {"band1-mute"},  {"band2-mute"},  {"band3-mute"},
-                   {"band4-mute"},  {"band5-mute"},  {"band6-mute"},  {"band7-mute"},
-                   {"band8-mute"},  {"band9-mute"},  {"band10-mute"}, {"band11-mute"},
-                   {"band12-mute"}, {"band13-mute"}, {"band14-mute"}, {"band15-mute"},
-                   {"band16-mute"}, {"band17-mute"}, {"band18-mute"}, {"band19-mute"},
-                   {"band20-mute"}, {"band21-mute"}, {"band22-mute"}, {"band23-mute"},
-                   {"band24-mute"}, {"band25-mute"}, {"band26-mute"}, {"band27-mute"},
-                   {"band28-mute"}, {"band29-mute"}, {"band30-mute"}, std::to_array("band31-mute")});
+    {"band0",   "band1",   "band2",   "band3",   "band4",   "band5",   "band6",   "band7",   "band8",   "band9",
+     "band10",  "band11",  "band12",  "band13",  "band14",  "band15",  "band16",  "band17",  "band18",  "band19",
+     "band20",  "band21",  "band22",  "band23",  "band24",  "band25",  "band26",  "band27",  "band28",  "band29",
+     "band30",  "band31",  "band32",  "band33",  "band34",  "band35",  "band36",  "band37",  "band38",  "band39",
+     "band40",  "band41",  "band42",  "band43",  "band44",  "band45",  "band46",  "band47",  "band48",  "band49",
+     "band50",  "band51",  "band52",  "band53",  "band54",  "band55",  "band56",  "band57",  "band58",  "band59",
+     "band60",  "band61",  "band62",  "band63",  "band64",  "band65",  "band66",  "band67",  "band68",  "band69",
+     "band70",  "band71",  "band72",  "band73",  "band74",  "band75",  "band76",  "band77",  "band78",  "band79",
+     "band80",  "band81",  "band82",  "band83",  "band84",  "band85",  "band86",  "band87",  "band88",  "band89",
+     "band90",  "band91",  "band92",  "band93",  "band94",  "band95",  "band96",  "band97",  "band98",  "band99",
+     "band100", "band101", "band102", "band103", "band104", "band105", "band106", "band107", "band108", "band109",
+     "band110", "band111", "band112", "band113", "band114", "band115", "band116", "band117", "band118", "band119",
+     "band120", "band121", "band122", "band123", "band124", "band125", "band126", "band127"});
+
+constexpr auto band_type = std::to_array(
+    {{"band0-type"},   {"band1-type"},   {"band2-type"},   {"band3-type"},   {"band4-type"},   {"band5-type"},
+     {"band6-type"},   {"band7-type"},   {"band8-type"},   {"band9-type"},   {"band10-type"},  {"band11-type"},
+     {"band12-type"},  {"band13-type"},  {"band14-type"},  {"band15-type"},  {"band16-type"},  {"band17-type"},
+     {"band18-type"},  {"band19-type"},  {"band20-type"},  {"band21-type"},  {"band22-type"},  {"band23-type"},
+     {"band24-type"},  {"band25-type"},  {"band26-type"},  {"band27-type"},  {"band28-type"},  {"band29-type"},
+     {"band30-type"},  {"band31-type"},  {"band32-type"},  {"band33-type"},  {"band34-type"},  {"band35-type"},
+     {"band36-type"},  {"band37-type"},  {"band38-type"},  {"band39-type"},  {"band40-type"},  {"band41-type"},
+     {"band42-type"},  {"band43-type"},  {"band44-type"},  {"band45-type"},  {"band46-type"},  {"band47-type"},
+     {"band48-type"},  {"band49-type"},  {"band50-type"},  {"band51-type"},  {"band52-type"},  {"band53-type"},
+     {"band54-type"},  {"band55-type"},  {"band56-type"},  {"band57-type"},  {"band58-type"},  {"band59-type"},
+     {"band60-type"},  {"band61-type"},  {"band62-type"},  {"band63-type"},  {"band64-type"},  {"band65-type"},
+     {"band66-type"},  {"band67-type"},  {"band68-type"},  {"band69-type"},  {"band70-type"},  {"band71-type"},
+     {"band72-type"},  {"band73-type"},  {"band74-type"},  {"band75-type"},  {"band76-type"},  {"band77-type"},
+     {"band78-type"},  {"band79-type"},  {"band80-type"},  {"band81-type"},  {"band82-type"},  {"band83-type"},
+     {"band84-type"},  {"band85-type"},  {"band86-type"},  {"band87-type"},  {"band88-type"},  {"band89-type"},
+     {"band90-type"},  {"band91-type"},  {"band92-type"},  {"band93-type"},  {"band94-type"},  {"band95-type"},
+     {"band96-type"},  {"band97-type"},  {"band98-type"},  {"band99-type"},  {"band100-type"}, {"band101-type"},
+     {"band102-type"}, {"band103-type"}, {"band104-type"}, {"band105-type"}, {"band106-type"}, {"band107-type"},
+     {"band108-type"}, {"band109-type"}, {"band110-type"}, {"band111-type"}, {"band112-type"}, {"band113-type"},
+     {"band114-type"}, {"band115-type"}, {"band116-type"}, {"band117-type"}, {"band118-type"}, {"band119-type"},
+     {"band120-type"}, {"band121-type"}, {"band122-type"}, {"band123-type"}, {"band124-type"}, {"band125-type"},
+     {"band126-type"}, std::to_array("band127-type")});
+
+constexpr auto band_mode = std::to_array(
+    {{"band0-mode"},   {"band1-mode"},   {"band2-mode"},   {"band3-mode"},   {"band4-mode"},   {"band5-mode"},
+     {"band6-mode"},   {"band7-mode"},   {"band8-mode"},   {"band9-mode"},   {"band10-mode"},  {"band11-mode"},
+     {"band12-mode"},  {"band13-mode"},  {"band14-mode"},  {"band15-mode"},  {"band16-mode"},  {"band17-mode"},
+     {"band18-mode"},  {"band19-mode"},  {"band20-mode"},  {"band21-mode"},  {"band22-mode"},  {"band23-mode"},
+     {"band24-mode"},  {"band25-mode"},  {"band26-mode"},  {"band27-mode"},  {"band28-mode"},  {"band29-mode"},
+     {"band30-mode"},  {"band31-mode"},  {"band32-mode"},  {"band33-mode"},  {"band34-mode"},  {"band35-mode"},
+     {"band36-mode"},  {"band37-mode"},  {"band38-mode"},  {"band39-mode"},  {"band40-mode"},  {"band41-mode"},
+     {"band42-mode"},  {"band43-mode"},  {"band44-mode"},  {"band45-mode"},  {"band46-mode"},  {"band47-mode"},
+     {"band48-mode"},  {"band49-mode"},  {"band50-mode"},  {"band51-mode"},  {"band52-mode"},  {"band53-mode"},
+     {"band54-mode"},  {"band55-mode"},  {"band56-mode"},  {"band57-mode"},  {"band58-mode"},  {"band59-mode"},
+     {"band60-mode"},  {"band61-mode"},  {"band62-mode"},  {"band63-mode"},  {"band64-mode"},  {"band65-mode"},
+     {"band66-mode"},  {"band67-mode"},  {"band68-mode"},  {"band69-mode"},  {"band70-mode"},  {"band71-mode"},
+     {"band72-mode"},  {"band73-mode"},  {"band74-mode"},  {"band75-mode"},  {"band76-mode"},  {"band77-mode"},
+     {"band78-mode"},  {"band79-mode"},  {"band80-mode"},  {"band81-mode"},  {"band82-mode"},  {"band83-mode"},
+     {"band84-mode"},  {"band85-mode"},  {"band86-mode"},  {"band87-mode"},  {"band88-mode"},  {"band89-mode"},
+     {"band90-mode"},  {"band91-mode"},  {"band92-mode"},  {"band93-mode"},  {"band94-mode"},  {"band95-mode"},
+     {"band96-mode"},  {"band97-mode"},  {"band98-mode"},  {"band99-mode"},  {"band100-mode"}, {"band101-mode"},
+     {"band102-mode"}, {"band103-mode"}, {"band104-mode"}, {"band105-mode"}, {"band106-mode"}, {"band107-mode"},
+     {"band108-mode"}, {"band109-mode"}, {"band110-mode"}, {"band111-mode"}, {"band112-mode"}, {"band113-mode"},
+     {"band114-mode"}, {"band115-mode"}, {"band116-mode"}, {"band117-mode"}, {"band118-mode"}, {"band119-mode"},
+     {"band120-mode"}, {"band121-mode"}, {"band122-mode"}, {"band123-mode"}, {"band124-mode"}, {"band125-mode"},
+     {"band126-mode"}, std::to_array("band127-mode")});
+
+constexpr auto band_slope = std::to_array(
+    {{"band0-slope"},   {"band1-slope"},   {"band2-slope"},   {"band3-slope"},   {"band4-slope"},   {"band5-slope"},
+     {"band6-slope"},   {"band7-slope"},   {"band8-slope"},   {"band9-slope"},   {"band10-slope"},  {"band11-slope"},
+     {"band12-slope"},  {"band13-slope"},  {"band14-slope"},  {"band15-slope"},  {"band16-slope"},  {"band17-slope"},
+     {"band18-slope"},  {"band19-slope"},  {"band20-slope"},  {"band21-slope"},  {"band22-slope"},  {"band23-slope"},
+     {"band24-slope"},  {"band25-slope"},  {"band26-slope"},  {"band27-slope"},  {"band28-slope"},  {"band29-slope"},
+     {"band30-slope"},  {"band31-slope"},  {"band32-slope"},  {"band33-slope"},  {"band34-slope"},  {"band35-slope"},
+     {"band36-slope"},  {"band37-slope"},  {"band38-slope"},  {"band39-slope"},  {"band40-slope"},  {"band41-slope"},
+     {"band42-slope"},  {"band43-slope"},  {"band44-slope"},  {"band45-slope"},  {"band46-slope"},  {"band47-slope"},
+     {"band48-slope"},  {"band49-slope"},  {"band50-slope"},  {"band51-slope"},  {"band52-slope"},  {"band53-slope"},
+     {"band54-slope"},  {"band55-slope"},  {"band56-slope"},  {"band57-slope"},  {"band58-slope"},  {"band59-slope"},
+     {"band60-slope"},  {"band61-slope"},  {"band62-slope"},  {"band63-slope"},  {"band64-slope"},  {"band65-slope"},
+     {"band66-slope"},  {"band67-slope"},  {"band68-slope"},  {"band69-slope"},  {"band70-slope"},  {"band71-slope"},
+     {"band72-slope"},  {"band73-slope"},  {"band74-slope"},  {"band75-slope"},  {"band76-slope"},  {"band77-slope"},
+     {"band78-slope"},  {"band79-slope"},  {"band80-slope"},  {"band81-slope"},  {"band82-slope"},  {"band83-slope"},
+     {"band84-slope"},  {"band85-slope"},  {"band86-slope"},  {"band87-slope"},  {"band88-slope"},  {"band89-slope"},
+     {"band90-slope"},  {"band91-slope"},  {"band92-slope"},  {"band93-slope"},  {"band94-slope"},  {"band95-slope"},
+     {"band96-slope"},  {"band97-slope"},  {"band98-slope"},  {"band99-slope"},  {"band100-slope"}, {"band101-slope"},
+     {"band102-slope"}, {"band103-slope"}, {"band104-slope"}, {"band105-slope"}, {"band106-slope"}, {"band107-slope"},
+     {"band108-slope"}, {"band109-slope"}, {"band110-slope"}, {"band111-slope"}, {"band112-slope"}, {"band113-slope"},
+     {"band114-slope"}, {"band115-slope"}, {"band116-slope"}, {"band117-slope"}, {"band118-slope"}, {"band119-slope"},
+     {"band120-slope"}, {"band121-slope"}, {"band122-slope"}, {"band123-slope"}, {"band124-slope"}, {"band125-slope"},
+     {"band126-slope"}, std::to_array("band127-slope")});
+
+constexpr auto band_solo = std::to_array(
+    {{"band0-solo"},   {"band1-solo"},   {"band2-solo"},   {"band3-solo"},   {"band4-solo"},   {"band5-solo"},
+     {"band6-solo"},   {"band7-solo"},   {"band8-solo"},   {"band9-solo"},   {"band10-solo"},  {"band11-solo"},
+     {"band12-solo"},  {"band13-solo"},  {"band14-solo"},  {"band15-solo"},  {"band16-solo"},  {"band17-solo"},
+     {"band18-solo"},  {"band19-solo"},  {"band20-solo"},  {"band21-solo"},  {"band22-solo"},  {"band23-solo"},
+     {"band24-solo"},  {"band25-solo"},  {"band26-solo"},  {"band27-solo"},  {"band28-solo"},  {"band29-solo"},
+     {"band30-solo"},  {"band31-solo"},  {"band32-solo"},  {"band33-solo"},  {"band34-solo"},  {"band35-solo"},
+     {"band36-solo"},  {"band37-solo"},  {"band38-solo"},  {"band39-solo"},  {"band40-solo"},  {"band41-solo"},
+     {"band42-solo"},  {"band43-solo"},  {"band44-solo"},  {"band45-solo"},  {"band46-solo"},  {"band47-solo"},
+     {"band48-solo"},  {"band49-solo"},  {"band50-solo"},  {"band51-solo"},  {"band52-solo"},  {"band53-solo"},
+     {"band54-solo"},  {"band55-solo"},  {"band56-solo"},  {"band57-solo"},  {"band58-solo"},  {"band59-solo"},
+     {"band60-solo"},  {"band61-solo"},  {"band62-solo"},  {"band63-solo"},  {"band64-solo"},  {"band65-solo"},
+     {"band66-solo"},  {"band67-solo"},  {"band68-solo"},  {"band69-solo"},  {"band70-solo"},  {"band71-solo"},
+     {"band72-solo"},  {"band73-solo"},  {"band74-solo"},  {"band75-solo"},  {"band76-solo"},  {"band77-solo"},
+     {"band78-solo"},  {"band79-solo"},  {"band80-solo"},  {"band81-solo"},  {"band82-solo"},  {"band83-solo"},
+     {"band84-solo"},  {"band85-solo"},  {"band86-solo"},  {"band87-solo"},  {"band88-solo"},  {"band89-solo"},
+     {"band90-solo"},  {"band91-solo"},  {"band92-solo"},  {"band93-solo"},  {"band94-solo"},  {"band95-solo"},
+     {"band96-solo"},  {"band97-solo"},  {"band98-solo"},  {"band99-solo"},  {"band100-solo"}, {"band101-solo"},
+     {"band102-solo"}, {"band103-solo"}, {"band104-solo"}, {"band105-solo"}, {"band106-solo"}, {"band107-solo"},
+     {"band108-solo"}, {"band109-solo"}, {"band110-solo"}, {"band111-solo"}, {"band112-solo"}, {"band113-solo"},
+     {"band114-solo"}, {"band115-solo"}, {"band116-solo"}, {"band117-solo"}, {"band118-solo"}, {"band119-solo"},
+     {"band120-solo"}, {"band121-solo"}, {"band122-solo"}, {"band123-solo"}, {"band124-solo"}, {"band125-solo"},
+     {"band126-solo"}, std::to_array("band127-solo")});
+
+constexpr auto band_mute = std::to_array(
+    {{"band0-mute"},   {"band1-mute"},   {"band2-mute"},   {"band3-mute"},   {"band4-mute"},   {"band5-mute"},
+     {"band6-mute"},   {"band7-mute"},   {"band8-mute"},   {"band9-mute"},   {"band10-mute"},  {"band11-mute"},
+     {"band12-mute"},  {"band13-mute"},  {"band14-mute"},  {"band15-mute"},  {"band16-mute"},  {"band17-mute"},
+     {"band18-mute"},  {"band19-mute"},  {"band20-mute"},  {"band21-mute"},  {"band22-mute"},  {"band23-mute"},
+     {"band24-mute"},  {"band25-mute"},  {"band26-mute"},  {"band27-mute"},  {"band28-mute"},  {"band29-mute"},
+     {"band30-mute"},  {"band31-mute"},  {"band32-mute"},  {"band33-mute"},  {"band34-mute"},  {"band35-mute"},
+     {"band36-mute"},  {"band37-mute"},  {"band38-mute"},  {"band39-mute"},  {"band40-mute"},  {"band41-mute"},
+     {"band42-mute"},  {"band43-mute"},  {"band44-mute"},  {"band45-mute"},  {"band46-mute"},  {"band47-mute"},
+     {"band48-mute"},  {"band49-mute"},  {"band50-mute"},  {"band51-mute"},  {"band52-mute"},  {"band53-mute"},
+     {"band54-mute"},  {"band55-mute"},  {"band56-mute"},  {"band57-mute"},  {"band58-mute"},  {"band59-mute"},
+     {"band60-mute"},  {"band61-mute"},  {"band62-mute"},  {"band63-mute"},  {"band64-mute"},  {"band65-mute"},
+     {"band66-mute"},  {"band67-mute"},  {"band68-mute"},  {"band69-mute"},  {"band70-mute"},  {"band71-mute"},
+     {"band72-mute"},  {"band73-mute"},  {"band74-mute"},  {"band75-mute"},  {"band76-mute"},  {"band77-mute"},
+     {"band78-mute"},  {"band79-mute"},  {"band80-mute"},  {"band81-mute"},  {"band82-mute"},  {"band83-mute"},
+     {"band84-mute"},  {"band85-mute"},  {"band86-mute"},  {"band87-mute"},  {"band88-mute"},  {"band89-mute"},
+     {"band90-mute"},  {"band91-mute"},  {"band92-mute"},  {"band93-mute"},  {"band94-mute"},  {"band95-mute"},
+     {"band96-mute"},  {"band97-mute"},  {"band98-mute"},  {"band99-mute"},  {"band100-mute"}, {"band101-mute"},
+     {"band102-mute"}, {"band103-mute"}, {"band104-mute"}, {"band105-mute"}, {"band106-mute"}, {"band107-mute"},
+     {"band108-mute"}, {"band109-mute"}, {"band110-mute"}, {"band111-mute"}, {"band112-mute"}, {"band113-mute"},
+     {"band114-mute"}, {"band115-mute"}, {"band116-mute"}, {"band117-mute"}, {"band118-mute"}, {"band119-mute"},
+     {"band120-mute"}, {"band121-mute"}, {"band122-mute"}, {"band123-mute"}, {"band124-mute"}, {"band125-mute"},
+     {"band126-mute"}, std::to_array("band127-mute")});
 
 constexpr auto band_frequency = std::to_array(
-    {{"band0-frequency"},  {"band1-frequency"},  {"band2-frequency"},  {"band3-frequency"},
-     {"band4-frequency"},  {"band5-frequency"},  {"band6-frequency"},  {"band7-frequency"},
-     {"band8-frequency"},  {"band9-frequency"},  {"band10-frequency"}, {"band11-frequency"},
-     {"band12-frequency"}, {"band13-frequency"}, {"band14-frequency"}, {"band15-frequency"},
-     {"band16-frequency"}, {"band17-frequency"}, {"band18-frequency"}, {"band19-frequency"},
-     {"band20-frequency"}, {"band21-frequency"}, {"band22-frequency"}, {"band23-frequency"},
-     {"band24-frequency"}, {"band25-frequency"}, {"band26-frequency"}, {"band27-frequency"},
-     {"band28-frequency"}, {"band29-frequency"}, {"band30-frequency"}, std::to_array("band31-frequency")});
-
-constexpr auto band_q = std::to_array({{"band0-q"},  {"band1-q"},  {"band2-q"},  {"band3-q"},
-                                       {"band4-q"},  {"band5-q"},  {"band6-q"},  {"band7-q"},
-                                       {"band8-q"},  {"band9-q"},  {"band10-q"}, {"band11-q"},
-                                       {"band12-q"}, {"band13-q"}, {"band14-q"}, {"band15-q"},
-                                       {"band16-q"}, {"band17-q"}, {"band18-q"}, {"band19-q"},
-                                       {"band20-q"}, {"band21-q"}, {"band22-q"}, {"band23-q"},
-                                       {"band24-q"}, {"band25-q"}, {"band26-q"}, {"band27-q"},
-                                       {"band28-q"}, {"band29-q"}, {"band30-q"}, std::to_array("band31-q")});
-
-constexpr auto band_width =
-    std::to_array({{"band0-width"},  {"band1-width"},  {"band2-width"},  {"band3-width"},
-                   {"band4-width"},  {"band5-width"},  {"band6-width"},  {"band7-width"},
-                   {"band8-width"},  {"band9-width"},  {"band10-width"}, {"band11-width"},
-                   {"band12-width"}, {"band13-width"}, {"band14-width"}, {"band15-width"},
-                   {"band16-width"}, {"band17-width"}, {"band18-width"}, {"band19-width"},
-                   {"band20-width"}, {"band21-width"}, {"band22-width"}, {"band23-width"},
-                   {"band24-width"}, {"band25-width"}, {"band26-width"}, {"band27-width"},
-                   {"band28-width"}, {"band29-width"}, {"band30-width"}, std::to_array("band31-width")});
-
-constexpr auto band_gain =
-    std::to_array({{"band0-gain"},  {"band1-gain"},  {"band2-gain"},  {"band3-gain"},
-                   {"band4-gain"},  {"band5-gain"},  {"band6-gain"},  {"band7-gain"},
-                   {"band8-gain"},  {"band9-gain"},  {"band10-gain"}, {"band11-gain"},
-                   {"band12-gain"}, {"band13-gain"}, {"band14-gain"}, {"band15-gain"},
-                   {"band16-gain"}, {"band17-gain"}, {"band18-gain"}, {"band19-gain"},
-                   {"band20-gain"}, {"band21-gain"}, {"band22-gain"}, {"band23-gain"},
-                   {"band24-gain"}, {"band25-gain"}, {"band26-gain"}, {"band27-gain"},
-                   {"band28-gain"}, {"band29-gain"}, {"band30-gain"}, std::to_array("band31-gain")});
+    {{"band0-frequency"},   {"band1-frequency"},   {"band2-frequency"},   {"band3-frequency"},   {"band4-frequency"},
+     {"band5-frequency"},   {"band6-frequency"},   {"band7-frequency"},   {"band8-frequency"},   {"band9-frequency"},
+     {"band10-frequency"},  {"band11-frequency"},  {"band12-frequency"},  {"band13-frequency"},  {"band14-frequency"},
+     {"band15-frequency"},  {"band16-frequency"},  {"band17-frequency"},  {"band18-frequency"},  {"band19-frequency"},
+     {"band20-frequency"},  {"band21-frequency"},  {"band22-frequency"},  {"band23-frequency"},  {"band24-frequency"},
+     {"band25-frequency"},  {"band26-frequency"},  {"band27-frequency"},  {"band28-frequency"},  {"band29-frequency"},
+     {"band30-frequency"},  {"band31-frequency"},  {"band32-frequency"},  {"band33-frequency"},  {"band34-frequency"},
+     {"band35-frequency"},  {"band36-frequency"},  {"band37-frequency"},  {"band38-frequency"},  {"band39-frequency"},
+     {"band40-frequency"},  {"band41-frequency"},  {"band42-frequency"},  {"band43-frequency"},  {"band44-frequency"},
+     {"band45-frequency"},  {"band46-frequency"},  {"band47-frequency"},  {"band48-frequency"},  {"band49-frequency"},
+     {"band50-frequency"},  {"band51-frequency"},  {"band52-frequency"},  {"band53-frequency"},  {"band54-frequency"},
+     {"band55-frequency"},  {"band56-frequency"},  {"band57-frequency"},  {"band58-frequency"},  {"band59-frequency"},
+     {"band60-frequency"},  {"band61-frequency"},  {"band62-frequency"},  {"band63-frequency"},  {"band64-frequency"},
+     {"band65-frequency"},  {"band66-frequency"},  {"band67-frequency"},  {"band68-frequency"},  {"band69-frequency"},
+     {"band70-frequency"},  {"band71-frequency"},  {"band72-frequency"},  {"band73-frequency"},  {"band74-frequency"},
+     {"band75-frequency"},  {"band76-frequency"},  {"band77-frequency"},  {"band78-frequency"},  {"band79-frequency"},
+     {"band80-frequency"},  {"band81-frequency"},  {"band82-frequency"},  {"band83-frequency"},  {"band84-frequency"},
+     {"band85-frequency"},  {"band86-frequency"},  {"band87-frequency"},  {"band88-frequency"},  {"band89-frequency"},
+     {"band90-frequency"},  {"band91-frequency"},  {"band92-frequency"},  {"band93-frequency"},  {"band94-frequency"},
+     {"band95-frequency"},  {"band96-frequency"},  {"band97-frequency"},  {"band98-frequency"},  {"band99-frequency"},
+     {"band100-frequency"}, {"band101-frequency"}, {"band102-frequency"}, {"band103-frequency"}, {"band104-frequency"},
+     {"band105-frequency"}, {"band106-frequency"}, {"band107-frequency"}, {"band108-frequency"}, {"band109-frequency"},
+     {"band110-frequency"}, {"band111-frequency"}, {"band112-frequency"}, {"band113-frequency"}, {"band114-frequency"},
+     {"band115-frequency"}, {"band116-frequency"}, {"band117-frequency"}, {"band118-frequency"}, {"band119-frequency"},
+     {"band120-frequency"}, {"band121-frequency"}, {"band122-frequency"}, {"band123-frequency"}, {"band124-frequency"},
+     {"band125-frequency"}, {"band126-frequency"}, std::to_array("band127-frequency")});
+
+constexpr auto band_q = std::to_array(
+    {{"band0-q"},   {"band1-q"},   {"band2-q"},   {"band3-q"},   {"band4-q"},   {"band5-q"},   {"band6-q"},
+     {"band7-q"},   {"band8-q"},   {"band9-q"},   {"band10-q"},  {"band11-q"},  {"band12-q"},  {"band13-q"},
+     {"band14-q"},  {"band15-q"},  {"band16-q"},  {"band17-q"},  {"band18-q"},  {"band19-q"},  {"band20-q"},
+     {"band21-q"},  {"band22-q"},  {"band23-q"},  {"band24-q"},  {"band25-q"},  {"band26-q"},  {"band27-q"},
+     {"band28-q"},  {"band29-q"},  {"band30-q"},  {"band31-q"},  {"band32-q"},  {"band33-q"},  {"band34-q"},
+     {"band35-q"},  {"band36-q"},  {"band37-q"},  {"band38-q"},  {"band39-q"},  {"band40-q"},  {"band41-q"},
+     {"band42-q"},  {"band43-q"},  {"band44-q"},  {"band45-q"},  {"band46-q"},  {"band47-q"},  {"band48-q"},
+     {"band49-q"},  {"band50-q"},  {"band51-q"},  {"band52-q"},  {"band53-q"},  {"band54-q"},  {"band55-q"},
+     {"band56-q"},  {"band57-q"},  {"band58-q"},  {"band59-q"},  {"band60-q"},  {"band61-q"},  {"band62-q"},
+     {"band63-q"},  {"band64-q"},  {"band65-q"},  {"band66-q"},  {"band67-q"},  {"band68-q"},  {"band69-q"},
+     {"band70-q"},  {"band71-q"},  {"band72-q"},  {"band73-q"},  {"band74-q"},  {"band75-q"},  {"band76-q"},
+     {"band77-q"},  {"band78-q"},  {"band79-q"},  {"band80-q"},  {"band81-q"},  {"band82-q"},  {"band83-q"},
+     {"band84-q"},  {"band85-q"},  {"band86-q"},  {"band87-q"},  {"band88-q"},  {"band89-q"},  {"band90-q"},
+     {"band91-q"},  {"band92-q"},  {"band93-q"},  {"band94-q"},  {"band95-q"},  {"band96-q"},  {"band97-q"},
+     {"band98-q"},  {"band99-q"},  {"band100-q"}, {"band101-q"}, {"band102-q"}, {"band103-q"}, {"band104-q"},
+     {"band105-q"}, {"band106-q"}, {"band107-q"}, {"band108-q"}, {"band109-q"}, {"band110-q"}, {"band111-q"},
+     {"band112-q"}, {"band113-q"}, {"band114-q"}, {"band115-q"}, {"band116-q"}, {"band117-q"}, {"band118-q"},
+     {"band119-q"}, {"band120-q"}, {"band121-q"}, {"band122-q"}, {"band123-q"}, {"band124-q"}, {"band125-q"},
+     {"band126-q"}, std::to_array("band127-q")});
+
+constexpr auto band_width = std::to_array(
+    {{"band0-width"},   {"band1-width"},   {"band2-width"},   {"band3-width"},   {"band4-width"},   {"band5-width"},
+     {"band6-width"},   {"band7-width"},   {"band8-width"},   {"band9-width"},   {"band10-width"},  {"band11-width"},
+     {"band12-width"},  {"band13-width"},  {"band14-width"},  {"band15-width"},  {"band16-width"},  {"band17-width"},
+     {"band18-width"},  {"band19-width"},  {"band20-width"},  {"band21-width"},  {"band22-width"},  {"band23-width"},
+     {"band24-width"},  {"band25-width"},  {"band26-width"},  {"band27-width"},  {"band28-width"},  {"band29-width"},
+     {"band30-width"},  {"band31-width"},  {"band32-width"},  {"band33-width"},  {"band34-width"},  {"band35-width"},
+     {"band36-width"},  {"band37-width"},  {"band38-width"},  {"band39-width"},  {"band40-width"},  {"band41-width"},
+     {"band42-width"},  {"band43-width"},  {"band44-width"},  {"band45-width"},  {"band46-width"},  {"band47-width"},
+     {"band48-width"},  {"band49-width"},  {"band50-width"},  {"band51-width"},  {"band52-width"},  {"band53-width"},
+     {"band54-width"},  {"band55-width"},  {"band56-width"},  {"band57-width"},  {"band58-width"},  {"band59-width"},
+     {"band60-width"},  {"band61-width"},  {"band62-width"},  {"band63-width"},  {"band64-width"},  {"band65-width"},
+     {"band66-width"},  {"band67-width"},  {"band68-width"},  {"band69-width"},  {"band70-width"},  {"band71-width"},
+     {"band72-width"},  {"band73-width"},  {"band74-width"},  {"band75-width"},  {"band76-width"},  {"band77-width"},
+     {"band78-width"},  {"band79-width"},  {"band80-width"},  {"band81-width"},  {"band82-width"},  {"band83-width"},
+     {"band84-width"},  {"band85-width"},  {"band86-width"},  {"band87-width"},  {"band88-width"},  {"band89-width"},
+     {"band90-width"},  {"band91-width"},  {"band92-width"},  {"band93-width"},  {"band94-width"},  {"band95-width"},
+     {"band96-width"},  {"band97-width"},  {"band98-width"},  {"band99-width"},  {"band100-width"}, {"band101-width"},
+     {"band102-width"}, {"band103-width"}, {"band104-width"}, {"band105-width"}, {"band106-width"}, {"band107-width"},
+     {"band108-width"}, {"band109-width"}, {"band110-width"}, {"band111-width"}, {"band112-width"}, {"band113-width"},
+     {"band114-width"}, {"band115-width"}, {"band116-width"}, {"band117-width"}, {"band118-width"}, {"band119-width"},
+     {"band120-width"}, {"band121-width"}, {"band122-width"}, {"band123-width"}, {"band124-width"}, {"band125-width"},
+     {"band126-width"}, std::to_array("band127-width")});
+
+constexpr auto band_gain = std::to_array(
+    {{"band0-gain"},   {"band1-gain"},   {"band2-gain"},   {"band3-gain"},   {"band4-gain"},   {"band5-gain"},
+     {"band6-gain"},   {"band7-gain"},   {"band8-gain"},   {"band9-gain"},   {"band10-gain"},  {"band11-gain"},
+     {"band12-gain"},  {"band13-gain"},  {"band14-gain"},  {"band15-gain"},  {"band16-gain"},  {"band17-gain"},
+     {"band18-gain"},  {"band19-gain"},  {"band20-gain"},  {"band21-gain"},  {"band22-gain"},  {"band23-gain"},
+     {"band24-gain"},  {"band25-gain"},  {"band26-gain"},  {"band27-gain"},  {"band28-gain"},  {"band29-gain"},
+     {"band30-gain"},  {"band31-gain"},  {"band32-gain"},  {"band33-gain"},  {"band34-gain"},  {"band35-gain"},
+     {"band36-gain"},  {"band37-gain"},  {"band38-gain"},  {"band39-gain"},  {"band40-gain"},  {"band41-gain"},
+     {"band42-gain"},  {"band43-gain"},  {"band44-gain"},  {"band45-gain"},  {"band46-gain"},  {"band47-gain"},
+     {"band48-gain"},  {"band49-gain"},  {"band50-gain"},  {"band51-gain"},  {"band52-gain"},  {"band53-gain"},
+     {"band54-gain"},  {"band55-gain"},  {"band56-gain"},  {"band57-gain"},  {"band58-gain"},  {"band59-gain"},
+     {"band60-gain"},  {"band61-gain"},  {"band62-gain"},  {"band63-gain"},  {"band64-gain"},  {"band65-gain"},
+     {"band66-gain"},  {"band67-gain"},  {"band68-gain"},  {"band69-gain"},  {"band70-gain"},  {"band71-gain"},
+     {"band72-gain"},  {"band73-gain"},  {"band74-gain"},  {"band75-gain"},  {"band76-gain"},  {"band77-gain"},
+     {"band78-gain"},  {"band79-gain"},  {"band80-gain"},  {"band81-gain"},  {"band82-gain"},  {"band83-gain"},
+     {"band84-gain"},  {"band85-gain"},  {"band86-gain"},  {"band87-gain"},  {"band88-gain"},  {"band89-gain"},
+     {"band90-gain"},  {"band91-gain"},  {"band92-gain"},  {"band93-gain"},  {"band94-gain"},  {"band95-gain"},
+     {"band96-gain"},  {"band97-gain"},  {"band98-gain"},  {"band99-gain"},  {"band100-gain"}, {"band101-gain"},
+     {"band102-gain"}, {"band103-gain"}, {"band104-gain"}, {"band105-gain"}, {"band106-gain"}, {"band107-gain"},
+     {"band108-gain"}, {"band109-gain"}, {"band110-gain"}, {"band111-gain"}, {"band112-gain"}, {"band113-gain"},
+     {"band114-gain"}, {"band115-gain"}, {"band116-gain"}, {"band117-gain"}, {"band118-gain"}, {"band119-gain"},
+     {"band120-gain"}, {"band121-gain"}, {"band122-gain"}, {"band123-gain"}, {"band124-gain"}, {"band125-gain"},
+     {"band126-gain"}, std::to_array("band127-gain")});
 
 // left channel
 
@@ -117,6 +117,8 @@ inline constexpr auto plugins_menu_ui = "/com/github/wwmm/easyeffects/ui/plugins
 
 inline constexpr auto preferences_general_ui = "/com/github/wwmm/easyeffects/ui/preferences_general.ui";
 
+inline constexpr auto preferences_routing_ui = "/com/github/wwmm/easyeffects/ui/preferences_routing.ui";
+
 inline constexpr auto preferences_spectrum_ui = "/com/github/wwmm/easyeffects/ui/preferences_spectrum.ui";
 
 inline constexpr auto preferences_window_ui = "/com/github/wwmm/easyeffects/ui/preferences_window.ui";
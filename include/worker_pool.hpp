@@ -0,0 +1,110 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+/*
+  Small pool of low priority threads shared by all the plugins for the work that can not be done in the realtime
+  thread and should not block the main loop: kernel builds, ebur128 initialization, model loading and file reading.
+
+  Jobs submitted with the same owner run one at a time and in the order they were submitted, so a plugin does not have
+  to protect its maintenance state against itself. Jobs without owner may run in parallel.
+*/
+
+class WorkerPool {
+ public:
+  class Task {
+   public:
+    // Pending jobs are dropped. Running jobs should check is_cancelled and return early.
+
+    void cancel();
+
+    [[nodiscard]] auto is_cancelled() const -> bool;
+
+    [[nodiscard]] auto is_finished() const -> bool;
+
+    // Returns after the job has run or has been dropped.
+
+    void wait();
+
+   private:
+    friend class WorkerPool;
+
+    const void* owner = nullptr;
+
+    std::function<void(const Task&)> job;
+
+    std::atomic<bool> cancelled = false;
+
+    bool finished = false;
+
+    mutable std::mutex mutex;
+
+    std::condition_variable cv;
+
+    void finish();
+  };
+
+  WorkerPool(const WorkerPool&) = delete;
+  auto operator=(const WorkerPool&) -> WorkerPool& = delete;
+  WorkerPool(const WorkerPool&&) = delete;
+  auto operator=(const WorkerPool&&) -> WorkerPool& = delete;
+  ~WorkerPool();
+
+  static auto get() -> WorkerPool&;
+
+  auto submit(const void* owner, std::function<void(const Task&)> job) -> std::shared_ptr<Task>;
+
+  // Drops the pending jobs of owner and waits for the one that is running. Owners call it before being destroyed.
+
+  void cancel_all(const void* owner);
+
+  // Returns once owner has no pending or running job.
+
+  void wait(const void* owner);
+
+ private:
+  WorkerPool();
+
+  bool quit = false;
+
+  std::mutex mutex;
+
+  std::condition_variable cv;
+
+  std::deque<std::shared_ptr<Task>> queue;
+
+  std::set<const void*> busy_owners;
+
+  std::vector<std::thread> threads;
+
+  void run();
+
+  auto next_task() -> std::shared_ptr<Task>;
+};
@@ -0,0 +1,784 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "aec_engine.hpp"
+#include <fftw3.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <thread>
+#include <utility>
+#include "fftw_planner.hpp"
+
+namespace {
+
+constexpr float step_size = 0.5F;
+
+constexpr float far_end_threshold = 1e-8F;  // mean square of a probe block below which the filter is not adapted
+
+constexpr uint max_delay_ms = 500U;
+
+constexpr uint envelope_window = 100U;  // blocks correlated by the delay search
+
+constexpr uint delay_search_interval = 25U;  // blocks
+
+constexpr uint delay_margin = 1U;  // blocks left before the estimated delay for the start of the echo path
+
+constexpr float min_correlation = 0.5F;
+
+auto db_to_linear(const int& value) -> float {
+  return std::pow(10.0F, static_cast<float>(value) / 20.0F);
+}
+
+}  // namespace
+
+AecEngine::AecEngine() = default;
+
+AecEngine::~AecEngine() {
+  stop_worker();
+
+  free_buffers();
+}
+
+void AecEngine::init(const uint& rate, const uint& frame_size, const uint& filter_length_ms) {
+  wait_worker();
+
+  free_buffers();
+
+  if (rate == 0U || frame_size == 0U) {
+    return;
+  }
+
+  this->rate = rate;
+
+  block_size = frame_size;
+  fft_size = 2U * block_size;
+  n_bins = block_size + 1U;
+
+  const auto filter_length = static_cast<size_t>(filter_length_ms) * rate / 1000U;
+
+  n_partitions = std::max(1U, static_cast<uint>((filter_length + block_size - 1U) / block_size));
+
+  max_delay = max_delay_ms * rate / 1000U / block_size;
+
+  n_history = n_partitions + max_delay;
+
+  n_envelope = envelope_window + max_delay;
+
+  far_time.resize(fft_size);
+  far_spectra.resize(static_cast<size_t>(n_history) * n_bins);
+  far_power.resize(n_bins);
+
+  far_envelope.resize(n_envelope);
+  mic_envelope.resize(n_envelope);
+
+  // Periodic square root Hann window. Its squares add up to one when the frames overlap by half.
+
+  window.resize(fft_size);
+
+  for (uint n = 0U; n < fft_size; n++) {
+    window[n] = std::sin(std::numbers::pi_v<float> * static_cast<float>(n) / static_cast<float>(fft_size));
+  }
+
+  far_block.spectra.resize(static_cast<size_t>(n_partitions) * n_bins);
+  far_block.power.resize(n_bins);
+
+  worker_far.spectra.resize(static_cast<size_t>(n_partitions) * n_bins);
+  worker_far.power.resize(n_bins);
+
+  worker_mic.resize(block_size);
+  worker_out.resize(block_size);
+  pending_left.resize(block_size);
+
+  for (auto& c : channels) {
+    c.background.resize(static_cast<size_t>(n_partitions) * n_bins);
+    c.foreground.resize(static_cast<size_t>(n_partitions) * n_bins);
+
+    c.error_spectrum.resize(n_bins);
+    c.error_power.resize(n_bins);
+    c.echo_power.resize(n_bins);
+    c.gain.resize(n_bins);
+
+    c.error_background.resize(block_size);
+    c.error_foreground.resize(block_size);
+    c.echo.resize(block_size);
+
+    c.echo_previous.resize(block_size);
+    c.error_previous.resize(block_size);
+    c.overlap.resize(block_size);
+
+    c.time = fftwf_alloc_real(fft_size);
+    c.freq = fftwf_alloc_complex(n_bins);
+  }
+
+  {
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
+    forward = fftwf_plan_dft_r2c_1d(static_cast<int>(fft_size), channels[0].time, channels[0].freq, FFTW_ESTIMATE);
+    backward = fftwf_plan_dft_c2r_1d(static_cast<int>(fft_size), channels[0].freq, channels[0].time, FFTW_ESTIMATE);
+  }
+
+  initialized = true;
+
+  reset();
+}
+
+void AecEngine::reset() {
+  wait_worker();
+
+  shared = false;
+
+  delay = 0U;
+  head = 0U;
+
+  envelope_pos = 0U;
+  envelope_filled = 0U;
+  search_countdown = delay_search_interval;
+  delay_candidate = 0U;
+
+  far_energy = 0.0F;
+
+  std::ranges::fill(far_time, 0.0F);
+  std::ranges::fill(far_spectra, 0.0F);
+  std::ranges::fill(far_power, 0.0F);
+  std::ranges::fill(far_envelope, 0.0F);
+  std::ranges::fill(mic_envelope, 0.0F);
+
+  std::ranges::fill(worker_out, 0.0F);
+  std::ranges::fill(pending_left, 0.0F);
+
+  for (auto& c : channels) {
+    std::ranges::fill(c.background, 0.0F);
+    std::ranges::fill(c.foreground, 0.0F);
+    std::ranges::fill(c.error_power, 0.0F);
+    std::ranges::fill(c.echo_power, 0.0F);
+    std::ranges::fill(c.gain, 1.0F);
+
+    std::ranges::fill(c.echo_previous, 0.0F);
+    std::ranges::fill(c.error_previous, 0.0F);
+    std::ranges::fill(c.overlap, 0.0F);
+
+    c.energy_background = 0.0F;
+    c.energy_foreground = 0.0F;
+    c.leak = 0.0F;
+    c.constrained_partition = 0U;
+  }
+}
+
+void AecEngine::set_residual_echo_suppression(const int& value) {
+  residual_floor = db_to_linear(value);
+}
+
+void AecEngine::set_near_end_suppression(const int& value) {
+  near_end_floor = db_to_linear(value);
+}
+
+void AecEngine::set_multithreading(const bool& state) {
+  if (!state) {
+    stop_worker();
+
+    return;
+  }
+
+  if (worker.joinable()) {
+    return;
+  }
+
+  std::ranges::fill(worker_out, 0.0F);
+  std::ranges::fill(pending_left, 0.0F);
+
+  quit_worker = false;
+
+  worker = std::thread([this]() {
+    while (true) {
+      worker_start.acquire();
+
+      if (quit_worker) {
+        break;
+      }
+
+      process_channel(channels[1], worker_far, worker_mic, worker_out);
+
+      worker_done.release();
+    }
+  });
+}
+
+void AecEngine::stop_worker() {
+  if (!worker.joinable()) {
+    return;
+  }
+
+  wait_worker();
+
+  quit_worker = true;
+
+  worker_start.release();
+
+  worker.join();
+}
+
+// Only called outside the realtime thread, where waiting for the worker is fine.
+
+void AecEngine::wait_worker() {
+  if (!worker_busy) {
+    return;
+  }
+
+  worker_done.acquire();
+
+  worker_busy = false;
+  worker_late = false;
+}
+
+void AecEngine::free_buffers() {
+  initialized = false;
+
+  {
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
+    if (forward != nullptr) {
+      fftwf_destroy_plan(forward);
+    }
+
+    if (backward != nullptr) {
+      fftwf_destroy_plan(backward);
+    }
+  }
+
+  forward = nullptr;
+  backward = nullptr;
+
+  for (auto& c : channels) {
+    if (c.time != nullptr) {
+      fftwf_free(c.time);
+    }
+
+    if (c.freq != nullptr) {
+      fftwf_free(c.freq);
+    }
+
+    c.time = nullptr;
+    c.freq = nullptr;
+  }
+}
+
+auto AecEngine::get_delay() const -> uint {
+  return delay * block_size;
+}
+
+auto AecEngine::get_latency() const -> uint {
+  return worker.joinable() ? 2U * block_size : block_size;
+}
+
+void AecEngine::process(std::span<const float> mic_left,
+                        std::span<const float> mic_right,
+                        std::span<const float> probe,
+                        std::span<float> out_left,
+                        std::span<float> out_right) {
+  if (!initialized || mic_left.size() != block_size) {
+    std::ranges::copy(mic_left, out_left.begin());
+    std::ranges::copy(mic_right, out_right.begin());
+
+    return;
+  }
+
+  const auto threaded = worker.joinable();
+
+  if (threaded) {
+    /*
+      The output is one block late. The worker owns the right channel until it is done, but it has its own copy of the
+      far end, so the history keeps moving. When it is late its result is dropped and the right channel takes the
+      output of the left filter, like the single filter path does, until it is free again.
+    */
+
+    bool right_ready = false;
+
+    if (worker_busy && worker_done.try_acquire()) {
+      worker_busy = false;
+
+      right_ready = !worker_late;
+
+      worker_late = false;
+    }
+
+    if (worker_busy) {
+      worker_late = true;
+    }
+
+    std::ranges::copy(pending_left, out_left.begin());
+    std::ranges::copy(right_ready ? worker_out : pending_left, out_right.begin());
+  }
+
+  push_far_end(probe);
+
+  estimate_delay(mic_left, mic_right, probe);
+
+  // A single filter is enough when both channels come from the same microphone.
+
+  float difference = 0.0F;
+  float sum = 0.0F;
+
+  for (uint n = 0U; n < block_size; n++) {
+    difference += (mic_left[n] - mic_right[n]) * (mic_left[n] - mic_right[n]);
+    sum += (mic_left[n] + mic_right[n]) * (mic_left[n] + mic_right[n]);
+  }
+
+  const bool identical = difference <= 1e-6F * sum;
+
+  // The right filter can not be touched while the worker is busy. It is synced once the worker is free.
+
+  if (shared && !identical && !worker_busy) {
+    auto& l = channels[0];
+    auto& r = channels[1];
+
+    std::ranges::copy(l.background, r.background.begin());
+    std::ranges::copy(l.foreground, r.foreground.begin());
+    std::ranges::copy(l.error_power, r.error_power.begin());
+    std::ranges::copy(l.echo_power, r.echo_power.begin());
+    std::ranges::copy(l.gain, r.gain.begin());
+    std::ranges::copy(l.echo_previous, r.echo_previous.begin());
+    std::ranges::copy(l.error_previous, r.error_previous.begin());
+    std::ranges::copy(l.overlap, r.overlap.begin());
+
+    r.energy_background = l.energy_background;
+    r.energy_foreground = l.energy_foreground;
+    r.leak = l.leak;
+  }
+
+  if (!worker_busy) {
+    shared = identical;
+  }
+
+  gather_far_end(far_block);
+
+  if (threaded) {
+    if (shared || worker_busy) {
+      process_channel(channels[0], far_block, mic_left, pending_left);
+    } else {
+      std::ranges::copy(mic_right, worker_mic.begin());
+
+      std::swap(far_block, worker_far);
+
+      worker_busy = true;
+
+      worker_start.release();
+
+      // Both threads only read the far end given to the worker.
+
+      process_channel(channels[0], worker_far, mic_left, pending_left);
+    }
+  } else if (shared) {
+    process_channel(channels[0], far_block, mic_left, out_left);
+
+    std::ranges::copy(out_left, out_right.begin());
+  } else {
+    process_channel(channels[0], far_block, mic_left, out_left);
+    process_channel(channels[1], far_block, mic_right, out_right);
+  }
+}
+
+void AecEngine::push_far_end(std::span<const float> probe) {
+  std::copy(far_time.begin() + block_size, far_time.end(), far_time.begin());
+  std::copy_n(probe.begin(), block_size, far_time.begin() + block_size);
+
+  head = (head + 1U) % n_history;
+
+  auto& c = channels[0];
+
+  std::ranges::copy(far_time, c.time);
+
+  fftwf_execute_dft_r2c(forward, c.time, c.freq);
+
+  const auto* spectrum = reinterpret_cast<std::complex<float>*>(c.freq);
+
+  auto* x = far_spectra.data() + static_cast<size_t>(head) * n_bins;
+
+  for (uint k = 0U; k < n_bins; k++) {
+    x[k] = spectrum[k];
+
+    far_power[k] = 0.9F * far_power[k] + 0.1F * std::norm(spectrum[k]);
+  }
+
+  far_energy = 0.0F;
+
+  for (const auto& v : probe) {
+    far_energy += v * v;
+  }
+
+  far_energy /= static_cast<float>(block_size);
+}
+
+// Copies the far end spectra delayed for each partition out of the history, so the filters read them contiguously.
+
+void AecEngine::gather_far_end(FarEnd& far) {
+  for (uint p = 0U; p < n_partitions; p++) {
+    const auto* x = far_spectra.data() + static_cast<size_t>((head + 2U * n_history - delay - p) % n_history) * n_bins;
+
+    std::copy_n(x, n_bins, far.spectra.data() + static_cast<size_t>(p) * n_bins);
+  }
+
+  std::ranges::copy(far_power, far.power.begin());
+
+  far.energy = far_energy;
+}
+
+/*
+  The log energy envelopes of the probe and of the microphone are kept for the last seconds. From time to time the
+  lag with the largest normalized correlation between them is searched. It has to be found twice in a row before the
+  far end spectra given to the filter are delayed by it.
+*/
+
+void AecEngine::estimate_delay(std::span<const float> mic_left,
+                               std::span<const float> mic_right,
+                               std::span<const float> probe) {
+  float mic_energy = 0.0F;
+  float probe_energy = 0.0F;
+
+  for (uint n = 0U; n < block_size; n++) {
+    const auto mid = 0.5F * (mic_left[n] + mic_right[n]);
+
+    mic_energy += mid * mid;
+    probe_energy += probe[n] * probe[n];
+  }
+
+  mic_envelope[envelope_pos] = std::log10(mic_energy + 1e-10F);
+  far_envelope[envelope_pos] = std::log10(probe_energy + 1e-10F);
+
+  envelope_pos = (envelope_pos + 1U) % n_envelope;
+
+  envelope_filled = std::min(envelope_filled + 1U, n_envelope);
+
+  if (--search_countdown > 0U) {
+    return;
+  }
+
+  search_countdown = delay_search_interval;
+
+  if (envelope_filled < n_envelope) {
+    return;
+  }
+
+  // index of the block that is i blocks older than the newest one
+
+  const auto at = [&](const std::vector<float>& envelope, const uint& i) {
+    return envelope[(envelope_pos + n_envelope - 1U - i) % n_envelope];
+  };
+
+  float mic_mean = 0.0F;
+
+  for (uint i = 0U; i < envelope_window; i++) {
+    mic_mean += at(mic_envelope, i);
+  }
+
+  mic_mean /= static_cast<float>(envelope_window);
+
+  float best_correlation = min_correlation;
+  uint best_lag = 0U;
+  bool found = false;
+
+  for (uint lag = 0U; lag <= max_delay; lag++) {
+    float far_mean = 0.0F;
+
+    for (uint i = 0U; i < envelope_window; i++) {
+      far_mean += at(far_envelope, i + lag);
+    }
+
+    far_mean /= static_cast<float>(envelope_window);
+
+    float cross = 0.0F;
+    float mic_var = 0.0F;
+    float far_var = 0.0F;
+
+    for (uint i = 0U; i < envelope_window; i++) {
+      const auto m = at(mic_envelope, i) - mic_mean;
+      const auto f = at(far_envelope, i + lag) - far_mean;
+
+      cross += m * f;
+      mic_var += m * m;
+      far_var += f * f;
+    }
+
+    if (mic_var < 1e-6F || far_var < 1e-6F) {
+      continue;
+    }
+
+    const auto correlation = cross / std::sqrt(mic_var * far_var);
+
+    if (correlation > best_correlation) {
+      best_correlation = correlation;
+      best_lag = lag;
+      found = true;
+    }
+  }
+
+  if (!found) {
+    return;
+  }
+
+  if (best_lag != delay_candidate) {
+    delay_candidate = best_lag;
+
+    return;
+  }
+
+  const auto new_delay = (best_lag > delay_margin) ? best_lag - delay_margin : 0U;
+
+  // The filters of the worker are shifted too. While it is busy the delay is applied by a later search.
+
+  if (new_delay != delay && !worker_busy) {
+    shift_filters(static_cast<int>(new_delay) - static_cast<int>(delay));
+
+    delay = new_delay;
+  }
+}
+
+// Keeps the echo path already learned when the far end spectra given to the filter are moved by the new delay.
+
+void AecEngine::shift_filters(const int& partitions) {
+  const auto p_max = static_cast<int>(n_partitions);
+
+  const auto shift = [&](std::vector<std::complex<float>>& weights) {
+    const auto move = [&](const int& p) {
+      const auto source = p + partitions;
+
+      auto* destination = weights.data() + static_cast<size_t>(p) * n_bins;
+
+      if (source >= 0 && source < p_max) {
+        std::copy_n(weights.data() + static_cast<size_t>(source) * n_bins, n_bins, destination);
+      } else {
+        std::fill_n(destination, n_bins, 0.0F);
+      }
+    };
+
+    if (partitions > 0) {
+      for (int p = 0; p < p_max; p++) {
+        move(p);
+      }
+    } else {
+      for (int p = p_max - 1; p >= 0; p--) {
+        move(p);
+      }
+    }
+  };
+
+  for (auto& c : channels) {
+    shift(c.background);
+    shift(c.foreground);
+  }
+}
+
+// Overlap-save convolution of the delayed far end with the given weights. The echo estimate is removed from mic.
+
+void AecEngine::filter(Channel& c,
+                       const FarEnd& far,
+                       std::span<const std::complex<float>> weights,
+                       std::span<const float> mic,
+                       std::span<float> error) {
+  auto* spectrum = reinterpret_cast<std::complex<float>*>(c.freq);
+
+  std::fill_n(spectrum, n_bins, 0.0F);
+
+  for (uint p = 0U; p < n_partitions; p++) {
+    const auto* x = far.spectra.data() + static_cast<size_t>(p) * n_bins;
+    const auto* w = weights.data() + static_cast<size_t>(p) * n_bins;
+
+    for (uint k = 0U; k < n_bins; k++) {
+      spectrum[k] += w[k] * x[k];
+    }
+  }
+
+  fftwf_execute_dft_c2r(backward, c.freq, c.time);
+
+  const auto norm = 1.0F / static_cast<float>(fft_size);
+
+  for (uint n = 0U; n < block_size; n++) {
+    error[n] = mic[n] - c.time[block_size + n] * norm;
+  }
+}
+
+// Normalized least mean squares update of the background filter. One partition is constrained per block.
+
+void AecEngine::adapt(Channel& c, const FarEnd& far) {
+  std::fill_n(c.time, block_size, 0.0F);
+  std::ranges::copy(c.error_background, c.time + block_size);
+
+  fftwf_execute_dft_r2c(forward, c.time, c.freq);
+
+  auto* spectrum = reinterpret_cast<std::complex<float>*>(c.freq);
+
+  const auto regularization = far_end_threshold * static_cast<float>(fft_size * block_size);
+
+  for (uint k = 0U; k < n_bins; k++) {
+    spectrum[k] *= step_size / (static_cast<float>(n_partitions) * far.power[k] + regularization);
+  }
+
+  for (uint p = 0U; p < n_partitions; p++) {
+    const auto* x = far.spectra.data() + static_cast<size_t>(p) * n_bins;
+
+    auto* w = c.background.data() + static_cast<size_t>(p) * n_bins;
+
+    for (uint k = 0U; k < n_bins; k++) {
+      w[k] += spectrum[k] * std::conj(x[k]);
+    }
+  }
+
+  // The second half of the impulse response of the constrained partition is cleared.
+
+  auto* w = c.background.data() + static_cast<size_t>(c.constrained_partition) * n_bins;
+
+  std::copy_n(w, n_bins, spectrum);
+
+  fftwf_execute_dft_c2r(backward, c.freq, c.time);
+
+  const auto norm = 1.0F / static_cast<float>(fft_size);
+
+  std::transform(c.time, c.time + block_size, c.time, [&](const auto& v) { return v * norm; });
+
+  std::fill_n(c.time + block_size, block_size, 0.0F);
+
+  fftwf_execute_dft_r2c(forward, c.time, c.freq);
+
+  std::copy_n(spectrum, n_bins, w);
+
+  c.constrained_partition = (c.constrained_partition + 1U) % n_partitions;
+}
+
+/*
+  The residual echo is taken as a fraction of the echo estimate. The fraction is found by regressing the error power
+  on the echo power over all the bins. The suppression is limited by the near end floor while the near end talks.
+
+  The gains are applied to windowed frames made of the previous and the current block. The frames are windowed again
+  after the inverse transform and overlap-added, so the output is the previous block.
+*/
+
+void AecEngine::suppress(Channel& c, std::span<float> output) {
+  auto* spectrum = reinterpret_cast<std::complex<float>*>(c.freq);
+
+  const auto analyse = [&](std::vector<float>& previous, std::span<const float> current) {
+    for (uint n = 0U; n < block_size; n++) {
+      c.time[n] = previous[n] * window[n];
+      c.time[block_size + n] = current[n] * window[block_size + n];
+    }
+
+    std::ranges::copy(current, previous.begin());
+
+    fftwf_execute_dft_r2c(forward, c.time, c.freq);
+  };
+
+  analyse(c.echo_previous, c.echo);
+
+  for (uint k = 0U; k < n_bins; k++) {
+    c.echo_power[k] = 0.7F * c.echo_power[k] + 0.3F * std::norm(spectrum[k]);
+  }
+
+  analyse(c.error_previous, c.error_foreground);
+
+  std::copy_n(spectrum, n_bins, c.error_spectrum.begin());
+
+  float cross = 0.0F;
+  float echo_squared = 0.0F;
+
+  for (uint k = 0U; k < n_bins; k++) {
+    c.error_power[k] = 0.7F * c.error_power[k] + 0.3F * std::norm(spectrum[k]);
+
+    cross += c.error_power[k] * c.echo_power[k];
+    echo_squared += c.echo_power[k] * c.echo_power[k];
+  }
+
+  if (echo_squared > 0.0F) {
+    c.leak = 0.95F * c.leak + 0.05F * std::clamp(cross / echo_squared, 0.0F, 1.0F);
+  }
+
+  float residual_total = 0.0F;
+  float error_total = 0.0F;
+
+  for (uint k = 0U; k < n_bins; k++) {
+    residual_total += c.leak * c.echo_power[k];
+    error_total += c.error_power[k];
+  }
+
+  const auto floor = (error_total > 4.0F * residual_total) ? near_end_floor : residual_floor;
+
+  for (uint k = 0U; k < n_bins; k++) {
+    const auto residual = 2.0F * c.leak * c.echo_power[k];
+
+    c.gain[k] = std::max(1.0F - residual / (c.error_power[k] + 1e-12F), floor);
+
+    spectrum[k] = c.error_spectrum[k] * c.gain[k];
+  }
+
+  fftwf_execute_dft_c2r(backward, c.freq, c.time);
+
+  const auto norm = 1.0F / static_cast<float>(fft_size);
+
+  for (uint n = 0U; n < block_size; n++) {
+    output[n] = c.overlap[n] + c.time[n] * window[n] * norm;
+
+    c.overlap[n] = c.time[block_size + n] * window[block_size + n] * norm;
+  }
+}
+
+/*
+  Both filters are run. The foreground one is replaced by the background when the latter removes clearly more echo and
+  the background is restored from the foreground when it diverges, what usually happens during double talk.
+*/
+
+void AecEngine::process_channel(Channel& c, const FarEnd& far, std::span<const float> mic, std::span<float> output) {
+  filter(c, far, c.background, mic, c.error_background);
+  filter(c, far, c.foreground, mic, c.error_foreground);
+
+  float energy_background = 0.0F;
+  float energy_foreground = 0.0F;
+
+  for (uint n = 0U; n < block_size; n++) {
+    energy_background += c.error_background[n] * c.error_background[n];
+    energy_foreground += c.error_foreground[n] * c.error_foreground[n];
+  }
+
+  c.energy_background = 0.8F * c.energy_background + 0.2F * energy_background;
+  c.energy_foreground = 0.8F * c.energy_foreground + 0.2F * energy_foreground;
+
+  if (c.energy_background < 0.7F * c.energy_foreground) {
+    std::ranges::copy(c.background, c.foreground.begin());
+    std::ranges::copy(c.error_background, c.error_foreground.begin());
+
+    c.energy_foreground = c.energy_background;
+  } else if (c.energy_background > 4.0F * c.energy_foreground && c.energy_foreground > 0.0F) {
+    std::ranges::copy(c.foreground, c.background.begin());
+    std::ranges::copy(c.error_foreground, c.error_background.begin());
+
+    c.energy_background = c.energy_foreground;
+  }
+
+  if (far.energy > far_end_threshold) {
+    adapt(c, far);
+  }
+
+  for (uint n = 0U; n < block_size; n++) {
+    c.echo[n] = mic[n] - c.error_foreground[n];
+  }
+
+  suppress(c, output);
+}
@@ -32,13 +32,18 @@
 #include <ostream>
 #include <string>
 #include <thread>
+#include <vector>
 #include "application_ui.hpp"
 #include "config.h"
+#include "control_api.hpp"
+#include "offline_renderer.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "pipeline_type.hpp"
 #include "preferences_window.hpp"
 #include "preset_type.hpp"
 #include "presets_manager.hpp"
+#include "settings_store.hpp"
 #include "stream_input_effects.hpp"
 #include "stream_output_effects.hpp"
 #include "tags_app.hpp"
@@ -76,6 +81,71 @@ void update_bypass_state(Application* self) {
   util::info(((state) != 0 ? "enabling" : "disabling") + " global bypass"s);
 }
 
+void update_standby_presets(Application* self) {
+  std::vector<std::string> output_plugins;
+  std::vector<std::string> input_plugins;
+
+  for (const auto& name : util::gchar_array_to_vector(g_settings_get_strv(self->settings, "standby-output-presets"))) {
+    const auto list = self->presets_manager->prepare_standby_preset(PresetType::output, name);
+
+    output_plugins.insert(output_plugins.end(), list.begin(), list.end());
+  }
+
+  for (const auto& name : util::gchar_array_to_vector(g_settings_get_strv(self->settings, "standby-input-presets"))) {
+    const auto list = self->presets_manager->prepare_standby_preset(PresetType::input, name);
+
+    input_plugins.insert(input_plugins.end(), list.begin(), list.end());
+  }
+
+  self->soe->set_pinned_filters(output_plugins);
+  self->sie->set_pinned_filters(input_plugins);
+}
+
+/*
+  Handles --render. Output presets are looked up before the input ones. Nothing is saved because main() selects the
+  memory backend of GSettings for this option.
+*/
+
+auto render_files(Application* self, GVariantDict* options) -> int {
+  const char* name = nullptr;
+
+  g_variant_dict_lookup(options, "render", "&s", &name);
+
+  std::vector<std::string> paths;
+
+  if (const char** files = nullptr; g_variant_dict_lookup(options, G_OPTION_REMAINING, "^a&ay", &files) != 0) {
+    for (auto* file = files; *file != nullptr; file++) {
+      paths.emplace_back(*file);
+    }
+
+    g_free(static_cast<gpointer>(files));
+  }
+
+  if (name == nullptr || paths.size() != 2U) {
+    std::cerr << _("Usage: easyeffects --render PRESET INPUT OUTPUT") << '\n';
+
+    return EXIT_FAILURE;
+  }
+
+  auto preset_type = PresetType::output;
+
+  if (!self->presets_manager->preset_file_exists(PresetType::output, name)) {
+    if (!self->presets_manager->preset_file_exists(PresetType::input, name)) {
+      std::cerr << _("Preset not found") + ": "s + name << '\n';
+
+      return EXIT_FAILURE;
+    }
+
+    preset_type = PresetType::input;
+  }
+
+  self->presets_manager->load_local_preset_file(preset_type, name);
+
+  OfflineRenderer renderer((preset_type == PresetType::output) ? PipelineType::output : PipelineType::input);
+
+  return renderer.render(paths[0], paths[1]) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 void on_startup(GApplication* gapp) {
   G_APPLICATION_CLASS(application_parent_class)->startup(gapp);
 
@@ -90,6 +160,10 @@ void on_startup(GApplication* gapp) {
   self->soe = new StreamOutputEffects(self->pm);
   self->sie = new StreamInputEffects(self->pm);
 
+  if (auto* connection = g_application_get_dbus_connection(gapp); connection != nullptr) {
+    self->control_api = new ControlApi(connection, g_application_get_dbus_object_path(gapp), self->sie, self->soe);
+  }
+
   if (self->settings == nullptr) {
     self->settings = g_settings_new(tags::app::id);
   }
@@ -98,6 +172,14 @@ void on_startup(GApplication* gapp) {
     self->presets_manager = new PresetsManager();
   }
 
+  // The autoload presets are parsed once the main loop is running, so that the startup is not delayed by them.
+
+  util::idle_add([self]() {
+    if (self->presets_manager != nullptr) {
+      self->presets_manager->prepare_autoload_cache();
+    }
+  });
+
   PipeManager::exclude_monitor_stream = g_settings_get_boolean(self->settings, "exclude-monitor-streams") != 0;
 
   self->data->connections.push_back(self->pm->new_default_sink_name.connect([=](const std::string name) {
@@ -235,8 +317,20 @@ void on_startup(GApplication* gapp) {
                        }),
                        self));
 
+  for (const auto* key : {"changed::standby-output-presets", "changed::standby-input-presets"}) {
+    self->data->gconnections.push_back(g_signal_connect(
+        self->settings, key, G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+          auto* self = static_cast<Application*>(user_data);
+
+          update_standby_presets(self);
+        }),
+        self));
+  }
+
   update_bypass_state(self);
 
+  update_standby_presets(self);
+
   if ((g_application_get_flags(gapp) & G_APPLICATION_IS_SERVICE) != 0) {
     g_application_hold(gapp);
   }
@@ -279,6 +373,10 @@ void application_class_init(ApplicationClass* klass) {
       self->presets_manager = new PresetsManager();
     }
 
+    if (g_variant_dict_contains(options, "render") != 0) {
+      return render_files(self, options);
+    }
+
     if (g_variant_dict_contains(options, "presets") != 0) {
       std::string list;
 
@@ -427,12 +525,16 @@ void application_class_init(ApplicationClass* klass) {
 
     PipeManager::exiting = true;
 
+    settings_store::flush();
+
+    delete self->control_api;
     delete self->data;
     delete self->presets_manager;
     delete self->sie;
     delete self->soe;
     delete self->pm;
 
+    self->control_api = nullptr;
     self->data = nullptr;
     self->presets_manager = nullptr;
     self->sie = nullptr;
@@ -605,6 +707,17 @@ auto application_new() -> GApplication* {
   g_application_add_main_option(G_APPLICATION(app), "load-preset", 'l', G_OPTION_FLAG_NONE, G_OPTION_ARG_STRING,
                                 _("Load a preset. Example: easyeffects -l music"), nullptr);
 
+  g_application_add_main_option(
+      G_APPLICATION(app), "render", '\0', G_OPTION_FLAG_NONE, G_OPTION_ARG_STRING,
+      _("Apply a preset to an audio file or to a directory of them without PipeWire. Example: easyeffects --render "
+        "music input.wav output.wav"),
+      _("PRESET"));
+
+  const std::array<GOptionEntry, 2U> file_entries = {
+      {{G_OPTION_REMAINING, '\0', G_OPTION_FLAG_NONE, G_OPTION_ARG_FILENAME_ARRAY, nullptr, nullptr, nullptr}, {}}};
+
+  g_application_add_main_option_entries(G_APPLICATION(app), file_entries.data());
+
   return G_APPLICATION(app);
 }
 
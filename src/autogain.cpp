@@ -29,10 +29,12 @@
 #include <mutex>
 #include <span>
 #include <string>
+#include "dsp.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 AutoGain::AutoGain(const std::string& tag,
                    const std::string& schema,
@@ -80,7 +82,7 @@ AutoGain::AutoGain(const std::string& tag,
       settings, "changed::reset-history", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
         auto* self = static_cast<AutoGain*>(user_data);
 
-        self->mythreads.emplace_back([self]() {  // Using emplace_back here makes sense
+        WorkerPool::get().submit(self, [self](const WorkerPool::Task& /*task*/) {
           self->data_mutex.lock();
 
           self->ebur128_ready = false;
@@ -106,6 +108,8 @@ AutoGain::AutoGain(const std::string& tag,
       }),
       this));
 
+  quantum_independent = true;
+
   setup_input_output_gain();
 }
 
@@ -114,11 +118,7 @@ AutoGain::~AutoGain() {
     disconnect_from_pw();
   }
 
-  for (auto& t : mythreads) {
-    t.join();
-  }
-
-  mythreads.clear();
+  WorkerPool::get().cancel_all(this);
 
   std::scoped_lock<std::mutex> lock(data_mutex);
 
@@ -191,9 +191,9 @@ void AutoGain::set_maximum_history(const int& seconds) {
 }
 
 void AutoGain::setup() {
-  if (2U * static_cast<size_t>(n_samples) != data.size()) {
-    data.resize(static_cast<size_t>(n_samples) * 2U);
-  }
+  // Sized for the largest quantum. process() uses the size of the block it receives.
+
+  data.resize(2U * static_cast<size_t>(max_quantum));
 
   if (rate != old_rate) {
     data_mutex.lock();
@@ -202,7 +202,7 @@ void AutoGain::setup() {
 
     data_mutex.unlock();
 
-    mythreads.emplace_back([this]() {  // Using emplace_back here makes sense
+    WorkerPool::get().submit(this, [this](const WorkerPool::Task& /*task*/) {
       if (ebur128_ready) {
         return;
       }
@@ -239,12 +239,9 @@ void AutoGain::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  for (size_t n = 0U; n < n_samples; n++) {
-    data[2U * n] = left_in[n];
-    data[2U * n + 1U] = right_in[n];
-  }
+  dsp::interleave(left_in, right_in, data);
 
-  ebur128_add_frames_float(ebur_state, data.data(), n_samples);
+  ebur128_add_frames_float(ebur_state, data.data(), left_in.size());
 
   auto failed = false;
 
@@ -33,6 +33,7 @@
 #include <string>
 #include <vector>
 #include "autogain.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -103,7 +104,7 @@ void setup(AutogainBox* self, std::shared_ptr<AutoGain> autogain, const std::str
 
   self->data->autogain = autogain;
 
-  self->settings = g_settings_new_with_path(tags::schema::autogain::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::autogain::id, schema_path.c_str());
 
   autogain->set_post_messages(true);
 
@@ -38,6 +38,7 @@
 #include <string>
 #include <vector>
 #include "bass_enhancer.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -101,7 +102,7 @@ void setup(BassEnhancerBox* self, std::shared_ptr<BassEnhancer> bass_enhancer, c
 
   self->data->bass_enhancer = bass_enhancer;
 
-  self->settings = g_settings_new_with_path(tags::schema::bass_enhancer::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::bass_enhancer::id, schema_path.c_str());
 
   bass_enhancer->set_post_messages(true);
 
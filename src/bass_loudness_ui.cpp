@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "bass_loudness.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -85,7 +86,7 @@ void setup(BassLoudnessBox* self, std::shared_ptr<BassLoudness> bass_loudness, c
 
   self->data->bass_loudness = bass_loudness;
 
-  self->settings = g_settings_new_with_path(tags::schema::bass_loudness::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::bass_loudness::id, schema_path.c_str());
 
   bass_loudness->set_post_messages(true);
 
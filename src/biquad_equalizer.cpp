@@ -0,0 +1,418 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "biquad_equalizer.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Normalized so that a0 = 1
+
+struct Coefficients {
+  double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+};
+
+auto normalize(const double& b0,
+               const double& b1,
+               const double& b2,
+               const double& a0,
+               const double& a1,
+               const double& a2) -> Coefficients {
+  return {.b0 = b0 / a0, .b1 = b1 / a0, .b2 = b2 / a0, .a1 = a1 / a0, .a2 = a2 / a0};
+}
+
+/*
+  The second order sections follow the formulas of Robert Bristow-Johnson's Audio EQ Cookbook. They are the same
+  ones used by Equalizer APO.
+*/
+
+auto lowpass(const double& w0, const double& q) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto alpha = std::sin(w0) / (2.0 * q);
+
+  return normalize(0.5 * (1.0 - c), 1.0 - c, 0.5 * (1.0 - c), 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+auto highpass(const double& w0, const double& q) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto alpha = std::sin(w0) / (2.0 * q);
+
+  return normalize(0.5 * (1.0 + c), -(1.0 + c), 0.5 * (1.0 + c), 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+auto bandpass(const double& w0, const double& q) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto alpha = std::sin(w0) / (2.0 * q);
+
+  return normalize(alpha, 0.0, -alpha, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+auto notch(const double& w0, const double& q) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto alpha = std::sin(w0) / (2.0 * q);
+
+  return normalize(1.0, -2.0 * c, 1.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+auto allpass(const double& w0, const double& q) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto alpha = std::sin(w0) / (2.0 * q);
+
+  return normalize(1.0 - alpha, -2.0 * c, 1.0 + alpha, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+auto peaking(const double& w0, const double& q, const double& gain_db) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto alpha = std::sin(w0) / (2.0 * q);
+  const auto A = std::pow(10.0, gain_db / 40.0);
+
+  return normalize(1.0 + alpha * A, -2.0 * c, 1.0 - alpha * A, 1.0 + alpha / A, -2.0 * c, 1.0 - alpha / A);
+}
+
+auto lowshelf(const double& w0, const double& q, const double& gain_db) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto A = std::pow(10.0, gain_db / 40.0);
+  const auto sa = 2.0 * std::sqrt(A) * std::sin(w0) / (2.0 * q);
+
+  return normalize(A * ((A + 1.0) - (A - 1.0) * c + sa), 2.0 * A * ((A - 1.0) - (A + 1.0) * c),
+                   A * ((A + 1.0) - (A - 1.0) * c - sa), (A + 1.0) + (A - 1.0) * c + sa,
+                   -2.0 * ((A - 1.0) + (A + 1.0) * c), (A + 1.0) + (A - 1.0) * c - sa);
+}
+
+auto highshelf(const double& w0, const double& q, const double& gain_db) -> Coefficients {
+  const auto c = std::cos(w0);
+  const auto A = std::pow(10.0, gain_db / 40.0);
+  const auto sa = 2.0 * std::sqrt(A) * std::sin(w0) / (2.0 * q);
+
+  return normalize(A * ((A + 1.0) + (A - 1.0) * c + sa), -2.0 * A * ((A - 1.0) + (A + 1.0) * c),
+                   A * ((A + 1.0) + (A - 1.0) * c - sa), (A + 1.0) - (A - 1.0) * c + sa,
+                   2.0 * ((A - 1.0) - (A + 1.0) * c), (A + 1.0) - (A - 1.0) * c - sa);
+}
+
+auto first_order_pass(const double& w0, const bool& low) -> Coefficients {
+  const auto k = std::tan(0.5 * w0);
+
+  if (low) {
+    return {.b0 = k / (1.0 + k), .b1 = k / (1.0 + k), .b2 = 0.0, .a1 = (k - 1.0) / (k + 1.0), .a2 = 0.0};
+  }
+
+  return {.b0 = 1.0 / (1.0 + k), .b1 = -1.0 / (1.0 + k), .b2 = 0.0, .a1 = (k - 1.0) / (k + 1.0), .a2 = 0.0};
+}
+
+// Butterworth filter of the given order split in second order sections plus a first order one when the order is odd
+
+void butterworth(const double& w0, const uint& order, const bool& low, std::vector<Coefficients>& sections) {
+  for (uint k = 0U; k < order / 2U; k++) {
+    const auto q = 1.0 / (2.0 * std::sin(static_cast<double>(2U * k + 1U) * std::numbers::pi /
+                                         static_cast<double>(2U * order)));
+
+    sections.push_back(low ? lowpass(w0, q) : highpass(w0, q));
+  }
+
+  if (order % 2U != 0U) {
+    sections.push_back(first_order_pass(w0, low));
+  }
+}
+
+/*
+  The slope multiplies the order of the pass filters and splits the gain of the other types among the repeated
+  sections. The matched transform modes of the LSP equalizer are designed with the bilinear transform too.
+*/
+
+auto design_band(const BiquadEqualizer::Band& band, const uint& rate) -> std::vector<Coefficients> {
+  using BandType = BiquadEqualizer::BandType;
+  using BandMode = BiquadEqualizer::BandMode;
+
+  const auto omega = [&](const double& f) {
+    return 2.0 * std::numbers::pi * std::clamp(f, 1.0, 0.499 * static_cast<double>(rate)) /
+           static_cast<double>(rate);
+  };
+
+  const auto w0 = omega(band.frequency);
+  const auto q = std::max(band.q, 0.01);
+  const auto slope = std::clamp(band.slope, 1U, 4U);
+  const auto gain = band.gain / static_cast<double>(slope);
+
+  std::vector<Coefficients> sections;
+
+  const auto repeat = [&](const Coefficients& c) { sections.insert(sections.end(), slope, c); };
+
+  switch (band.type) {
+    case BandType::off:
+      break;
+    case BandType::bell:
+    case BandType::resonance:
+      repeat(peaking(w0, q, gain));
+      break;
+    case BandType::hi_shelf:
+      repeat(highshelf(w0, q, gain));
+      break;
+    case BandType::lo_shelf:
+      repeat(lowshelf(w0, q, gain));
+      break;
+    case BandType::notch:
+      repeat(notch(w0, q));
+      break;
+    case BandType::allpass:
+      repeat(allpass(w0, q));
+      break;
+    case BandType::bandpass:
+      repeat(bandpass(w0, q));
+      break;
+    case BandType::hi_pass:
+    case BandType::lo_pass: {
+      const bool low = band.type == BandType::lo_pass;
+
+      switch (band.mode) {
+        case BandMode::bwc_bt:
+        case BandMode::bwc_mt:
+          butterworth(w0, 2U * slope, low, sections);
+          break;
+        case BandMode::lrx_bt:
+        case BandMode::lrx_mt:
+          // Linkwitz-Riley: the square of a Butterworth filter with half the order
+
+          butterworth(w0, slope, low, sections);
+          butterworth(w0, slope, low, sections);
+          break;
+        default:
+          repeat(low ? lowpass(w0, q) : highpass(w0, q));
+          break;
+      }
+
+      break;
+    }
+    case BandType::ladder_pass:
+    case BandType::ladder_rej: {
+      // The band edges are placed width / 2 octaves away from the center frequency.
+
+      const auto ratio = std::exp2(0.5 * band.width);
+      const auto w_low = omega(band.frequency / ratio);
+      const auto w_high = omega(band.frequency * ratio);
+
+      for (uint n = 0U; n < slope; n++) {
+        if (band.type == BandType::ladder_pass) {
+          sections.push_back(highshelf(w_low, std::numbers::sqrt2 / 2.0, gain));
+          sections.push_back(highshelf(w_high, std::numbers::sqrt2 / 2.0, -gain));
+        } else {
+          sections.push_back(lowshelf(w_low, std::numbers::sqrt2 / 2.0, gain));
+          sections.push_back(highshelf(w_high, std::numbers::sqrt2 / 2.0, gain));
+        }
+      }
+
+      break;
+    }
+  }
+
+  return sections;
+}
+
+auto design_channel(const std::vector<BiquadEqualizer::Band>& bands, const uint& rate) -> std::vector<Coefficients> {
+  const bool has_solo = std::ranges::any_of(bands, [](const auto& b) { return b.solo && !b.mute; });
+
+  std::vector<Coefficients> sections;
+
+  for (const auto& band : bands) {
+    if (band.mute || (has_solo && !band.solo)) {
+      continue;
+    }
+
+    const auto band_sections = design_band(band, rate);
+
+    sections.insert(sections.end(), band_sections.begin(), band_sections.end());
+  }
+
+  return sections;
+}
+
+}  // namespace
+
+void BiquadEqualizer::set_rate(const uint& value) {
+  rate = value;
+
+  reset();
+
+  design();
+}
+
+void BiquadEqualizer::set_n_samples(const uint& value) {
+  buffer.resize(2U * static_cast<size_t>(value));
+}
+
+void BiquadEqualizer::set_bands(const std::vector<Band>& left, const std::vector<Band>& right) {
+  bands_left = left;
+  bands_right = right;
+
+  design();
+}
+
+void BiquadEqualizer::reset() {
+  std::ranges::fill(z1, Lanes{});
+  std::ranges::fill(z2, Lanes{});
+}
+
+auto BiquadEqualizer::get_rate() const -> uint {
+  return rate;
+}
+
+auto BiquadEqualizer::get_bands() const -> std::pair<std::vector<Band>, std::vector<Band>> {
+  return {bands_left, bands_right};
+}
+
+void BiquadEqualizer::swap_design(BiquadEqualizer& other) {
+  const auto n = std::min(z1.size(), other.z1.size());
+
+  std::copy_n(z1.begin(), n, other.z1.begin());
+  std::copy_n(z2.begin(), n, other.z2.begin());
+
+  bands_left.swap(other.bands_left);
+  bands_right.swap(other.bands_right);
+
+  b0.swap(other.b0);
+  b1.swap(other.b1);
+  b2.swap(other.b2);
+  a1.swap(other.a1);
+  a2.swap(other.a2);
+
+  z1.swap(other.z1);
+  z2.swap(other.z2);
+}
+
+void BiquadEqualizer::design() {
+  if (rate == 0U) {
+    return;
+  }
+
+  const auto left = design_channel(bands_left, rate);
+  const auto right = design_channel(bands_right, rate);
+
+  const auto n_sections = std::max(left.size(), right.size());
+
+  for (auto* v : {&b0, &b1, &b2, &a1, &a2}) {
+    v->resize(n_sections);
+  }
+
+  // The filter state of the sections that already existed is kept so that moving a band does not cause a click.
+
+  z1.resize(n_sections);
+  z2.resize(n_sections);
+
+  for (size_t s = 0U; s < n_sections; s++) {
+    const auto l = (s < left.size()) ? left[s] : Coefficients{};
+    const auto r = (s < right.size()) ? right[s] : Coefficients{};
+
+    b0[s] = {l.b0, r.b0};
+    b1[s] = {l.b1, r.b1};
+    b2[s] = {l.b2, r.b2};
+    a1[s] = {l.a1, r.a1};
+    a2[s] = {l.a2, r.a2};
+  }
+}
+
+void BiquadEqualizer::process(std::span<float>& left_in,
+                              std::span<float>& right_in,
+                              std::span<float>& left_out,
+                              std::span<float>& right_out) {
+  const auto chunk = buffer.size() / 2U;
+
+  if (b0.empty() || chunk == 0U) {
+    std::copy(left_in.begin(), left_in.end(), left_out.begin());
+    std::copy(right_in.begin(), right_in.end(), right_out.begin());
+
+    return;
+  }
+
+  for (size_t offset = 0U; offset < left_in.size(); offset += chunk) {
+    const auto count = std::min(chunk, left_in.size() - offset);
+
+    for (size_t n = 0U; n < count; n++) {
+      buffer[2U * n] = left_in[offset + n];
+      buffer[2U * n + 1U] = right_in[offset + n];
+    }
+
+    /*
+      Transposed direct form II. The inner loop over the two channels has no dependencies between its iterations and
+      is turned into packed operations by the compiler.
+    */
+
+    for (size_t s = 0U; s < b0.size(); s++) {
+      const auto c_b0 = b0[s];
+      const auto c_b1 = b1[s];
+      const auto c_b2 = b2[s];
+      const auto c_a1 = a1[s];
+      const auto c_a2 = a2[s];
+
+      auto s1 = z1[s];
+      auto s2 = z2[s];
+
+      for (size_t n = 0U; n < count; n++) {
+        for (size_t c = 0U; c < 2U; c++) {
+          const auto x = buffer[2U * n + c];
+          const auto y = c_b0[c] * x + s1[c];
+
+          s1[c] = c_b1[c] * x - c_a1[c] * y + s2[c];
+          s2[c] = c_b2[c] * x - c_a2[c] * y;
+
+          buffer[2U * n + c] = y;
+        }
+      }
+
+      z1[s] = s1;
+      z2[s] = s2;
+    }
+
+    for (size_t n = 0U; n < count; n++) {
+      left_out[offset + n] = static_cast<float>(buffer[2U * n]);
+      right_out[offset + n] = static_cast<float>(buffer[2U * n + 1U]);
+    }
+  }
+}
+
+auto BiquadEqualizer::get_response(const std::vector<double>& frequencies, const uint& channel) const
+    -> std::vector<double> {
+  std::vector<double> output(frequencies.size(), 0.0);
+
+  if (rate == 0U || channel > 1U) {
+    return output;
+  }
+
+  for (size_t k = 0U; k < frequencies.size(); k++) {
+    const auto w = 2.0 * std::numbers::pi * frequencies[k] / static_cast<double>(rate);
+
+    const auto z_1 = std::polar(1.0, -w);
+    const auto z_2 = std::polar(1.0, -2.0 * w);
+
+    for (size_t s = 0U; s < b0.size(); s++) {
+      const auto num = b0[s][channel] + b1[s][channel] * z_1 + b2[s][channel] * z_2;
+      const auto den = 1.0 + a1[s][channel] * z_1 + a2[s][channel] * z_2;
+
+      output[k] += 20.0 * std::log10(std::max(std::abs(num) / std::abs(den), 1e-12));
+    }
+  }
+
+  return output;
+}
@@ -67,6 +67,24 @@ struct Data {
   std::string x_unit, y_unit;
 
   std::vector<double> y_axis, x_axis, x_axis_log, objects_x;
+
+  /*
+    The axis labels and the horizontal position of the points only change with the size of the widget and with the
+    settings of the x axis. They are kept between frames and only the data series is regenerated when new y values
+    arrive.
+  */
+
+  bool static_dirty = true;
+
+  int static_width = 0, static_height = 0;
+
+  GskRenderNode* labels_node = nullptr;
+
+  // First point of each pixel column. Points sharing a column are merged before being drawn.
+
+  std::vector<size_t> column_first;
+
+  std::vector<double> series_x, series_y;
 };
 
 struct _Chart {
@@ -94,6 +112,7 @@ void set_chart_scale(Chart* self, const ChartScale& value) {
   }
 
   self->data->chart_scale = value;
+  self->data->static_dirty = true;
 }
 
 void set_background_color(Chart* self, GdkRGBA color) {
@@ -118,6 +137,7 @@ void set_axis_labels_color(Chart* self, GdkRGBA color) {
   }
 
   self->data->color_axis_labels = color;
+  self->data->static_dirty = true;
 }
 
 void set_line_width(Chart* self, const float& value) {
@@ -126,6 +146,7 @@ void set_line_width(Chart* self, const float& value) {
   }
 
   self->data->line_width = value;
+  self->data->static_dirty = true;
 }
 
 void set_draw_bar_border(Chart* self, const bool& v) {
@@ -158,6 +179,7 @@ void set_n_x_decimals(Chart* self, const int& v) {
   }
 
   self->data->n_x_decimals = v;
+  self->data->static_dirty = true;
 }
 
 void set_n_y_decimals(Chart* self, const int& v) {
@@ -174,6 +196,7 @@ void set_x_unit(Chart* self, const std::string& value) {
   }
 
   self->data->x_unit = value;
+  self->data->static_dirty = true;
 }
 
 void set_y_unit(Chart* self, const std::string& value) {
@@ -190,6 +213,7 @@ void set_margin(Chart* self, const float& v) {
   }
 
   self->data->margin = v;
+  self->data->static_dirty = true;
 }
 
 auto get_is_visible(Chart* self) -> bool {
@@ -247,6 +271,8 @@ void set_x_data(Chart* self, const std::vector<double>& x) {
   std::ranges::for_each(self->data->x_axis_log, [&](auto& v) {
     v = (v - self->data->x_min_log) / (self->data->x_max_log - self->data->x_min_log);
   });
+
+  self->data->static_dirty = true;
 }
 
 void set_y_data(Chart* self, const std::vector<double>& y) {
@@ -254,6 +280,12 @@ void set_y_data(Chart* self, const std::vector<double>& y) {
     return;
   }
 
+  // The columns of the static data are built for the number of points.
+
+  if (y.size() != self->data->y_axis.size()) {
+    self->data->static_dirty = true;
+  }
+
   self->data->y_axis = y;
 
   auto min_y = std::ranges::min(y);
@@ -422,6 +454,80 @@ auto draw_x_labels(Chart* self, GtkSnapshot* snapshot, const int& width, const i
   return 0;
 }
 
+void update_static_data(Chart* self, const int& width, const int& height) {
+  const double usable_width = width - 2.0 * (self->data->line_width + self->data->margin * width);
+
+  const auto& x_axis =
+      (self->data->chart_scale == ChartScale::logarithmic) ? self->data->x_axis_log : self->data->x_axis;
+
+  // The y data may arrive before the x data of a new size.
+
+  const auto n_points = std::min({self->data->y_axis.size(), x_axis.size(), self->data->objects_x.size()});
+
+  for (size_t n = 0U; n < n_points; n++) {
+    self->data->objects_x[n] = usable_width * x_axis[n] + self->data->line_width + self->data->margin * width;
+  }
+
+  self->data->column_first.clear();
+
+  for (size_t n = 0U; n < n_points; n++) {
+    if (n == 0U || std::floor(self->data->objects_x[n]) != std::floor(self->data->objects_x[n - 1U])) {
+      self->data->column_first.push_back(n);
+    }
+  }
+
+  self->data->column_first.push_back(n_points);
+
+  auto* labels_snapshot = gtk_snapshot_new();
+
+  self->data->x_axis_height = draw_x_labels(self, labels_snapshot, width, height);
+
+  if (self->data->labels_node != nullptr) {
+    gsk_render_node_unref(self->data->labels_node);
+  }
+
+  self->data->labels_node = gtk_snapshot_free_to_node(labels_snapshot);
+
+  self->data->static_width = width;
+  self->data->static_height = height;
+
+  self->data->static_dirty = false;
+}
+
+/*
+  Charts may have more points than pixels. Bars and dots show the largest value of their column. Lines go through the
+  smallest and the largest values of the column so that narrow peaks and notches are kept.
+*/
+
+void update_series(Chart* self) {
+  const auto& columns = self->data->column_first;
+
+  const auto& y = self->data->y_axis;
+
+  self->data->series_x.clear();
+  self->data->series_y.clear();
+
+  for (size_t k = 0U; k + 1U < columns.size(); k++) {
+    const auto first = y.begin() + static_cast<std::ptrdiff_t>(columns[k]);
+    const auto last = y.begin() + static_cast<std::ptrdiff_t>(columns[k + 1U]);
+
+    const auto x = self->data->objects_x[columns[k]];
+
+    const auto [min_it, max_it] = std::minmax_element(first, last);
+
+    if (self->data->chart_type == ChartType::line && min_it != max_it) {
+      self->data->series_x.push_back(x);
+      self->data->series_x.push_back(x);
+
+      self->data->series_y.push_back((min_it < max_it) ? *min_it : *max_it);
+      self->data->series_y.push_back((min_it < max_it) ? *max_it : *min_it);
+    } else {
+      self->data->series_x.push_back(x);
+      self->data->series_y.push_back(*max_it);
+    }
+  }
+}
+
 void snapshot(GtkWidget* widget, GtkSnapshot* snapshot) {
   auto* self = EE_CHART(widget);
 
@@ -449,31 +555,20 @@ void snapshot(GtkWidget* widget, GtkSnapshot* snapshot) {
 
   gtk_snapshot_append_color(snapshot, &self->data->background_color, &widget_rectangle);
 
-  if (const auto n_points = self->data->y_axis.size(); n_points > 0) {
-    double usable_width = width - 2.0 * (self->data->line_width + self->data->margin * width);
-
-    auto usable_height = (height - self->data->margin * height) - self->data->x_axis_height;
+  if (!self->data->y_axis.empty()) {
+    if (self->data->static_dirty || width != self->data->static_width || height != self->data->static_height) {
+      update_static_data(self, width, height);
+    }
 
-    switch (self->data->chart_scale) {
-      case ChartScale::logarithmic: {
-        for (size_t n = 0U; n < n_points; n++) {
-          self->data->objects_x[n] =
-              usable_width * self->data->x_axis_log[n] + self->data->line_width + self->data->margin * width;
-        }
+    if (self->data->labels_node != nullptr) {
+      gtk_snapshot_append_node(snapshot, self->data->labels_node);
+    }
 
-        break;
-      }
-      case ChartScale::linear: {
-        for (size_t n = 0U; n < n_points; n++) {
-          self->data->objects_x[n] =
-              usable_width * self->data->x_axis[n] + self->data->line_width + self->data->margin * width;
-        }
+    auto usable_height = (height - self->data->margin * height) - self->data->x_axis_height;
 
-        break;
-      }
-    }
+    update_series(self);
 
-    self->data->x_axis_height = draw_x_labels(self, snapshot, width, height);
+    const auto n_objects = self->data->series_y.size();
 
     auto border_color = std::to_array({self->data->color, self->data->color, self->data->color, self->data->color});
 
@@ -485,12 +580,12 @@ void snapshot(GtkWidget* widget, GtkSnapshot* snapshot) {
 
     switch (self->data->chart_type) {
       case ChartType::bar: {
-        double dw = width / static_cast<double>(n_points);
+        double dw = width / static_cast<double>(n_objects);
 
-        for (uint n = 0U; n < n_points; n++) {
-          double bar_height = usable_height * self->data->y_axis[n];
+        for (uint n = 0U; n < n_objects; n++) {
+          double bar_height = usable_height * self->data->series_y[n];
 
-          double rect_x = self->data->objects_x[n];
+          double rect_x = self->data->series_x[n];
           double rect_y = self->data->margin * height + usable_height - bar_height;
           double rect_height = bar_height;
           double rect_width = dw;
@@ -520,14 +615,14 @@ void snapshot(GtkWidget* widget, GtkSnapshot* snapshot) {
         break;
       }
       case ChartType::dots: {
-        double dw = width / static_cast<double>(n_points);
+        double dw = width / static_cast<double>(n_objects);
 
         usable_height -= radius;  // this avoids the dots being drawn over the axis label
 
-        for (uint n = 0U; n < n_points; n++) {
-          double dot_y = usable_height * self->data->y_axis[n];
+        for (uint n = 0U; n < n_objects; n++) {
+          double dot_y = usable_height * self->data->series_y[n];
 
-          double rect_x = self->data->objects_x[n];
+          double rect_x = self->data->series_x[n];
           double rect_y = self->data->margin * height + radius + usable_height - dot_y;
           double rect_width = dw;
 
@@ -565,22 +660,22 @@ void snapshot(GtkWidget* widget, GtkSnapshot* snapshot) {
         if (self->data->fill_bars) {
           cairo_move_to(ctx, self->data->margin * width, self->data->margin * height + usable_height);
         } else {
-          const auto point_height = self->data->y_axis.front() * usable_height;
+          const auto point_height = self->data->series_y.front() * usable_height;
 
-          cairo_move_to(ctx, self->data->objects_x.front(), self->data->margin * height + usable_height - point_height);
+          cairo_move_to(ctx, self->data->series_x.front(), self->data->margin * height + usable_height - point_height);
         }
 
-        for (uint n = 0U; n < n_points - 1U; n++) {
-          const auto next_point_height = self->data->y_axis[n + 1U] * usable_height;
+        for (uint n = 0U; n < n_objects - 1U; n++) {
+          const auto next_point_height = self->data->series_y[n + 1U] * usable_height;
 
-          cairo_line_to(ctx, self->data->objects_x[n + 1U],
+          cairo_line_to(ctx, self->data->series_x[n + 1U],
                         self->data->margin * height + usable_height - next_point_height);
         }
 
         if (self->data->fill_bars) {
-          cairo_line_to(ctx, self->data->objects_x.back(), self->data->margin * height + usable_height);
+          cairo_line_to(ctx, self->data->series_x.back(), self->data->margin * height + usable_height);
 
-          cairo_move_to(ctx, self->data->objects_x.back(), self->data->margin * height + usable_height);
+          cairo_move_to(ctx, self->data->series_x.back(), self->data->margin * height + usable_height);
 
           cairo_close_path(ctx);
         }
@@ -643,6 +738,10 @@ void unroot(GtkWidget* widget) {
 void finalize(GObject* object) {
   auto* self = EE_CHART(object);
 
+  if (self->data->labels_node != nullptr) {
+    gsk_render_node_unref(self->data->labels_node);
+  }
+
   delete self->data;
 
   self->data = nullptr;
@@ -50,6 +50,8 @@ Compressor::Compressor(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_independent = true;
+
   if (!package_installed) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/sc_compressor_stereo is not installed");
   }
@@ -182,6 +184,8 @@ void Compressor::process(std::span<float>& left_in,
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -37,6 +37,7 @@
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -165,7 +166,7 @@ void setup(CompressorBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::compressor::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::compressor::id, schema_path.c_str());
 
   compressor->set_post_messages(true);
 
@@ -0,0 +1,601 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "control_api.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <sigc++/connection.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "effects_base.hpp"
+#include "plugin_base.hpp"
+#include "settings_store.hpp"
+#include "tags_app.hpp"
+#include "tags_plugin_name.hpp"
+#include "tags_schema.hpp"
+#include "util.hpp"
+
+namespace {
+
+using namespace std::string_literals;
+
+constexpr auto interface_name = "com.github.wwmm.easyeffects.Control";
+
+constexpr auto introspection_xml = R"xml(
+<node>
+  <interface name="com.github.wwmm.easyeffects.Control">
+    <method name="ListChains">
+      <arg type="as" name="chains" direction="out"/>
+    </method>
+    <method name="ListEffects">
+      <arg type="s" name="chain" direction="in"/>
+      <arg type="as" name="effects" direction="out"/>
+    </method>
+    <method name="ListParameters">
+      <arg type="s" name="chain" direction="in"/>
+      <arg type="s" name="effect" direction="in"/>
+      <arg type="a(ss)" name="parameters" direction="out"/>
+    </method>
+    <method name="GetParameters">
+      <arg type="s" name="chain" direction="in"/>
+      <arg type="s" name="effect" direction="in"/>
+      <arg type="as" name="keys" direction="in"/>
+      <arg type="a{sv}" name="values" direction="out"/>
+    </method>
+    <method name="SetParameters">
+      <arg type="a(sssv)" name="changes" direction="in"/>
+    </method>
+    <method name="SubscribeMeters">
+      <arg type="s" name="chain" direction="in"/>
+      <arg type="s" name="effect" direction="in"/>
+      <arg type="u" name="rate" direction="in"/>
+    </method>
+    <method name="UnsubscribeMeters">
+      <arg type="s" name="chain" direction="in"/>
+      <arg type="s" name="effect" direction="in"/>
+    </method>
+    <signal name="Meters">
+      <arg type="s" name="chain"/>
+      <arg type="s" name="effect"/>
+      <arg type="d" name="input_left"/>
+      <arg type="d" name="input_right"/>
+      <arg type="d" name="output_left"/>
+      <arg type="d" name="output_right"/>
+    </signal>
+  </interface>
+</node>
+)xml";
+
+}  // namespace
+
+ControlApi::ControlApi(GDBusConnection* connection,
+                       const std::string& application_path,
+                       EffectsBase* sie,
+                       EffectsBase* soe)
+    : connection(G_DBUS_CONNECTION(g_object_ref(connection))),
+      object_path(application_path + "/Control"),
+      sie(sie),
+      soe(soe) {
+  static const GDBusInterfaceVTable vtable = {on_method_call, nullptr, nullptr, {}};
+
+  GError* error = nullptr;
+
+  auto* node_info = g_dbus_node_info_new_for_xml(introspection_xml, nullptr);
+
+  registration_id = g_dbus_connection_register_object(connection, object_path.c_str(), node_info->interfaces[0],
+                                                      &vtable, this, nullptr, &error);
+
+  if (registration_id == 0U) {
+    util::warning("could not export the control interface: "s + error->message);
+
+    g_error_free(error);
+  } else {
+    util::debug("control interface exported at " + object_path);
+  }
+
+  g_dbus_node_info_unref(node_info);
+}
+
+ControlApi::~ControlApi() {
+  std::vector<SubscriptionKey> keys;
+
+  for (const auto& key : subscriptions | std::views::keys) {
+    keys.push_back(key);
+  }
+
+  for (const auto& key : keys) {
+    unsubscribe(key);
+  }
+
+  for (const auto& watcher_id : name_watchers | std::views::values) {
+    g_bus_unwatch_name(watcher_id);
+  }
+
+  if (registration_id != 0U) {
+    g_dbus_connection_unregister_object(connection, registration_id);
+  }
+
+  g_object_unref(connection);
+
+  util::debug("destroyed");
+}
+
+void ControlApi::on_method_call(GDBusConnection* connection,
+                                const gchar* sender,
+                                const gchar* object_path,
+                                const gchar* interface_name,
+                                const gchar* method_name,
+                                GVariant* parameters,
+                                GDBusMethodInvocation* invocation,
+                                gpointer user_data) {
+  auto* self = static_cast<ControlApi*>(user_data);
+
+  const std::string method = method_name;
+
+  std::string error;
+
+  GVariant* result = nullptr;
+
+  if (method == "ListChains") {
+    const std::array<const gchar*, 3U> chains = {"input", "output", nullptr};
+
+    result = g_variant_new("(^as)", chains.data());
+  } else if (method == "ListEffects") {
+    const gchar* chain = nullptr;
+
+    g_variant_get(parameters, "(&s)", &chain);
+
+    if (self->get_effects(chain) != nullptr) {
+      auto* settings = g_settings_new((g_strcmp0(chain, "input") == 0) ? tags::schema::id_input
+                                                                       : tags::schema::id_output);
+
+      auto** effects = g_settings_get_strv(settings, "plugins");
+
+      result = g_variant_new("(^as)", effects);
+
+      g_strfreev(effects);
+
+      g_object_unref(settings);
+    } else {
+      error = "unknown chain: "s + chain;
+    }
+  } else if (method == "ListParameters") {
+    const gchar *chain = nullptr, *effect = nullptr;
+
+    g_variant_get(parameters, "(&s&s)", &chain, &effect);
+
+    result = self->list_parameters(chain, effect, error);
+  } else if (method == "GetParameters") {
+    const gchar *chain = nullptr, *effect = nullptr;
+
+    GVariant* keys = nullptr;
+
+    g_variant_get(parameters, "(&s&s@as)", &chain, &effect, &keys);
+
+    result = self->get_parameters(chain, effect, keys, error);
+
+    g_variant_unref(keys);
+  } else if (method == "SetParameters") {
+    GVariant* changes = nullptr;
+
+    g_variant_get(parameters, "(@a(sssv))", &changes);
+
+    self->set_parameters(changes, error);
+
+    g_variant_unref(changes);
+  } else if (method == "SubscribeMeters") {
+    const gchar *chain = nullptr, *effect = nullptr;
+
+    guint rate = 0U;
+
+    g_variant_get(parameters, "(&s&su)", &chain, &effect, &rate);
+
+    error = self->subscribe(sender, chain, effect, rate);
+  } else if (method == "UnsubscribeMeters") {
+    const gchar *chain = nullptr, *effect = nullptr;
+
+    g_variant_get(parameters, "(&s&s)", &chain, &effect);
+
+    self->unsubscribe({sender, chain, effect});
+  }
+
+  if (!error.empty()) {
+    g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, error.c_str());
+
+    return;
+  }
+
+  g_dbus_method_invocation_return_value(invocation, result);
+}
+
+auto ControlApi::get_effects(const std::string& chain) const -> EffectsBase* {
+  if (chain == "input") {
+    return sie;
+  }
+
+  if (chain == "output") {
+    return soe;
+  }
+
+  return nullptr;
+}
+
+auto ControlApi::get_settings(const std::string& chain, const std::string& effect, std::string& error) const
+    -> GSettings* {
+  auto* effects = get_effects(chain);
+
+  if (effects == nullptr) {
+    error = "unknown chain: " + chain;
+
+    return nullptr;
+  }
+
+  const auto separator = effect.find('/');
+
+  const auto name = effect.substr(0U, separator);
+
+  const auto channel = (separator == std::string::npos) ? "" : effect.substr(separator + 1U);
+
+  if (!effects->get_plugins_map().contains(name)) {
+    error = "unknown effect: " + name;
+
+    return nullptr;
+  }
+
+  auto gname = tags::plugin_name::get_base_name(name);
+
+  gname.erase(std::remove(gname.begin(), gname.end(), '_'), gname.end());
+
+  auto schema_id = tags::app::id + "."s + gname;
+
+  auto path = ((chain == "input") ? tags::app::path_stream_inputs : tags::app::path_stream_outputs) + gname + "/" +
+              util::to_string(tags::plugin_name::get_id(name)) + "/";
+
+  if (!channel.empty()) {
+    if (!name.starts_with(tags::plugin_name::equalizer) || (channel != "leftchannel" && channel != "rightchannel")) {
+      error = "unknown effect: " + effect;
+
+      return nullptr;
+    }
+
+    schema_id = tags::schema::equalizer::channel_id;
+
+    path += channel + "/";
+  }
+
+  return settings_store::get(schema_id.c_str(), path.c_str());
+}
+
+auto ControlApi::list_parameters(const std::string& chain, const std::string& effect, std::string& error) const
+    -> GVariant* {
+  auto* settings = get_settings(chain, effect, error);
+
+  if (settings == nullptr) {
+    return nullptr;
+  }
+
+  GSettingsSchema* schema = nullptr;
+
+  g_object_get(settings, "settings-schema", &schema, nullptr);
+
+  auto** keys = g_settings_schema_list_keys(schema);
+
+  GVariantBuilder builder;
+
+  g_variant_builder_init(&builder, G_VARIANT_TYPE("a(ss)"));
+
+  for (int n = 0; keys[n] != nullptr; n++) {
+    auto* schema_key = g_settings_schema_get_key(schema, keys[n]);
+
+    auto* type = g_variant_type_dup_string(g_settings_schema_key_get_value_type(schema_key));
+
+    g_variant_builder_add(&builder, "(ss)", keys[n], type);
+
+    g_free(type);
+
+    g_settings_schema_key_unref(schema_key);
+  }
+
+  g_strfreev(keys);
+
+  g_settings_schema_unref(schema);
+
+  g_object_unref(settings);
+
+  return g_variant_new("(a(ss))", &builder);
+}
+
+auto ControlApi::get_parameters(const std::string& chain,
+                                const std::string& effect,
+                                GVariant* keys,
+                                std::string& error) const -> GVariant* {
+  auto* settings = get_settings(chain, effect, error);
+
+  if (settings == nullptr) {
+    return nullptr;
+  }
+
+  GSettingsSchema* schema = nullptr;
+
+  g_object_get(settings, "settings-schema", &schema, nullptr);
+
+  // No keys means all of them.
+
+  auto** names =
+      (g_variant_n_children(keys) == 0U) ? g_settings_schema_list_keys(schema) : g_variant_dup_strv(keys, nullptr);
+
+  GVariantBuilder builder;
+
+  g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+
+  for (int n = 0; names[n] != nullptr && error.empty(); n++) {
+    if (g_settings_schema_has_key(schema, names[n]) == 0) {
+      error = "unknown parameter: "s + names[n];
+
+      break;
+    }
+
+    auto* value = g_settings_get_value(settings, names[n]);
+
+    g_variant_builder_add(&builder, "{sv}", names[n], value);
+
+    g_variant_unref(value);
+  }
+
+  g_strfreev(names);
+
+  g_settings_schema_unref(schema);
+
+  g_object_unref(settings);
+
+  if (!error.empty()) {
+    g_variant_builder_clear(&builder);
+
+    return nullptr;
+  }
+
+  return g_variant_new("(a{sv})", &builder);
+}
+
+auto ControlApi::set_parameters(GVariant* changes, std::string& error) const -> bool {
+  struct Change {
+    GSettings* settings = nullptr;
+
+    std::string key;
+
+    GVariant* value = nullptr;
+  };
+
+  std::map<std::pair<std::string, std::string>, GSettings*> settings_map;
+
+  std::vector<Change> list;
+
+  GVariantIter iter;
+
+  g_variant_iter_init(&iter, changes);
+
+  const gchar *chain = nullptr, *effect = nullptr, *key = nullptr;
+
+  GVariant* value = nullptr;
+
+  // Nothing is written unless every change of the batch is valid.
+
+  while (error.empty() && g_variant_iter_next(&iter, "(&s&s&sv)", &chain, &effect, &key, &value)) {
+    auto [it, inserted] = settings_map.try_emplace({chain, effect}, nullptr);
+
+    if (inserted) {
+      it->second = get_settings(chain, effect, error);
+    }
+
+    list.push_back({.settings = it->second, .key = key, .value = value});
+
+    if (it->second == nullptr) {
+      break;
+    }
+
+    GSettingsSchema* schema = nullptr;
+
+    g_object_get(it->second, "settings-schema", &schema, nullptr);
+
+    if (g_settings_schema_has_key(schema, key) == 0) {
+      error = "unknown parameter: "s + chain + " " + effect + " " + key;
+    } else {
+      auto* schema_key = g_settings_schema_get_key(schema, key);
+
+      if (g_variant_is_of_type(value, g_settings_schema_key_get_value_type(schema_key)) == 0 ||
+          g_settings_schema_key_range_check(schema_key, value) == 0) {
+        error = "invalid value for "s + chain + " " + effect + " " + key;
+      }
+
+      g_settings_schema_key_unref(schema_key);
+    }
+
+    g_settings_schema_unref(schema);
+  }
+
+  if (error.empty()) {
+    for (const auto& change : list) {
+      g_settings_set_value(change.settings, change.key.c_str(), change.value);
+    }
+  }
+
+  for (const auto& change : list) {
+    g_variant_unref(change.value);
+  }
+
+  for (auto* settings : settings_map | std::views::values) {
+    if (settings != nullptr) {
+      g_object_unref(settings);
+    }
+  }
+
+  return error.empty();
+}
+
+auto ControlApi::subscribe(const std::string& sender,
+                           const std::string& chain,
+                           const std::string& effect,
+                           const uint& rate) -> std::string {
+  auto* effects = get_effects(chain);
+
+  if (effects == nullptr) {
+    return "unknown chain: " + chain;
+  }
+
+  const auto plugins = effects->get_plugins_map();
+
+  const auto it = plugins.find(effect);
+
+  if (it == plugins.end()) {
+    return "unknown effect: " + effect;
+  }
+
+  if (rate == 0U || rate > max_meter_rate) {
+    return "the rate has to be between 1 and " + util::to_string(max_meter_rate) + " Hz";
+  }
+
+  // Subscribing again changes the rate.
+
+  unsubscribe({sender, chain, effect});
+
+  auto subscription = std::make_unique<Subscription>();
+
+  subscription->api = this;
+  subscription->key = {sender, chain, effect};
+  subscription->plugin = it->second;
+  subscription->levels = std::make_shared<Levels>();
+
+  for (auto* level : {&subscription->levels->input_left, &subscription->levels->input_right,
+                      &subscription->levels->output_left, &subscription->levels->output_right}) {
+    level->store(util::minimum_db_level, std::memory_order_relaxed);
+  }
+
+  // The plugin emits these signals from the realtime thread.
+
+  subscription->connections.push_back(
+      it->second->input_level.connect([levels = subscription->levels](const float left, const float right) {
+        levels->input_left.store(left, std::memory_order_relaxed);
+        levels->input_right.store(right, std::memory_order_relaxed);
+      }));
+
+  subscription->connections.push_back(
+      it->second->output_level.connect([levels = subscription->levels](const float left, const float right) {
+        levels->output_left.store(left, std::memory_order_relaxed);
+        levels->output_right.store(right, std::memory_order_relaxed);
+      }));
+
+  it->second->add_meter_subscriber();
+
+  subscription->source_id = g_timeout_add(1000U / rate, GSourceFunc(+[](Subscription* subscription) {
+                                            // The effect was removed from the pipeline.
+
+                                            if (subscription->plugin.expired()) {
+                                              subscription->source_id = 0U;
+
+                                              subscription->api->unsubscribe(SubscriptionKey(subscription->key));
+
+                                              return G_SOURCE_REMOVE;
+                                            }
+
+                                            subscription->api->emit_levels(subscription);
+
+                                            return G_SOURCE_CONTINUE;
+                                          }),
+                                          subscription.get());
+
+  if (!name_watchers.contains(sender)) {
+    name_watchers[sender] = g_bus_watch_name_on_connection(
+        connection, sender.c_str(), G_BUS_NAME_WATCHER_FLAGS_NONE, nullptr,
+        +[](GDBusConnection* connection, const gchar* name, gpointer user_data) {
+          auto* self = static_cast<ControlApi*>(user_data);
+
+          std::vector<SubscriptionKey> keys;
+
+          for (const auto& key : self->subscriptions | std::views::keys) {
+            if (std::get<0>(key) == name) {
+              keys.push_back(key);
+            }
+          }
+
+          for (const auto& key : keys) {
+            self->unsubscribe(key);
+          }
+
+          if (auto watcher = self->name_watchers.find(name); watcher != self->name_watchers.end()) {
+            g_bus_unwatch_name(watcher->second);
+
+            self->name_watchers.erase(watcher);
+          }
+        },
+        this, nullptr);
+  }
+
+  subscriptions[subscription->key] = std::move(subscription);
+
+  return "";
+}
+
+void ControlApi::unsubscribe(const SubscriptionKey& key) {
+  auto it = subscriptions.find(key);
+
+  if (it == subscriptions.end()) {
+    return;
+  }
+
+  auto& subscription = it->second;
+
+  if (subscription->source_id != 0U) {
+    g_source_remove(subscription->source_id);
+  }
+
+  if (auto plugin = subscription->plugin.lock(); plugin != nullptr) {
+    plugin->remove_meter_subscriber();
+  }
+
+  for (auto& c : subscription->connections) {
+    c.disconnect();
+  }
+
+  subscriptions.erase(it);
+}
+
+void ControlApi::emit_levels(Subscription* subscription) {
+  const auto& [sender, chain, effect] = subscription->key;
+
+  const auto& levels = *subscription->levels;
+
+  g_dbus_connection_emit_signal(connection, sender.c_str(), object_path.c_str(), interface_name, "Meters",
+                                g_variant_new("(ssdddd)", chain.c_str(), effect.c_str(),
+                                              static_cast<double>(levels.input_left.load(std::memory_order_relaxed)),
+                                              static_cast<double>(levels.input_right.load(std::memory_order_relaxed)),
+                                              static_cast<double>(levels.output_left.load(std::memory_order_relaxed)),
+                                              static_cast<double>(levels.output_right.load(std::memory_order_relaxed))),
+                                nullptr);
+}
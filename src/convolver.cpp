@@ -25,6 +25,7 @@
 #include <sys/types.h>
 #include <zita-convolver.h>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <memory>
@@ -32,13 +33,18 @@
 #include <sndfile.hh>
 #include <span>
 #include <string>
+#include <utility>
 #include <vector>
+#include "convolver_ui_common.hpp"
+#include "fftw_planner.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "resampler.hpp"
+#include "resource_catalog.hpp"
 #include "tags_plugin_name.hpp"
 #include "tags_resources.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 namespace {
 
@@ -46,6 +52,10 @@ constexpr auto CONVPROC_SCHEDULER_PRIORITY = 0;
 
 constexpr auto CONVPROC_SCHEDULER_CLASS = SCHED_FIFO;
 
+constexpr auto BAKE_LENGTH_SECONDS = 2.0F;  // long enough for the maximum time of the Delay effect
+
+constexpr auto BAKE_DEBOUNCE_MS = 250U;
+
 }  // namespace
 
 Convolver::Convolver(const std::string& tag,
@@ -61,6 +71,7 @@ Convolver::Convolver(const std::string& tag,
                  pipe_manager,
                  pipe_type),
       do_autogain(g_settings_get_boolean(settings, "autogain") != 0),
+      bake_linear_section(g_settings_get_boolean(settings, "bake-linear-section") != 0),
       ir_width(g_settings_get_int(settings, "ir-width")) {
   // Initialize directories for local and community irs
   local_dir_irs = std::string{g_get_user_config_dir()} + "/easyeffects/irs";
@@ -85,14 +96,8 @@ Convolver::Convolver(const std::string& tag,
 
                                             self->ir_width = g_settings_get_int(self->settings, key);
 
-                                            std::scoped_lock<std::mutex> lock(self->data_mutex);
-
                                             if (self->kernel_is_initialized) {
-                                              self->kernel_L = self->original_kernel_L;
-                                              self->kernel_R = self->original_kernel_R;
-
-                                              self->set_kernel_stereo_width();
-                                              self->apply_kernel_autogain();
+                                              self->rebuild_kernel();
                                             }
                                           }),
                                           this));
@@ -115,6 +120,20 @@ Convolver::Convolver(const std::string& tag,
                                           }),
                                           this));
 
+  gconnections.push_back(g_signal_connect(settings, "changed::bake-linear-section",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<Convolver*>(user_data);
+
+                                            self->bake_linear_section = g_settings_get_boolean(settings, key) != 0;
+
+                                            self->section_changed.emit();
+                                          }),
+                                          this));
+
+  // Zita keeps the partition size chosen in setup(). Blocks of any other size go through the deques in process().
+
+  quantum_independent = true;
+
   setup_input_output_gain();
 }
 
@@ -123,11 +142,19 @@ Convolver::~Convolver() {
     disconnect_from_pw();
   }
 
-  for (auto& t : mythreads) {
-    t.join();
+  if (bake_source_id != 0U) {
+    g_source_remove(bake_source_id);
+  }
+
+  for (auto& c : section_connections) {
+    c.disconnect();
   }
 
-  mythreads.clear();
+  bake_serial++;
+
+  WorkerPool::get().cancel_all(&bake_serial);
+
+  WorkerPool::get().cancel_all(this);
 
   std::scoped_lock<std::mutex> lock(data_mutex);
 
@@ -136,6 +163,8 @@ Convolver::~Convolver() {
   if (conv != nullptr) {
     conv->stop_process();
 
+    std::scoped_lock<std::mutex> fftw_lock(fftw_planner::mutex);
+
     conv->cleanup();
 
     delete conv;
@@ -148,12 +177,12 @@ void Convolver::setup() {
   ready = false;
 
   /*
-    As zita uses fftw we have to be careful when reinitializing it. The thread that creates the fftw plan has to be the
-    same that destroys it. Otherwise segmentation faults can happen. As we do not want to do this initializing in the
-    plugin realtime thread we send it to the main thread through g_idle_add().connect_once
+    Reading the impulse file and initializing zita are too slow for the realtime thread and would freeze the window if
+    done in the main thread. They are done in the worker pool. Zita creates fftw plans, so its configuration is done
+    while holding the fftw planner mutex.
   */
 
-  util::idle_add([&, this] {
+  WorkerPool::get().submit(this, [this](const WorkerPool::Task& /*task*/) {
     if (ready) {
       return;
     }
@@ -171,6 +200,9 @@ void Convolver::setup() {
     data_L.resize(0U);
     data_R.resize(0U);
 
+    data_L.reserve(blocksize);
+    data_R.reserve(blocksize);
+
     deque_out_L.resize(0U);
     deque_out_R.resize(0U);
 
@@ -180,19 +212,35 @@ void Convolver::setup() {
 
     read_kernel_file();
 
-    if (kernel_is_initialized) {
-      kernel_L = original_kernel_L;
-      kernel_R = original_kernel_R;
-
-      set_kernel_stereo_width();
-      apply_kernel_autogain();
+    build_kernel();
 
+    if (!kernel_L.empty()) {
       setup_zita();
     }
 
     std::scoped_lock<std::mutex> lock(data_mutex);
 
-    ready = kernel_is_initialized && zita_ready;
+    ready = !kernel_L.empty() && zita_ready;
+  });
+
+  // A section measured at another sampling rate can not be used. Its effects are linked until it is baked again.
+
+  util::idle_add([this] {
+    if (section_names.empty() || section_rate == rate) {
+      return;
+    }
+
+    if (!baked_section_names.empty()) {
+      {
+        std::scoped_lock<std::mutex> lock(section_mutex);
+
+        baked_section_names.clear();
+      }
+
+      section_changed.emit();
+    }
+
+    bake_section();
   });
 }
 
@@ -213,7 +261,7 @@ void Convolver::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  if (n_samples_is_power_of_2) {
+  if (n_samples_is_power_of_2 && blocksize == left_in.size() && data_L.empty() && deque_out_L.empty()) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -286,7 +334,11 @@ void Convolver::process(std::span<float>& left_in,
 
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
-    util::idle_add([this] { latency.emit(); });
+    util::idle_add([this] {
+      update_tail();
+
+      latency.emit();
+    });
 
     update_filter_params();
 
@@ -321,11 +373,19 @@ auto Convolver::search_irs_path(const std::string& name) -> std::string {
       irs_full_path = local_irs_file.c_str();
     }
   } else {
-    // Search irs file in community package paths.
-    for (const auto& xdg_irs_dir : system_data_dir_irs) {
-      if (util::search_filename(std::filesystem::path{xdg_irs_dir + "/" + community_package}, irs_filename,
-                                irs_full_path, 3U)) {
-        break;
+    if (const auto& catalog = ResourceCatalog::get(); catalog.ready()) {
+      if (const auto entry = catalog.find(ResourceCatalog::Type::irs, community_package, irs_filename)) {
+        irs_full_path = entry->path.string();
+      }
+    }
+
+    // Search irs file in community package paths. The catalogue may not have seen a package installed just now.
+    if (irs_full_path.empty()) {
+      for (const auto& xdg_irs_dir : system_data_dir_irs) {
+        if (util::search_filename(std::filesystem::path{xdg_irs_dir + "/" + community_package}, irs_filename,
+                                  irs_full_path, 3U)) {
+          break;
+        }
       }
     }
   }
@@ -470,13 +530,19 @@ void Convolver::set_kernel_stereo_width() {
 void Convolver::setup_zita() {
   zita_ready = false;
 
-  if (n_samples == 0U || !kernel_is_initialized) {
+  if (n_samples == 0U || kernel_L.empty()) {
     return;
   }
 
   const uint max_convolution_size = kernel_L.size();
   const uint buffer_size = get_zita_buffer_size();
 
+  kernel_size = max_convolution_size;
+
+  update_tail();
+
+  std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
   if (conv != nullptr) {
     conv->stop_process();
 
@@ -530,10 +596,6 @@ void Convolver::setup_zita() {
 }
 
 auto Convolver::get_zita_buffer_size() -> uint {
-  if (n_samples_is_power_of_2) {
-    return n_samples;
-  }
-
   return blocksize;
 }
 
@@ -541,18 +603,39 @@ auto Convolver::get_latency_seconds() -> float {
   return this->latency_value;
 }
 
+auto Convolver::get_tail_seconds() -> float {
+  return static_cast<float>(kernel_size.load(std::memory_order_relaxed)) / static_cast<float>(rate);
+}
+
+auto Convolver::get_quantum_preference(const uint& graph_rate) const -> QuantumPreference {
+  // zita-convolver partitions are powers of two of at least 64 samples.
+
+  return {.frames = 64U, .power_of_two = true};
+}
+
 void Convolver::prepare_kernel() {
   if (n_samples == 0U || rate == 0U) {
     return;
   }
 
-  data_mutex.lock();
+  WorkerPool::get().submit(this, [this](const WorkerPool::Task& /*task*/) {
+    data_mutex.lock();
 
-  ready = false;
+    ready = false;
 
-  data_mutex.unlock();
+    data_mutex.unlock();
 
-  read_kernel_file();
+    read_kernel_file();
+
+    do_rebuild_kernel();
+  });
+}
+
+void Convolver::build_kernel() {
+  kernel_L.clear();
+  kernel_R.clear();
+
+  kernel_size = 0U;
 
   if (kernel_is_initialized) {
     kernel_L = original_kernel_L;
@@ -560,13 +643,221 @@ void Convolver::prepare_kernel() {
 
     set_kernel_stereo_width();
     apply_kernel_autogain();
+  }
 
-    setup_zita();
+  std::scoped_lock<std::mutex> lock(section_mutex);
 
-    data_mutex.lock();
+  if (baked_section_names.empty() || section_kernel_L.empty() || section_rate != rate) {
+    return;
+  }
 
-    ready = kernel_is_initialized && zita_ready;
+  // Without an impulse file the baked section alone is used as kernel.
 
-    data_mutex.unlock();
+  if (kernel_L.empty()) {
+    kernel_L = section_kernel_L;
+    kernel_R = section_kernel_R;
+
+    return;
+  }
+
+  kernel_L = ui::convolver::fft_convolve(section_kernel_L, kernel_L);
+  kernel_R = ui::convolver::fft_convolve(section_kernel_R, kernel_R);
+}
+
+void Convolver::rebuild_kernel() {
+  if (n_samples == 0U || rate == 0U) {
+    return;
+  }
+
+  WorkerPool::get().submit(this, [this](const WorkerPool::Task& /*task*/) { do_rebuild_kernel(); });
+}
+
+void Convolver::do_rebuild_kernel() {
+  if (n_samples == 0U || rate == 0U) {
+    return;
+  }
+
+  data_mutex.lock();
+
+  ready = false;
+
+  data_mutex.unlock();
+
+  build_kernel();
+
+  if (kernel_L.empty()) {
+    return;
+  }
+
+  setup_zita();
+
+  data_mutex.lock();
+
+  ready = zita_ready;
+
+  data_mutex.unlock();
+}
+
+void Convolver::set_linear_section(const std::vector<std::string>& names,
+                                   const std::vector<std::shared_ptr<PluginBase>>& section) {
+  if (names == section_names) {
+    return;
+  }
+
+  section_names = names;
+
+  section_plugins.assign(section.begin(), section.end());
+
+  for (auto& c : section_connections) {
+    c.disconnect();
+  }
+
+  section_connections.clear();
+
+  for (const auto& plugin : section) {
+    section_connections.push_back(plugin->response_changed.connect([this]() { schedule_bake(); }));
+  }
+
+  // A kernel baked for other effects can not be kept. They stay linked until the new section is baked.
+
+  bake_serial++;
+
+  if (!baked_section_names.empty()) {
+    {
+      std::scoped_lock<std::mutex> lock(section_mutex);
+
+      baked_section_names.clear();
+
+      section_kernel_L.clear();
+      section_kernel_R.clear();
+    }
+
+    rebuild_kernel();
+  }
+
+  bake_section();
+}
+
+auto Convolver::get_baked_section() const -> std::vector<std::string> {
+  std::scoped_lock<std::mutex> lock(section_mutex);
+
+  return baked_section_names;
+}
+
+void Convolver::schedule_bake() {
+  // Parameters usually change in bursts while a slider is dragged. Only the last change is baked.
+
+  if (bake_source_id != 0U) {
+    g_source_remove(bake_source_id);
+  }
+
+  bake_source_id = g_timeout_add(BAKE_DEBOUNCE_MS, GSourceFunc(+[](Convolver* self) {
+                                   self->bake_source_id = 0U;
+
+                                   self->bake_section();
+
+                                   return G_SOURCE_REMOVE;
+                                 }),
+                                 this);
+}
+
+void Convolver::bake_section() {
+  if (section_names.empty() || rate == 0U) {
+    return;
+  }
+
+  const uint serial = ++bake_serial;
+
+  // The previous bake is stopped before running its next effect. Bakes have their own owner in the pool so that they
+  // do not delay the kernel updates.
+
+  if (bake_task != nullptr) {
+    bake_task->cancel();
+  }
+
+  // The parameters are copied here, on the main thread where they change. The pool only runs the offline copies.
+
+  std::vector<PluginBase::Bake> bakes;
+
+  for (const auto& weak_plugin : section_plugins) {
+    const auto plugin = weak_plugin.lock();
+
+    auto bake = (plugin != nullptr) ? plugin->prepare_bake() : PluginBase::Bake();
+
+    if (!bake) {
+      util::warning(log_tag + name + ": the linear section could not be baked");
+
+      return;
+    }
+
+    bakes.push_back(std::move(bake));
+  }
+
+  bake_task = WorkerPool::get().submit(&bake_serial, [this, serial, names = section_names, bakes = std::move(bakes),
+                                                      baked_rate = rate](const WorkerPool::Task& task) {
+    const auto length = static_cast<size_t>(BAKE_LENGTH_SECONDS * static_cast<float>(baked_rate));
+
+    std::vector<float> left(length, 0.0F);
+    std::vector<float> right(length, 0.0F);
+
+    left[0] = 1.0F;
+    right[0] = 1.0F;
+
+    for (const auto& bake : bakes) {
+      if (task.is_cancelled() || serial != bake_serial) {
+        return;
+      }
+
+      if (!bake(baked_rate, left, right)) {
+        util::warning(log_tag + name + ": the linear section could not be baked");
+
+        return;
+      }
+    }
+
+    // removing the silent tail (-120 dB)
+
+    auto size = length;
+
+    while (size > 1U && std::fabs(left[size - 1U]) < 1e-6F && std::fabs(right[size - 1U]) < 1e-6F) {
+      size--;
+    }
+
+    left.resize(size);
+    right.resize(size);
+
+    util::idle_add([=, this]() { on_section_baked(serial, names, baked_rate, left, right); });
+  });
+}
+
+void Convolver::on_section_baked(const uint& serial,
+                                 const std::vector<std::string>& names,
+                                 const uint& baked_rate,
+                                 const std::vector<float>& left,
+                                 const std::vector<float>& right) {
+  if (serial != bake_serial || names != section_names) {
+    return;
+  }
+
+  const bool changed = baked_section_names != names;
+
+  {
+    std::scoped_lock<std::mutex> lock(section_mutex);
+
+    section_kernel_L = left;
+    section_kernel_R = right;
+
+    section_rate = baked_rate;
+
+    baked_section_names = names;
+  }
+
+  util::debug(log_tag + name + ": " + util::to_string(names.size()) + " effects baked into the kernel with " +
+              util::to_string(left.size()) + " samples");
+
+  rebuild_kernel();
+
+  if (changed) {
+    section_changed.emit();
   }
 }
@@ -26,13 +26,11 @@
 #include <sndfile.h>
 #include <algorithm>
 #include <cstddef>
-#include <execution>
 #include <filesystem>
 #include <memory>
-#include <numeric>
 #include <sndfile.hh>
 #include <string>
-#include <thread>
+#include <utility>
 #include <vector>
 #include "convolver_ui_common.hpp"
 #include "resampler.hpp"
@@ -40,6 +38,7 @@
 #include "tags_resources.hpp"
 #include "ui_helpers.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 namespace ui::convolver_menu_combine {
 
@@ -53,19 +52,25 @@ struct Data {
  public:
   ~Data() { util::debug("data struct destroyed"); }
 
-  std::vector<std::thread> mythreads;
+  std::shared_ptr<WorkerPool::Task> combination;
 };
 
 struct _ConvolverMenuCombine {
   GtkBox parent_instance;
 
-  GtkDropDown *dropdown_kernel_1, *dropdown_kernel_2;
+  GtkDropDown *dropdown_kernel_1, *dropdown_kernel_2, *dropdown_kernel_3;
+
+  GtkCheckButton* use_kernel_3;
 
   GtkEntry* output_kernel_name;
 
+  GtkButton *combine_kernels, *cancel_combination;
+
   GtkSpinner* spinner;
 
-  GtkStringList *string_list_1, *string_list_2;
+  GtkProgressBar* progress;
+
+  GtkStringList *string_list_1, *string_list_2, *string_list_3;
 
   GSettings* app_settings;
 
@@ -78,97 +83,127 @@ G_DEFINE_TYPE(ConvolverMenuCombine, convolver_menu_combine, GTK_TYPE_POPOVER)
 void append_to_string_list(ConvolverMenuCombine* self, const std::string& irs_filename) {
   ui::append_to_string_list(self->string_list_1, irs_filename);
   ui::append_to_string_list(self->string_list_2, irs_filename);
+  ui::append_to_string_list(self->string_list_3, irs_filename);
 }
 
 void remove_from_string_list(ConvolverMenuCombine* self, const std::string& irs_filename) {
   ui::remove_from_string_list(self->string_list_1, irs_filename);
   ui::remove_from_string_list(self->string_list_2, irs_filename);
+  ui::remove_from_string_list(self->string_list_3, irs_filename);
 }
 
-void direct_conv(const std::vector<float>& a, const std::vector<float>& b, std::vector<float>& c) {
-  std::vector<size_t> indices(c.size());
+void set_busy(ConvolverMenuCombine* self, const bool& state) {
+  gtk_widget_set_sensitive(GTK_WIDGET(self->combine_kernels), static_cast<gboolean>(!state));
+  gtk_widget_set_visible(GTK_WIDGET(self->cancel_combination), static_cast<gboolean>(state));
+  gtk_widget_set_visible(GTK_WIDGET(self->progress), static_cast<gboolean>(state));
 
-  std::iota(indices.begin(), indices.end(), 0U);
+  gtk_progress_bar_set_fraction(self->progress, 0.0);
 
-  auto each = [&](const int n) {
-    c[n] = 0.0F;
+  if (state) {
+    gtk_spinner_start(self->spinner);
+  } else {
+    gtk_spinner_stop(self->spinner);
+  }
+}
 
-    // Static cast to avoid gcc signedness warning.
+void finish_combination(ConvolverMenuCombine* self) {
+  // The method combine_kernels runs in the worker pool. But the widgets have to be used in the main thread.
 
-    const int a_size = static_cast<int>(a.size());
-    const int b_size = static_cast<int>(b.size());
+  g_object_ref(self);
 
-    for (int m = 0; m < b_size; m++) {
-      if (const auto z = n - m; z >= 0 && z < a_size - 1) {
-        c[n] += b[m] * a[z];
-      }
-    }
-  };
-#if defined(ENABLE_LIBCPP_WORKAROUNDS) && (_LIBCPP_VERSION < 170000 || defined(_LIBCPP_HAS_NO_INCOMPLETE_PSTL))
-  std::for_each(indices.begin(), indices.end(), each);
-#else
-  std::for_each(std::execution::par_unseq, indices.begin(), indices.end(), each);
-#endif
+  util::idle_add([=] { set_busy(self, false); }, [=]() { g_object_unref(self); });
 }
 
 void combine_kernels(ConvolverMenuCombine* self,
-                     const std::string& kernel_1_name,
-                     const std::string& kernel_2_name,
+                     const WorkerPool::Task& task,
+                     const std::vector<std::string>& kernel_names,
                      const std::string& output_file_name) {
-  if (output_file_name.empty()) {
-    // The method combine_kernels run in a secondary thread. But the widgets have to be used in the main thread.
+  if (output_file_name.empty() || kernel_names.size() < 2U) {
+    finish_combination(self);
+
+    return;
+  }
 
-    g_object_ref(self);
+  // The kernels are read and brought to the highest sample rate among them before being convolved.
 
-    util::idle_add([=] { gtk_spinner_stop(self->spinner); }, [=]() { g_object_unref(self); });
+  std::vector<std::vector<float>> kernels_L;
+  std::vector<std::vector<float>> kernels_R;
+  std::vector<int> rates;
 
-    return;
+  for (const auto& name : kernel_names) {
+    auto [rate, kernel_L, kernel_R] = ui::convolver::read_kernel(irs_dir, irs_ext, name);
+
+    if (rate == 0) {
+      finish_combination(self);
+
+      return;
+    }
+
+    rates.push_back(rate);
+    kernels_L.push_back(std::move(kernel_L));
+    kernels_R.push_back(std::move(kernel_R));
   }
 
-  auto [rate1, kernel_1_L, kernel_1_R] = ui::convolver::read_kernel(irs_dir, irs_ext, kernel_1_name);
-  auto [rate2, kernel_2_L, kernel_2_R] = ui::convolver::read_kernel(irs_dir, irs_ext, kernel_2_name);
+  const auto rate = *std::max_element(rates.begin(), rates.end());
 
-  if (rate1 == 0 || rate2 == 0) {
-    g_object_ref(self);
+  for (size_t k = 0U; k < kernel_names.size(); k++) {
+    if (rates[k] == rate) {
+      continue;
+    }
 
-    util::idle_add([=] { gtk_spinner_stop(self->spinner); }, [=]() { g_object_unref(self); });
+    util::debug("resampling the kernel " + kernel_names[k] + " to " + util::to_string(rate) + " Hz");
 
-    return;
+    auto resampler = std::make_unique<Resampler>(rates[k], rate);
+
+    kernels_L[k] = resampler->process(kernels_L[k], true);
+
+    resampler = std::make_unique<Resampler>(rates[k], rate);
+
+    kernels_R[k] = resampler->process(kernels_R[k], true);
   }
 
-  if (rate1 > rate2) {
-    util::debug("resampling the kernel " + kernel_2_name + " to " + util::to_string(rate1) + " Hz");
+  // Each channel of each pairwise convolution is one step of the progress bar.
+
+  const auto n_steps = static_cast<float>(2U * (kernel_names.size() - 1U));
 
-    auto resampler = std::make_unique<Resampler>(rate2, rate1);
+  size_t step = 0U;
 
-    kernel_2_L = resampler->process(kernel_2_L, true);
+  int last_percent = 0;
 
-    resampler = std::make_unique<Resampler>(rate2, rate1);
+  auto on_progress = [&](const float& fraction) {
+    const auto percent = static_cast<int>(100.0F * (static_cast<float>(step) + fraction) / n_steps);
 
-    kernel_2_R = resampler->process(kernel_2_R, true);
-  } else if (rate2 > rate1) {
-    util::debug("resampling the kernel " + kernel_1_name + " to " + util::to_string(rate2) + " Hz");
+    if (percent != last_percent) {
+      last_percent = percent;
 
-    auto resampler = std::make_unique<Resampler>(rate1, rate2);
+      g_object_ref(self);
 
-    kernel_1_L = resampler->process(kernel_1_L, true);
+      util::idle_add([=] { gtk_progress_bar_set_fraction(self->progress, 0.01 * percent); },
+                     [=]() { g_object_unref(self); });
+    }
 
-    resampler = std::make_unique<Resampler>(rate1, rate2);
+    return !task.is_cancelled();
+  };
 
-    kernel_1_R = resampler->process(kernel_1_R, true);
-  }
+  auto kernel_L = kernels_L[0];
+  auto kernel_R = kernels_R[0];
 
-  std::vector<float> kernel_L(kernel_1_L.size() + kernel_2_L.size() - 1U);
-  std::vector<float> kernel_R(kernel_1_R.size() + kernel_2_R.size() - 1U);
+  for (size_t k = 1U; k < kernel_names.size(); k++) {
+    kernel_L = ui::convolver::fft_convolve(kernel_L, kernels_L[k], on_progress);
 
-  // As the convolution is commutative we change the order based on which will run faster.
+    step++;
 
-  if (kernel_1_L.size() > kernel_2_L.size()) {
-    direct_conv(kernel_1_L, kernel_2_L, kernel_L);
-    direct_conv(kernel_1_R, kernel_2_R, kernel_R);
-  } else {
-    direct_conv(kernel_2_L, kernel_1_L, kernel_L);
-    direct_conv(kernel_2_R, kernel_1_R, kernel_R);
+    kernel_R = ui::convolver::fft_convolve(kernel_R, kernels_R[k], on_progress);
+
+    step++;
+
+    if (task.is_cancelled()) {
+      util::debug("the combination of the impulse responses was cancelled");
+
+      finish_combination(self);
+
+      return;
+    }
   }
 
   std::vector<float> buffer(kernel_L.size() * 2U);  // 2 channels interleaved
@@ -183,7 +218,6 @@ void combine_kernels(ConvolverMenuCombine* self,
   auto mode = SFM_WRITE;
   auto format = SF_FORMAT_WAV | SF_FORMAT_PCM_32;
   auto n_channels = 2;
-  auto rate = (rate1 > rate2) ? rate1 : rate2;
 
   auto sndfile = SndfileHandle(output_file_path.string(), mode, format, n_channels, rate);
 
@@ -191,29 +225,27 @@ void combine_kernels(ConvolverMenuCombine* self,
 
   util::debug("combined kernel saved: " + output_file_path.string());
 
-  g_object_ref(self);
-
-  util::idle_add([=] { gtk_spinner_stop(self->spinner); }, [=]() { g_object_unref(self); });
+  finish_combination(self);
 }
 
 void on_combine_kernels(ConvolverMenuCombine* self, GtkButton* btn) {
-  if (g_list_model_get_n_items(G_LIST_MODEL(self->string_list_1)) == 0U ||
-      g_list_model_get_n_items(G_LIST_MODEL(self->string_list_2)) == 0U) {
-    return;
-  }
-
-  auto* dropdown_1_selection = gtk_drop_down_get_selected_item(self->dropdown_kernel_1);
-  auto* dropdown_2_selection = gtk_drop_down_get_selected_item(self->dropdown_kernel_2);
+  std::vector<GtkDropDown*> dropdowns = {self->dropdown_kernel_1, self->dropdown_kernel_2};
 
-  if (dropdown_1_selection == nullptr || dropdown_2_selection == nullptr) {
-    return;
+  if (gtk_check_button_get_active(self->use_kernel_3) != 0) {
+    dropdowns.push_back(self->dropdown_kernel_3);
   }
 
-  gtk_spinner_start(self->spinner);
+  std::vector<std::string> kernel_names;
 
-  const auto* const kernel_1_name = gtk_string_object_get_string(GTK_STRING_OBJECT(dropdown_1_selection));
+  for (auto* dropdown : dropdowns) {
+    auto* selection = gtk_drop_down_get_selected_item(dropdown);
 
-  const auto* const kernel_2_name = gtk_string_object_get_string(GTK_STRING_OBJECT(dropdown_2_selection));
+    if (selection == nullptr) {
+      return;
+    }
+
+    kernel_names.emplace_back(gtk_string_object_get_string(GTK_STRING_OBJECT(selection)));
+  }
 
   std::string output_name = g_utf8_make_valid(gtk_editable_get_text(GTK_EDITABLE(self->output_kernel_name)), -1);
 
@@ -227,8 +259,6 @@ void on_combine_kernels(ConvolverMenuCombine* self, GtkButton* btn) {
     gtk_widget_add_css_class(GTK_WIDGET(self->output_kernel_name), "error");
 
     gtk_widget_grab_focus(GTK_WIDGET(self->output_kernel_name));
-
-    gtk_spinner_stop(self->spinner);
   } else {
     // Truncate filename if longer than 100 characters
 
@@ -238,24 +268,30 @@ void on_combine_kernels(ConvolverMenuCombine* self, GtkButton* btn) {
 
     gtk_widget_remove_css_class(GTK_WIDGET(self->output_kernel_name), "error");
 
-    /*
-      The current code convolving the impulse responses is doing direct convolution. It can be very slow depending on
-      the size of each kernel. So we do not want to do it in the main thread.
-    */
+    set_busy(self, true);
+
+    // Long impulse responses can still take a few seconds to be convolved. So we do not do it in the main thread.
+
+    self->data->combination = WorkerPool::get().submit(self->data, [=](const WorkerPool::Task& task) {
+      combine_kernels(self, task, kernel_names, output_name);
+    });
+  }
+}
 
-    self->data->mythreads.emplace_back(  // Using emplace_back here makes sense
-        [=]() { combine_kernels(self, kernel_1_name, kernel_2_name, output_name); });
+void on_cancel_combination(ConvolverMenuCombine* self, GtkButton* btn) {
+  if (self->data->combination != nullptr) {
+    self->data->combination->cancel();
   }
 }
 
 void dispose(GObject* object) {
   auto* self = EE_CONVOLVER_MENU_COMBINE(object);
 
-  for (auto& t : self->data->mythreads) {
-    t.join();
+  if (self->data->combination != nullptr) {
+    self->data->combination->cancel();
   }
 
-  self->data->mythreads.clear();
+  WorkerPool::get().cancel_all(self->data);
 
   g_object_unref(self->app_settings);
 
@@ -285,12 +321,19 @@ void convolver_menu_combine_class_init(ConvolverMenuCombineClass* klass) {
 
   gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, string_list_1);
   gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, string_list_2);
+  gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, string_list_3);
   gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, dropdown_kernel_1);
   gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, dropdown_kernel_2);
+  gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, dropdown_kernel_3);
+  gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, use_kernel_3);
   gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, output_kernel_name);
+  gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, combine_kernels);
+  gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, cancel_combination);
   gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, spinner);
+  gtk_widget_class_bind_template_child(widget_class, ConvolverMenuCombine, progress);
 
   gtk_widget_class_bind_template_callback(widget_class, on_combine_kernels);
+  gtk_widget_class_bind_template_callback(widget_class, on_cancel_combination);
 }
 
 void convolver_menu_combine_init(ConvolverMenuCombine* self) {
@@ -301,6 +344,7 @@ void convolver_menu_combine_init(ConvolverMenuCombine* self) {
   for (const auto& name : util::get_files_name(irs_dir, irs_ext)) {
     gtk_string_list_append(self->string_list_1, name.c_str());
     gtk_string_list_append(self->string_list_2, name.c_str());
+    gtk_string_list_append(self->string_list_3, name.c_str());
   }
 
   self->app_settings = g_settings_new(tags::app::id);
@@ -34,6 +34,7 @@
 #include <string>
 #include "application.hpp"
 #include "config.h"
+#include "settings_store.hpp"
 #include "tags_app.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -338,7 +339,7 @@ void setup(ConvolverMenuImpulses* self,
 
   self->convolver = convolver;
 
-  self->settings = g_settings_new_with_path(tags::schema::convolver::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::convolver::id, schema_path.c_str());
 
   setup_listview(self);
 }
@@ -48,6 +48,8 @@ void ConvolverPreset::save(nlohmann::json& json) {
   json[section][instance_name]["ir-width"] = g_settings_get_int(settings, "ir-width");
 
   json[section][instance_name]["autogain"] = g_settings_get_boolean(settings, "autogain") != 0;
+
+  json[section][instance_name]["bake-linear-section"] = g_settings_get_boolean(settings, "bake-linear-section") != 0;
 }
 
 void ConvolverPreset::load(const nlohmann::json& json) {
@@ -61,6 +63,8 @@ void ConvolverPreset::load(const nlohmann::json& json) {
 
   update_key<bool>(json.at(section).at(instance_name), settings, "autogain", "autogain");
 
+  update_key<bool>(json.at(section).at(instance_name), settings, "bake-linear-section", "bake-linear-section");
+
   // kernel-path deprecation
   const auto* kernel_name_key = "kernel-name";
 
@@ -81,6 +85,6 @@ void ConvolverPreset::load(const nlohmann::json& json) {
   const auto current_kernel_name = util::gsettings_get_string(settings, kernel_name_key);
 
   if (new_kernel_name != current_kernel_name) {
-    g_settings_set_string(settings, kernel_name_key, new_kernel_name.c_str());
+    stage_value(settings, kernel_name_key, g_variant_new_string(new_kernel_name.c_str()));
   }
 }
@@ -40,7 +40,6 @@
 #include <mutex>
 #include <numbers>
 #include <string>
-#include <thread>
 #include <vector>
 #include "application.hpp"
 #include "chart.hpp"
@@ -48,10 +47,13 @@
 #include "convolver_menu_combine.hpp"
 #include "convolver_menu_impulses.hpp"
 #include "convolver_ui_common.hpp"
+#include "fftw_planner.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 namespace ui::convolver_box {
 
@@ -71,10 +73,6 @@ struct Data {
 
   std::shared_ptr<Convolver> convolver;
 
-  std::mutex lock_guard_irs_info;
-
-  std::vector<std::thread> mythreads;
-
   std::vector<sigc::connection> connections;
 
   std::vector<gulong> gconnections;
@@ -116,7 +114,7 @@ struct _ConvolverBox {
 
   Data* data;
 
-  GtkToggleButton* autogain;
+  GtkToggleButton *autogain, *bake_linear_section;
 };
 
 // NOLINTNEXTLINE
@@ -124,6 +122,7 @@ G_DEFINE_TYPE(ConvolverBox, convolver_box, GTK_TYPE_BOX)
 
 void on_reset(ConvolverBox* self, GtkButton* btn) {
   gtk_toggle_button_set_active(self->autogain, 0);
+  gtk_toggle_button_set_active(self->bake_linear_section, 0);
 
   util::reset_all_keys_except(self->settings);
 }
@@ -241,8 +240,13 @@ void get_irs_spectrum(ConvolverBox* self, const int& rate) {
 
   auto* complex_output = fftw_alloc_complex(real_input.size());
 
-  auto* plan =
-      fftw_plan_dft_r2c_1d(static_cast<int>(real_input.size()), real_input.data(), complex_output, FFTW_ESTIMATE);
+  fftw_plan plan = nullptr;
+
+  {
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
+    plan = fftw_plan_dft_r2c_1d(static_cast<int>(real_input.size()), real_input.data(), complex_output, FFTW_ESTIMATE);
+  }
 
   fftw_execute(plan);
 
@@ -283,7 +287,11 @@ void get_irs_spectrum(ConvolverBox* self, const int& rate) {
     fftw_free(complex_output);
   }
 
-  fftw_destroy_plan(plan);
+  {
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
+    fftw_destroy_plan(plan);
+  }
 
   // initializing the frequency axis
 
@@ -512,7 +520,7 @@ void setup(ConvolverBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::convolver::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::convolver::id, schema_path.c_str());
 
   convolver->set_post_messages(true);
 
@@ -542,18 +550,16 @@ void setup(ConvolverBox* self,
 
   self->data->gconnections.push_back(g_signal_connect(
       self->settings, "changed::kernel-name", G_CALLBACK(+[](GSettings* settings, char* key, ConvolverBox* self) {
-        self->data->mythreads.emplace_back([=]() {
-          std::scoped_lock<std::mutex> lock(self->data->lock_guard_irs_info);
+        // The jobs of the same owner run one at a time. So two readings of the file never overlap.
 
-          get_irs_info(self);
-        });
+        WorkerPool::get().submit(self->data, [=](const WorkerPool::Task& /*task*/) { get_irs_info(self); });
       }),
       self));
 
   gtk_label_set_text(self->plugin_credit, ui::get_plugin_credit_translated(self->data->convolver->package).c_str());
 
-  gsettings_bind_widgets<"input-gain", "output-gain", "autogain">(self->settings, self->input_gain, self->output_gain,
-                                                                  self->autogain);
+  gsettings_bind_widgets<"input-gain", "output-gain", "autogain", "bake-linear-section">(
+      self->settings, self->input_gain, self->output_gain, self->autogain, self->bake_linear_section);
 
   g_settings_bind(self->settings, "ir-width", gtk_spin_button_get_adjustment(self->ir_width), "value",
                   G_SETTINGS_BIND_DEFAULT);
@@ -568,11 +574,7 @@ void dispose(GObject* object) {
 
   g_object_unref(self->folder_monitor);
 
-  for (auto& t : self->data->mythreads) {
-    t.join();
-  }
-
-  self->data->mythreads.clear();
+  WorkerPool::get().cancel_all(self->data);
 
   for (auto& c : self->data->connections) {
     c.disconnect();
@@ -595,11 +597,7 @@ void dispose(GObject* object) {
 void finalize(GObject* object) {
   auto* self = EE_CONVOLVER_BOX(object);
 
-  for (auto& t : self->data->mythreads) {
-    t.join();
-  }
-
-  self->data->mythreads.clear();
+  WorkerPool::get().cancel_all(self->data);
 
   delete self->data;
 
@@ -642,6 +640,7 @@ void convolver_box_class_init(ConvolverBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, ConvolverBox, enable_log_scale);
   gtk_widget_class_bind_template_child(widget_class, ConvolverBox, chart_box);
   gtk_widget_class_bind_template_child(widget_class, ConvolverBox, autogain);
+  gtk_widget_class_bind_template_child(widget_class, ConvolverBox, bake_linear_section);
 
   gtk_widget_class_bind_template_callback(widget_class, on_reset);
   gtk_widget_class_bind_template_callback(widget_class, on_show_fft);
@@ -717,11 +716,8 @@ void convolver_box_init(ConvolverBox* self) {
                        when the impulse response file information is available
                      */
 
-                     self->data->mythreads.emplace_back([=]() {  // Using emplace_back here makes sense
-                       std::scoped_lock<std::mutex> lock(self->data->lock_guard_irs_info);
-
-                       get_irs_info(self);
-                     });
+                     WorkerPool::get().submit(self->data,
+                                              [=](const WorkerPool::Task& /*task*/) { get_irs_info(self); });
                    }),
                    self);
 }
@@ -18,12 +18,17 @@
  */
 
 #include "convolver_ui_common.hpp"
+#include <fftw3.h>
+#include <algorithm>
 #include <cstddef>
 #include <filesystem>
+#include <functional>
+#include <mutex>
 #include <sndfile.hh>
 #include <string>
 #include <tuple>
 #include <vector>
+#include "fftw_planner.hpp"
 #include "util.hpp"
 
 namespace ui::convolver {
@@ -74,4 +79,105 @@ auto read_kernel(std::filesystem::path irs_dir, const std::string& irs_ext, cons
   return std::make_tuple(rate, kernel_L, kernel_R);
 }
 
+auto fft_convolve(const std::vector<float>& a,
+                  const std::vector<float>& b,
+                  const std::function<bool(const float&)>& on_progress) -> std::vector<float> {
+  if (a.empty() || b.empty()) {
+    return {};
+  }
+
+  // As the convolution is commutative the shorter input is used as the filter.
+
+  const auto& x = (a.size() >= b.size()) ? a : b;
+  const auto& h = (a.size() >= b.size()) ? b : a;
+
+  const size_t output_size = x.size() + h.size() - 1U;
+
+  size_t fft_size = 1U;
+
+  while (fft_size < 2U * h.size()) {
+    fft_size <<= 1U;
+  }
+
+  const size_t block_size = fft_size - h.size() + 1U;
+  const size_t n_bins = fft_size / 2U + 1U;
+  const double norm = 1.0 / static_cast<double>(fft_size);
+
+  auto* real_buffer = fftw_alloc_real(fft_size);
+  auto* h_spectrum = fftw_alloc_complex(n_bins);
+  auto* x_spectrum = fftw_alloc_complex(n_bins);
+
+  fftw_plan forward = nullptr;
+  fftw_plan backward = nullptr;
+
+  {
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
+    forward = fftw_plan_dft_r2c_1d(static_cast<int>(fft_size), real_buffer, x_spectrum, FFTW_ESTIMATE);
+    backward = fftw_plan_dft_c2r_1d(static_cast<int>(fft_size), x_spectrum, real_buffer, FFTW_ESTIMATE);
+  }
+
+  // filter spectrum
+
+  std::fill(real_buffer, real_buffer + fft_size, 0.0);
+  std::copy(h.begin(), h.end(), real_buffer);
+
+  fftw_execute_dft_r2c(forward, real_buffer, h_spectrum);
+
+  std::vector<float> output(output_size, 0.0F);
+
+  bool cancelled = false;
+
+  for (size_t offset = 0U; offset < x.size(); offset += block_size) {
+    const size_t count = std::min(block_size, x.size() - offset);
+
+    std::fill(real_buffer, real_buffer + fft_size, 0.0);
+    std::copy_n(x.begin() + static_cast<std::ptrdiff_t>(offset), count, real_buffer);
+
+    fftw_execute_dft_r2c(forward, real_buffer, x_spectrum);
+
+    for (size_t k = 0U; k < n_bins; k++) {
+      const double re = x_spectrum[k][0] * h_spectrum[k][0] - x_spectrum[k][1] * h_spectrum[k][1];
+      const double im = x_spectrum[k][0] * h_spectrum[k][1] + x_spectrum[k][1] * h_spectrum[k][0];
+
+      x_spectrum[k][0] = re;
+      x_spectrum[k][1] = im;
+    }
+
+    fftw_execute_dft_c2r(backward, x_spectrum, real_buffer);
+
+    // overlap-add of the block tail into the next block region
+
+    const size_t n_valid = std::min(count + h.size() - 1U, output_size - offset);
+
+    for (size_t n = 0U; n < n_valid; n++) {
+      output[offset + n] += static_cast<float>(real_buffer[n] * norm);
+    }
+
+    if (on_progress != nullptr &&
+        !on_progress(static_cast<float>(offset + count) / static_cast<float>(x.size()))) {
+      cancelled = true;
+
+      break;
+    }
+  }
+
+  {
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
+    fftw_destroy_plan(forward);
+    fftw_destroy_plan(backward);
+  }
+
+  fftw_free(real_buffer);
+  fftw_free(h_spectrum);
+  fftw_free(x_spectrum);
+
+  if (cancelled) {
+    return {};
+  }
+
+  return output;
+}
+
 }  // namespace ui::convolver
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <span>
 #include <string>
+#include "dsp.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -67,6 +68,8 @@ Crossfeed::Crossfeed(const std::string& tag,
                        }),
                        this));
 
+  quantum_independent = true;
+
   setup_input_output_gain();
 }
 
@@ -81,7 +84,7 @@ Crossfeed::~Crossfeed() {
 void Crossfeed::setup() {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
-  data.resize(2U * static_cast<size_t>(n_samples));
+  data.resize(2U * static_cast<size_t>(max_quantum));
 
   if (rate != bs2b.get_srate()) {
     bs2b.set_srate(rate);
@@ -105,17 +108,11 @@ void Crossfeed::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  for (size_t n = 0U; n < left_in.size(); n++) {
-    data[n * 2U] = left_in[n];
-    data[n * 2U + 1U] = right_in[n];
-  }
+  dsp::interleave(left_in, right_in, data);
 
-  bs2b.cross_feed(data.data(), static_cast<int>(n_samples));
+  bs2b.cross_feed(data.data(), static_cast<int>(left_in.size()));
 
-  for (size_t n = 0U; n < left_out.size(); n++) {
-    left_out[n] = data[n * 2U];
-    right_out[n] = data[n * 2U + 1U];
-  }
+  dsp::deinterleave(data, left_out, right_out);
 
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
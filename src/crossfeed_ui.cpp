@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "crossfeed.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -100,7 +101,7 @@ void setup(CrossfeedBox* self, std::shared_ptr<Crossfeed> crossfeed, const std::
 
   self->data->crossfeed = crossfeed;
 
-  self->settings = g_settings_new_with_path(tags::schema::crossfeed::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::crossfeed::id, schema_path.c_str());
 
   crossfeed->set_post_messages(true);
 
@@ -34,6 +34,7 @@
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 Crystalizer::Crystalizer(const std::string& tag,
                          const std::string& schema,
@@ -76,6 +77,10 @@ Crystalizer::Crystalizer(const std::string& tag,
     bind_band(static_cast<int>(n));
   }
 
+  // The band filters keep the block size chosen in setup(). Blocks of any other size go through the deques below.
+
+  quantum_independent = true;
+
   setup_input_output_gain();
 }
 
@@ -84,6 +89,8 @@ Crystalizer::~Crystalizer() {
     disconnect_from_pw();
   }
 
+  WorkerPool::get().cancel_all(this);
+
   data_mutex.lock();
 
   filters_are_ready = false;
@@ -100,13 +107,9 @@ void Crystalizer::setup() {
 
   data_mutex.unlock();
 
-  /*
-    As zita uses fftw we have to be careful when reinitializing it. The thread that creates the fftw plan has to be the
-    same that destroys it. Otherwise segmentation faults can happen. As we do not want to do this initializing in the
-    plugin realtime thread we send it to the main thread through g_idle_add().connect_once
-  */
+  // Building the band filters is too slow for the realtime thread. It is done in the worker pool.
 
-  util::idle_add([&, this] {
+  WorkerPool::get().submit(this, [this](const WorkerPool::Task& /*task*/) {
     if (filters_are_ready) {
       return;
     }
@@ -134,6 +137,9 @@ void Crystalizer::setup() {
     data_L.resize(0U);
     data_R.resize(0U);
 
+    data_L.reserve(blocksize);
+    data_R.reserve(blocksize);
+
     for (uint n = 0U; n < nbands; n++) {
       band_data_L.at(n).resize(blocksize);
       band_data_R.at(n).resize(blocksize);
@@ -177,7 +183,7 @@ void Crystalizer::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  if (n_samples_is_power_of_2 && blocksize == n_samples) {
+  if (n_samples_is_power_of_2 && blocksize == left_in.size() && data_L.empty() && deque_out_L.empty()) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -251,6 +257,8 @@ void Crystalizer::process(std::span<float>& left_in,
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -330,3 +338,9 @@ void Crystalizer::bind_band(const int& n) {
 auto Crystalizer::get_latency_seconds() -> float {
   return this->latency_value;
 }
+
+auto Crystalizer::get_quantum_preference(const uint& graph_rate) const -> QuantumPreference {
+  // The band filters use zita-convolver, whose partitions are powers of two of at least 64 samples.
+
+  return {.frames = 64U, .power_of_two = true};
+}
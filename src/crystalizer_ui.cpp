@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 #include "crystalizer.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -166,7 +167,7 @@ void setup(CrystalizerBox* self, std::shared_ptr<Crystalizer> crystalizer, const
 
   self->data->crystalizer = crystalizer;
 
-  self->settings = g_settings_new_with_path(tags::schema::crystalizer::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::crystalizer::id, schema_path.c_str());
 
   crystalizer->set_post_messages(true);
 
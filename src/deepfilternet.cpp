@@ -18,18 +18,26 @@
  */
 
 #include "deepfilternet.hpp"
+#include <sys/types.h>
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <span>
 #include <string>
+#include <thread>
 #include <vector>
+#include "dsp.hpp"
 #include "ladspa_wrapper.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "resampler.hpp"
+#include "ring_buffer.hpp"
+#include "rt_sanitizer.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 DeepFilterNet::DeepFilterNet(const std::string& tag,
                              const std::string& schema,
@@ -68,7 +76,21 @@ DeepFilterNet::DeepFilterNet(const std::string& tag,
 
   ladspa_wrapper->bind_key_double<"Post Filter Beta", "post-filter-beta">(settings);
 
+  quantum_independent = true;
+
   setup_input_output_gain();
+
+  worker = std::thread([this]() {
+    while (!quit_worker) {
+      work_pending.wait(false);
+
+      work_pending = false;
+
+      std::scoped_lock<std::mutex> lock(worker_mutex);
+
+      drain();
+    }
+  });
 }
 
 DeepFilterNet::~DeepFilterNet() {
@@ -76,127 +98,260 @@ DeepFilterNet::~DeepFilterNet() {
     disconnect_from_pw();
   }
 
+  WorkerPool::get().cancel_all(this);
+
+  quit_worker = true;
+  work_pending = true;
+
+  work_pending.notify_one();
+
+  worker.join();
+
   util::debug(log_tag + name + " destroyed");
 }
 
 void DeepFilterNet::setup() {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
+  ready = false;
+
   if (!ladspa_wrapper->found_plugin()) {
     return;
   }
 
-  resample = rate != 48000;
-  resampler_ready = !resample;
+  // Loading the model takes a while. It is done in the worker pool instead of the main thread.
+
+  WorkerPool::get().submit(this, [this, graph_rate = rate, quantum = n_samples](const WorkerPool::Task& /*task*/) {
+    reconfigure(graph_rate, quantum);
+  });
+}
+
+auto DeepFilterNet::make_engine(const uint& graph_rate, const uint& quantum) -> std::unique_ptr<Engine> {
+  auto e = std::make_unique<Engine>();
+
+  e->rate = graph_rate;
+  e->n_samples = quantum;
+
+  e->frame_in_l.resize(model_frame_size);
+  e->frame_in_r.resize(model_frame_size);
+  e->frame_out_l.resize(model_frame_size);
+  e->frame_out_r.resize(model_frame_size);
+  e->frame_out.resize(2U * model_frame_size);
+
+  // Both channels go through the same resampler in a single pass.
+
+  const bool resample = graph_rate != model_rate;
+
+  e->resampler_in = resample ? std::make_unique<Resampler>(graph_rate, model_rate, 2) : nullptr;
+  e->resampler_out = resample ? std::make_unique<Resampler>(model_rate, graph_rate, 2) : nullptr;
+
+  const uint frame_size = (model_frame_size * graph_rate + model_rate - 1U) / model_rate;
+
+  e->latency_n_frames = quantum + frame_size + (resample ? frame_size : 0U);
+
+  // The buffers take blocks of up to max_quantum. Only the initial silence depends on the quantum.
+
+  const size_t capacity = 2U * (static_cast<size_t>(e->latency_n_frames) + 4U * (max_quantum + frame_size));
+
+  e->interleaved.resize(2U * max_quantum);
+
+  e->chunk.resize(2U * std::max(max_quantum, model_frame_size));
+
+  e->pending.reserve(capacity);
+
+  e->ring_in.resize(capacity);
+  e->ring_out.resize(capacity);
+
+  std::vector<float> silence(2U * e->latency_n_frames, 0.0F);
+
+  e->ring_out.write(silence);
+
+  return e;
+}
+
+void DeepFilterNet::reconfigure(const uint& graph_rate, const uint& quantum) {
+  if (quantum == 0U || graph_rate == 0U) {
+    return;
+  }
+
+  auto new_engine = make_engine(graph_rate, quantum);
+
+  // The worker runs the model. It waits while the instance is created, but the realtime thread does not.
+
+  std::scoped_lock<std::mutex> worker_lock(worker_mutex);
+
+  if (ladspa_wrapper->get_rate() != model_rate) {
+    ladspa_wrapper->create_instance(model_rate);
+    ladspa_wrapper->activate();
+  }
+
+  if (!ladspa_wrapper->has_instance()) {
+    return;
+  }
+
+  ladspa_wrapper->n_samples = model_frame_size;
 
-  util::idle_add([&, this] {
-    ladspa_wrapper->n_samples = n_samples;
+  ladspa_wrapper->connect_data_ports(new_engine->frame_in_l, new_engine->frame_in_r, new_engine->frame_out_l,
+                                     new_engine->frame_out_r);
+
+  {
     std::scoped_lock<std::mutex> lock(data_mutex);
 
-    if (ladspa_wrapper->get_rate() != 48000) {
-      ladspa_wrapper->create_instance(48000);
-      ladspa_wrapper->activate();
-    }
+    engine.swap(new_engine);
 
-    if (resample && !resampler_ready) {
-      resampler_inL = std::make_unique<Resampler>(rate, 48000);
-      resampler_inR = std::make_unique<Resampler>(rate, 48000);
-      resampler_outL = std::make_unique<Resampler>(48000, rate);
-      resampler_outR = std::make_unique<Resampler>(48000, rate);
+    notify_latency = true;
 
-      std::vector<float> dummy(n_samples);
+    ready = true;
+  }
 
-      const auto resampled_inL = resampler_inL->process(dummy, false);
-      const auto resampled_inR = resampler_inR->process(dummy, false);
+  // The previous engine is freed here, after the lock was released.
+}
 
-      resampled_outL.resize(resampled_inL.size());
-      resampled_outR.resize(resampled_inR.size());
+void DeepFilterNet::drain() {
+  if (engine == nullptr) {
+    return;
+  }
 
-      resampler_outL->process(resampled_inL, false);
-      resampler_outR->process(resampled_inR, false);
+  auto& e = *engine;
 
-      carryover_l.clear();
-      carryover_r.clear();
-      carryover_l.reserve(4);  // chosen by fair dice roll.
-      carryover_r.reserve(4);  // guaranteed to be random.
-      carryover_l.push_back(0.0F);
-      carryover_r.push_back(0.0F);
+  while (e.ring_in.read_available() > 0U) {
+    const auto count = e.ring_in.read(e.chunk);
 
-      resampler_ready = true;
+    const std::span<const float> data(e.chunk.data(), count);
+
+    if (e.resampler_in != nullptr) {
+      const auto& resampled = e.resampler_in->process(data, false);
+
+      e.pending.insert(e.pending.end(), resampled.begin(), resampled.end());
+    } else {
+      e.pending.insert(e.pending.end(), data.begin(), data.end());
     }
-  });
+
+    size_t offset = 0U;
+
+    for (; offset + 2U * model_frame_size <= e.pending.size(); offset += 2U * model_frame_size) {
+      dsp::deinterleave(std::span(e.pending).subspan(offset, 2U * model_frame_size), e.frame_in_l, e.frame_in_r);
+
+      ladspa_wrapper->run();
+
+      dsp::interleave(e.frame_out_l, e.frame_out_r, e.frame_out);
+
+      if (e.resampler_out != nullptr) {
+        e.ring_out.write(e.resampler_out->process(e.frame_out, false));
+      } else {
+        e.ring_out.write(e.frame_out);
+      }
+    }
+
+    e.pending.erase(e.pending.begin(), e.pending.begin() + static_cast<std::ptrdiff_t>(offset));
+  }
 }
 
 void DeepFilterNet::process(std::span<float>& left_in,
                             std::span<float>& right_in,
                             std::span<float>& left_out,
                             std::span<float>& right_out) {
-  std::scoped_lock<std::mutex> lock(data_mutex);
+  std::unique_lock<std::mutex> lock(data_mutex, std::try_to_lock);
+
+  /*
+    The lock is only taken elsewhere while a new engine is swapped in. The undelayed input would not line up with the
+    output of either engine, so this block is silent, like the start of the new one.
+  */
+
+  if (!lock.owns_lock()) {
+    std::ranges::fill(left_out, 0.0F);
+    std::ranges::fill(right_out, 0.0F);
+
+    return;
+  }
 
-  if (!ladspa_wrapper->found_plugin() || !ladspa_wrapper->has_instance() || bypass) {
+  if (!ready || bypass || engine == nullptr || left_in.size() > max_quantum) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
     return;
   }
 
+  auto& e = *engine;
+
+  /*
+    The initial silence only covers the quantum the engine was built for. A larger one would keep the worker late, so
+    an engine with more silence is built in the background. Until then the missing samples are replaced by silence.
+  */
+
+  if (left_in.size() > e.n_samples && !e.grow_requested) {
+    e.grow_requested = true;
+
+    util::idle_add([this, graph_rate = e.rate, quantum = static_cast<uint>(left_in.size())] {
+      WorkerPool::get().submit(this, [this, graph_rate, quantum](const WorkerPool::Task& /*task*/) {
+        reconfigure(graph_rate, quantum);
+      });
+    });
+  }
+
   if (input_gain != 1.0F) {
     apply_gain(left_in, right_in, input_gain);
   }
 
-  if (resample) {
-    const auto& resampled_inL = resampler_inL->process(left_in, false);
-    const auto& resampled_inR = resampler_inR->process(right_in, false);
+  const auto block = std::span(e.interleaved).first(2U * left_in.size());
 
-    resampled_outL.resize(resampled_inL.size());
-    resampled_outR.resize(resampled_inR.size());
+  dsp::interleave(left_in, right_in, block);
 
-    ladspa_wrapper->n_samples = resampled_inL.size();
-    ladspa_wrapper->connect_data_ports(resampled_inL, resampled_inR, resampled_outL, resampled_outR);
-  } else {
-    ladspa_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
-  }
+  e.ring_in.write(block);
 
-  ladspa_wrapper->run();
+  if (pm != nullptr) {
+    work_pending = true;
 
-  if (resample) {
-    const auto& outL = resampler_outL->process(resampled_outL, false);
-    const auto& outR = resampler_outR->process(resampled_outR, false);
+    work_pending.notify_one();
+  } else {
+    // The offline renderer has no deadline. The frames are processed right away so that no silence is inserted.
 
-    auto carryover_end_l = std::min(carryover_l.size(), left_out.size());
-    auto carryover_end_r = std::min(carryover_r.size(), right_out.size());
+    [[maybe_unused]] const rt_sanitizer::ScopedAllowed allowed;
 
-    auto left_offset =
-        carryover_end_l + outL.size() > left_out.size() ? carryover_end_l : left_out.size() - outL.size();
-    auto right_offset =
-        carryover_end_r + outR.size() > right_out.size() ? carryover_end_r : right_out.size() - outR.size();
+    std::scoped_lock<std::mutex> worker_lock(worker_mutex);
 
-    auto left_count = std::min(outL.size(), left_out.size() - left_offset);
-    auto right_count = std::min(outR.size(), right_out.size() - right_offset);
+    drain();
+  }
 
-    std::copy(carryover_l.begin(), carryover_l.begin() + carryover_end_l, left_out.begin());
-    std::copy(carryover_r.begin(), carryover_r.begin() + carryover_end_r, right_out.begin());
+  /*
+    When the worker is late the missing samples are replaced by silence and skipped once they arrive, so the latency
+    stays the one we reported.
+  */
 
-    carryover_l.erase(carryover_l.begin(), carryover_l.begin() + carryover_end_l);
-    carryover_r.erase(carryover_r.begin(), carryover_r.begin() + carryover_end_r);
+  e.n_missing -= e.ring_out.skip(e.n_missing);
 
-    std::fill(left_out.begin() + carryover_end_l, left_out.begin() + left_offset, 0);
-    std::fill(right_out.begin() + carryover_end_r, right_out.begin() + right_offset, 0);
+  const auto count = (e.n_missing == 0U) ? e.ring_out.read(block) : 0U;
 
-    std::copy(outL.begin(), outL.begin() + left_count, left_out.begin() + left_offset);
-    std::copy(outR.begin(), outR.begin() + right_count, right_out.begin() + right_offset);
+  std::fill(block.begin() + static_cast<std::ptrdiff_t>(count), block.end(), 0.0F);
 
-    carryover_l.insert(carryover_l.end(), outL.begin() + left_count, outL.end());
-    carryover_r.insert(carryover_r.end(), outR.begin() + right_count, outR.end());
+  e.n_missing += block.size() - count;
 
-    std::fill(left_out.begin() + left_offset + left_count, left_out.end(), 0);
-    std::fill(right_out.begin() + right_offset + right_count, right_out.end(), 0);
-  }
+  dsp::deinterleave(block, left_out, right_out);
 
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
   }
 
+  if (notify_latency) {
+    latency_value = static_cast<float>(e.latency_n_frames) / static_cast<float>(e.rate);
+
+    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
+
+    util::idle_add([this]() {
+      update_tail();
+
+      if (!post_messages || latency.empty()) {
+        return;
+      }
+
+      latency.emit();
+    });
+
+    update_filter_params();
+
+    notify_latency = false;
+  }
+
   if (post_messages) {
     get_peaks(left_in, right_in, left_out, right_out);
 
@@ -206,6 +361,12 @@ void DeepFilterNet::process(std::span<float>& left_in,
   }
 }
 
+// The model itself looks 20 ms ahead.
+
 auto DeepFilterNet::get_latency_seconds() -> float {
-  return 0.02F + 1.0F / rate;
+  return latency_value + 0.02F;
+}
+
+auto DeepFilterNet::get_quantum_preference(const uint& graph_rate) const -> QuantumPreference {
+  return {.frames = graph_rate * model_frame_size / model_rate};
 }
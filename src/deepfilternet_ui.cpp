@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "deepfilternet.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -91,7 +92,7 @@ void setup(DeepFilterNetBox* self, std::shared_ptr<DeepFilterNet> deepfilternet,
 
   self->data->deepfilternet = deepfilternet;
 
-  self->settings = g_settings_new_with_path(tags::schema::deepfilternet::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::deepfilternet::id, schema_path.c_str());
 
   deepfilternet->set_post_messages(true);
 
@@ -44,6 +44,8 @@ Deesser::Deesser(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_independent = true;
+
   if (!package_installed) {
     util::debug(log_tag + "http://calf.sourceforge.net/plugins/Deesser is not installed");
   }
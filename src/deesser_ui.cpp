@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 #include "deesser.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -95,7 +96,7 @@ void setup(DeesserBox* self, std::shared_ptr<Deesser> deesser, const std::string
 
   self->data->deesser = deesser;
 
-  self->settings = g_settings_new_with_path(tags::schema::deesser::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::deesser::id, schema_path.c_str());
 
   deesser->set_post_messages(true);
 
@@ -45,6 +45,8 @@ Delay::Delay(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_independent = true;
+
   if (!package_installed) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/comp_delay_x2_stereo is not installed");
   }
@@ -65,6 +67,8 @@ Delay::Delay(const std::string& tag,
   lv2_wrapper->bind_key_double_db<"wet_l", "wet-l", false>(settings);
   lv2_wrapper->bind_key_double_db<"wet_r", "wet-r", false>(settings);
 
+  bakeable = true;
+
   setup_input_output_gain();
 }
 
@@ -124,6 +128,8 @@ void Delay::process(std::span<float>& left_in,
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -146,3 +152,12 @@ void Delay::process(std::span<float>& left_in,
 auto Delay::get_latency_seconds() -> float {
   return latency_value;
 }
+
+auto Delay::get_tail_seconds() -> float {
+  if (!lv2_wrapper->found_plugin) {
+    return 0.0F;
+  }
+
+  return 0.001F * std::max(lv2_wrapper->get_control_port_value("time_l"),
+                           lv2_wrapper->get_control_port_value("time_r"));
+}
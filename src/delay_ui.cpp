@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "delay.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -97,7 +98,7 @@ void setup(DelayBox* self, std::shared_ptr<Delay> delay, const std::string& sche
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::delay::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::delay::id, schema_path.c_str());
 
   delay->set_post_messages(true);
 
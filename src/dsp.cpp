@@ -0,0 +1,302 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <utility>
+
+/*
+  The kernels are written with the vector extensions of gcc and clang instead of intrinsics. A vector of 16 floats is
+  one AVX-512 register, two AVX2 registers or four SSE2/NEON registers, and the compiler emits the right instructions
+  for each clone. The remaining samples are handled by a scalar loop.
+*/
+
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define DSP_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+
+#ifndef DSP_KERNEL
+#define DSP_KERNEL
+#endif
+
+namespace {
+
+constexpr size_t lanes = 16U;
+
+using vfloat = float __attribute__((vector_size(lanes * sizeof(float))));
+
+using vint32 = int32_t __attribute__((vector_size(lanes * sizeof(int32_t))));
+
+using vint16 = int16_t __attribute__((vector_size(lanes * sizeof(int16_t))));
+
+constexpr float int16_scale = static_cast<float>(std::numeric_limits<int16_t>::max()) + 1.0F;
+
+}  // namespace
+
+namespace dsp {
+
+DSP_KERNEL void scale(std::span<float> data, const float& gain) {
+  const auto size = data.size();
+
+  size_t n = 0U;
+
+  for (; n + lanes <= size; n += lanes) {
+    vfloat v;
+
+    std::memcpy(&v, data.data() + n, sizeof(v));
+
+    v *= gain;
+
+    std::memcpy(data.data() + n, &v, sizeof(v));
+  }
+
+  for (; n < size; n++) {
+    data[n] *= gain;
+  }
+}
+
+DSP_KERNEL auto peak(std::span<const float> left, std::span<const float> right) -> std::pair<float, float> {
+  const auto size = std::min(left.size(), right.size());
+
+  auto peak_l = -std::numeric_limits<float>::infinity();
+  auto peak_r = -std::numeric_limits<float>::infinity();
+
+  size_t n = 0U;
+
+  if (size >= lanes) {
+    vfloat max_l;
+    vfloat max_r;
+
+    std::memcpy(&max_l, left.data(), sizeof(max_l));
+    std::memcpy(&max_r, right.data(), sizeof(max_r));
+
+    for (n = lanes; n + lanes <= size; n += lanes) {
+      vfloat l;
+      vfloat r;
+
+      std::memcpy(&l, left.data() + n, sizeof(l));
+      std::memcpy(&r, right.data() + n, sizeof(r));
+
+      max_l = (l > max_l) ? l : max_l;
+      max_r = (r > max_r) ? r : max_r;
+    }
+
+    for (size_t k = 0U; k < lanes; k++) {
+      peak_l = std::max(peak_l, max_l[k]);
+      peak_r = std::max(peak_r, max_r[k]);
+    }
+  }
+
+  for (; n < size; n++) {
+    peak_l = std::max(peak_l, left[n]);
+    peak_r = std::max(peak_r, right[n]);
+  }
+
+  return {peak_l, peak_r};
+}
+
+DSP_KERNEL auto is_silent(std::span<const float> left, std::span<const float> right, const float& threshold) -> bool {
+  const auto size = std::min(left.size(), right.size());
+
+  size_t n = 0U;
+
+  vint32 loud = {};
+
+  for (; n + lanes <= size; n += lanes) {
+    vfloat l;
+    vfloat r;
+
+    std::memcpy(&l, left.data() + n, sizeof(l));
+    std::memcpy(&r, right.data() + n, sizeof(r));
+
+    loud |= (l > threshold) | (l < -threshold) | (r > threshold) | (r < -threshold);
+  }
+
+  for (size_t k = 0U; k < lanes; k++) {
+    if (loud[k] != 0) {
+      return false;
+    }
+  }
+
+  for (; n < size; n++) {
+    if (std::fabs(left[n]) > threshold || std::fabs(right[n]) > threshold) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+DSP_KERNEL void interleave(std::span<const float> left, std::span<const float> right, std::span<float> output) {
+  const auto size = std::min({left.size(), right.size(), output.size() / 2U});
+
+  size_t n = 0U;
+
+  for (; n + lanes <= size; n += lanes) {
+    vfloat l;
+    vfloat r;
+
+    std::memcpy(&l, left.data() + n, sizeof(l));
+    std::memcpy(&r, right.data() + n, sizeof(r));
+
+    const vfloat low = __builtin_shufflevector(l, r, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    const vfloat high = __builtin_shufflevector(l, r, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+
+    std::memcpy(output.data() + 2U * n, &low, sizeof(low));
+    std::memcpy(output.data() + 2U * n + lanes, &high, sizeof(high));
+  }
+
+  for (; n < size; n++) {
+    output[2U * n] = left[n];
+    output[2U * n + 1U] = right[n];
+  }
+}
+
+DSP_KERNEL void deinterleave(std::span<const float> input, std::span<float> left, std::span<float> right) {
+  const auto size = std::min({input.size() / 2U, left.size(), right.size()});
+
+  size_t n = 0U;
+
+  for (; n + lanes <= size; n += lanes) {
+    vfloat low;
+    vfloat high;
+
+    std::memcpy(&low, input.data() + 2U * n, sizeof(low));
+    std::memcpy(&high, input.data() + 2U * n + lanes, sizeof(high));
+
+    const vfloat l = __builtin_shufflevector(low, high, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const vfloat r = __builtin_shufflevector(low, high, 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+
+    std::memcpy(left.data() + n, &l, sizeof(l));
+    std::memcpy(right.data() + n, &r, sizeof(r));
+  }
+
+  for (; n < size; n++) {
+    left[n] = input[2U * n];
+    right[n] = input[2U * n + 1U];
+  }
+}
+
+DSP_KERNEL void float_to_int16(std::span<const float> input, std::span<int16_t> output) {
+  const auto size = std::min(input.size(), output.size());
+
+  constexpr auto min_value = static_cast<float>(std::numeric_limits<int16_t>::min());
+  constexpr auto max_value = static_cast<float>(std::numeric_limits<int16_t>::max());
+
+  size_t n = 0U;
+
+  for (; n + lanes <= size; n += lanes) {
+    vfloat v;
+
+    std::memcpy(&v, input.data() + n, sizeof(v));
+
+    v *= int16_scale;
+
+    v = (v < min_value) ? min_value : v;
+    v = (v > max_value) ? max_value : v;
+
+    const auto i = __builtin_convertvector(__builtin_convertvector(v, vint32), vint16);
+
+    std::memcpy(output.data() + n, &i, sizeof(i));
+  }
+
+  for (; n < size; n++) {
+    output[n] = static_cast<int16_t>(std::clamp(input[n] * int16_scale, min_value, max_value));
+  }
+}
+
+DSP_KERNEL void int16_to_float(std::span<const int16_t> input, std::span<float> output) {
+  const auto size = std::min(input.size(), output.size());
+
+  constexpr auto inv_scale = 1.0F / int16_scale;
+
+  size_t n = 0U;
+
+  for (; n + lanes <= size; n += lanes) {
+    vint16 i;
+
+    std::memcpy(&i, input.data() + n, sizeof(i));
+
+    const auto v = __builtin_convertvector(i, vfloat) * inv_scale;
+
+    std::memcpy(output.data() + n, &v, sizeof(v));
+  }
+
+  for (; n < size; n++) {
+    output[n] = static_cast<float>(input[n]) * inv_scale;
+  }
+}
+
+DSP_KERNEL void mix(std::span<const float> a,
+                    const float& gain_a,
+                    std::span<const float> b,
+                    const float& gain_b,
+                    std::span<float> output) {
+  const auto size = std::min({a.size(), b.size(), output.size()});
+
+  size_t n = 0U;
+
+  for (; n + lanes <= size; n += lanes) {
+    vfloat va;
+    vfloat vb;
+
+    std::memcpy(&va, a.data() + n, sizeof(va));
+    std::memcpy(&vb, b.data() + n, sizeof(vb));
+
+    const vfloat v = gain_a * va + gain_b * vb;
+
+    std::memcpy(output.data() + n, &v, sizeof(v));
+  }
+
+  for (; n < size; n++) {
+    output[n] = gain_a * a[n] + gain_b * b[n];
+  }
+}
+
+/*
+  The gains follow a sine curve and have to be evaluated per sample while the level moves. Only the blocks where the
+  fade happens run this loop, so it is left scalar.
+*/
+
+auto crossfade(std::span<float> wet, std::span<const float> dry, float level, const float& target, const float& step)
+    -> float {
+  const auto size = std::min(wet.size(), dry.size());
+
+  for (size_t n = 0U; n < size; n++) {
+    level = (target > level) ? std::min(level + step, target) : std::max(level - step, target);
+
+    const auto dry_gain = std::sin(0.5F * std::numbers::pi_v<float> * level);
+    const auto wet_gain = std::cos(0.5F * std::numbers::pi_v<float> * level);
+
+    wet[n] = wet_gain * wet[n] + dry_gain * dry[n];
+  }
+
+  return level;
+}
+
+}  // namespace dsp
@@ -60,6 +60,14 @@ auto main(int argc, char* argv[]) -> int {
       return errno;
     }
 
+    // The offline renderer loads the preset into memory instead of changing the settings of the running instance.
+
+    for (int n = 1; n < argc; n++) {
+      if (std::string(argv[n]) == "--render" || std::string(argv[n]).starts_with("--render=")) {
+        g_setenv("GSETTINGS_BACKEND", "memory", 1);
+      }
+    }
+
     auto* app = app::application_new();
 
     g_unix_signal_add(2, G_SOURCE_FUNC(sigterm), app);
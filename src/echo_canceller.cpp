@@ -21,16 +21,16 @@
 #include <gio/gio.h>
 #include <glib-object.h>
 #include <glib.h>
-#include <speex/speex_echo.h>
-#include <speex/speex_preprocess.h>
-#include <speex/speexdsp_config_types.h>
 #include <sys/types.h>
 #include <algorithm>
-#include <climits>
+#include <array>
 #include <cstddef>
 #include <mutex>
 #include <span>
 #include <string>
+#include "aec_engine.hpp"
+#include "dsp.hpp"
+#include "frame_adapter.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -43,14 +43,17 @@ EchoCanceller::EchoCanceller(const std::string& tag,
                              PipelineType pipe_type)
     : PluginBase(tag,
                  tags::plugin_name::echo_canceller,
-                 tags::plugin_package::speex,
+                 tags::plugin_package::ee,
                  schema,
                  schema_path,
                  pipe_manager,
                  pipe_type,
                  true),
-      residual_echo_suppression(g_settings_get_int(settings, "residual-echo-suppression")),
-      near_end_suppression(g_settings_get_int(settings, "near-end-suppression")) {
+      filter_length_ms(g_settings_get_int(settings, "filter-length")) {
+  aec.set_residual_echo_suppression(g_settings_get_int(settings, "residual-echo-suppression"));
+  aec.set_near_end_suppression(g_settings_get_int(settings, "near-end-suppression"));
+  aec.set_multithreading(g_settings_get_boolean(settings, "enable-multithreading") != 0);
+
   gconnections.push_back(g_signal_connect(settings, "changed::filter-length",
                                           G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                             auto* self = static_cast<EchoCanceller*>(user_data);
@@ -59,45 +62,42 @@ EchoCanceller::EchoCanceller(const std::string& tag,
 
                                             self->filter_length_ms = g_settings_get_int(settings, key);
 
-                                            self->init_speex();
+                                            self->init_aec();
                                           }),
                                           this));
 
-  gconnections.push_back(g_signal_connect(
-      settings, "changed::residual-echo-suppression",
-      G_CALLBACK(+[](GSettings* settings, char* key, EchoCanceller* self) {
-        std::scoped_lock<std::mutex> lock(self->data_mutex);
+  gconnections.push_back(g_signal_connect(settings, "changed::residual-echo-suppression",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, EchoCanceller* self) {
+                                            std::scoped_lock<std::mutex> lock(self->data_mutex);
 
-        self->residual_echo_suppression = g_settings_get_int(settings, key);
+                                            self->aec.set_residual_echo_suppression(g_settings_get_int(settings, key));
+                                          }),
+                                          this));
 
-        if (self->state_left) {
-          speex_preprocess_ctl(self->state_left, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS, &self->residual_echo_suppression);
-        }
+  gconnections.push_back(g_signal_connect(settings, "changed::near-end-suppression",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, EchoCanceller* self) {
+                                            std::scoped_lock<std::mutex> lock(self->data_mutex);
 
-        if (self->state_right) {
-          speex_preprocess_ctl(self->state_right, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS, &self->residual_echo_suppression);
-        }
-      }),
-      this));
+                                            self->aec.set_near_end_suppression(g_settings_get_int(settings, key));
+                                          }),
+                                          this));
 
   gconnections.push_back(g_signal_connect(
-      settings, "changed::near-end-suppression", G_CALLBACK(+[](GSettings* settings, char* key, EchoCanceller* self) {
+      settings, "changed::enable-multithreading", G_CALLBACK(+[](GSettings* settings, char* key, EchoCanceller* self) {
         std::scoped_lock<std::mutex> lock(self->data_mutex);
 
-        self->near_end_suppression = g_settings_get_int(settings, key);
+        self->aec.set_multithreading(g_settings_get_boolean(settings, key) != 0);
 
-        if (self->state_left) {
-          speex_preprocess_ctl(self->state_left, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS_ACTIVE,
-                               &self->near_end_suppression);
-        }
+        self->latency_n_frames = self->adapter.get_latency() + self->aec.get_latency();
 
-        if (self->state_right) {
-          speex_preprocess_ctl(self->state_right, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS_ACTIVE,
-                               &self->near_end_suppression);
-        }
+        self->notify_latency = true;
       }),
       this));
 
+  // The adapter is sized for the largest quantum, so a new one does not need a new setup.
+
+  quantum_independent = true;
+
   setup_input_output_gain();
 }
 
@@ -110,16 +110,6 @@ EchoCanceller::~EchoCanceller() {
 
   ready = false;
 
-  if (echo_state_L != nullptr) {
-    speex_echo_state_destroy(echo_state_L);
-  }
-
-  if (echo_state_R != nullptr) {
-    speex_echo_state_destroy(echo_state_R);
-  }
-
-  free_speex();
-
   data_mutex.unlock();
 
   util::debug(log_tag + name + " destroyed");
@@ -128,13 +118,22 @@ EchoCanceller::~EchoCanceller() {
 void EchoCanceller::setup() {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
-  ready = false;
+  /*
+    The engine runs at a fixed frame size and the adapter accepts blocks up to max_quantum, so only a new rate needs a
+    new engine. The filters are kept and do not have to converge again.
+  */
 
-  notify_latency = true;
+  if (!ready || rate != aec_rate) {
+    ready = false;
 
-  latency_n_frames = 0U;
+    init_aec();
+  }
+
+  adapter.set_max_block_size(max_quantum);
 
-  init_speex();
+  latency_n_frames = adapter.get_latency() + aec.get_latency();
+
+  notify_latency = true;
 }
 
 void EchoCanceller::process(std::span<float>& left_in,
@@ -156,40 +155,23 @@ void EchoCanceller::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  for (size_t j = 0U; j < left_in.size(); j++) {
-    data_L[j] = static_cast<spx_int16_t>(left_in[j] * (SHRT_MAX + 1));
-    data_R[j] = static_cast<spx_int16_t>(right_in[j] * (SHRT_MAX + 1));
+  const std::array<std::span<float>, 4U> inputs = {left_in, right_in, probe_left, probe_right};
+  const std::array<std::span<float>, 2U> outputs = {left_out, right_out};
 
-    /*
-      This is a very naive and not corect attempt to mitigate the shortcomes discussed at
-      https://github.com/wwmm/easyeffects/issues/1566.
-    */
-
-    probe_mono[j] = static_cast<spx_int16_t>(0.5F * (probe_left[j] + probe_right[j]) * (SHRT_MAX + 1));
-  }
-
-  speex_echo_cancellation(echo_state_L, data_L.data(), probe_mono.data(), filtered_L.data());
-  speex_echo_cancellation(echo_state_R, data_R.data(), probe_mono.data(), filtered_R.data());
-
-  speex_preprocess_run(state_left, filtered_L.data());
-  speex_preprocess_run(state_right, filtered_R.data());
-
-  for (size_t j = 0U; j < filtered_L.size(); j++) {
-    left_out[j] = static_cast<float>(filtered_L[j]) * inv_short_max;
-
-    right_out[j] = static_cast<float>(filtered_R[j]) * inv_short_max;
-  }
+  adapter.process(inputs, outputs, [this](auto frame_in, auto frame_out) { cancel_echo(frame_in, frame_out); });
 
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
   }
 
   if (notify_latency) {
-    const float latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
+    latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -211,84 +193,44 @@ void EchoCanceller::process(std::span<float>& left_in,
   }
 }
 
-void EchoCanceller::init_speex() {
-  if (n_samples == 0U || rate == 0U) {
-    return;
-  }
-
-  data_L.resize(n_samples);
-  data_R.resize(n_samples);
-  probe_mono.resize(n_samples);
-  filtered_L.resize(n_samples);
-  filtered_R.resize(n_samples);
-
-  const uint filter_length = static_cast<uint>(0.001F * static_cast<float>(filter_length_ms * rate));
-
-  util::debug(log_tag + name + " filter length: " + util::to_string(filter_length));
-
-  if (echo_state_L != nullptr) {
-    speex_echo_state_destroy(echo_state_L);
-  }
-
-  echo_state_L = speex_echo_state_init(static_cast<int>(n_samples), static_cast<int>(filter_length));
-
-  if (speex_echo_ctl(echo_state_L, SPEEX_ECHO_SET_SAMPLING_RATE, &rate) != 0) {
-    util::warning(log_tag + name + "SPEEX_ECHO_SET_SAMPLING_RATE: unknown request");
-  }
+void EchoCanceller::cancel_echo(std::span<const std::span<float>> frame_in,
+                                std::span<const std::span<float>> frame_out) {
+  // The adapter frames are scratch buffers, so the mono probe is mixed into the left probe frame.
 
-  if (echo_state_R != nullptr) {
-    speex_echo_state_destroy(echo_state_R);
-  }
-
-  echo_state_R = speex_echo_state_init(static_cast<int>(n_samples), static_cast<int>(filter_length));
-
-  if (speex_echo_ctl(echo_state_R, SPEEX_ECHO_SET_SAMPLING_RATE, &rate) != 0) {
-    util::warning(log_tag + name + "SPEEX_ECHO_SET_SAMPLING_RATE: unknown request");
-  }
+  dsp::mix(frame_in[2], 0.5F, frame_in[3], 0.5F, frame_in[2]);
 
-  if (state_left != nullptr) {
-    speex_preprocess_state_destroy(state_left);
-  }
+  aec.process(frame_in[0], frame_in[1], frame_in[2], frame_out[0], frame_out[1]);
+}
 
-  if (state_right != nullptr) {
-    speex_preprocess_state_destroy(state_right);
+void EchoCanceller::init_aec() {
+  if (n_samples == 0U || rate == 0U) {
+    return;
   }
 
-  state_left = speex_preprocess_state_init(static_cast<int>(n_samples), static_cast<int>(rate));
-  state_right = speex_preprocess_state_init(static_cast<int>(n_samples), static_cast<int>(rate));
+  const uint frame_size = rate * frame_size_ms / 1000U;
 
-  if (state_left != nullptr) {
-    speex_preprocess_ctl(state_left, SPEEX_PREPROCESS_SET_ECHO_STATE, echo_state_L);
+  adapter.set_frame_size(frame_size);
+  adapter.set_max_block_size(max_quantum);
 
-    speex_preprocess_ctl(state_left, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS, &residual_echo_suppression);
+  aec_rate = rate;
 
-    speex_preprocess_ctl(state_left, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS_ACTIVE, &near_end_suppression);
-  }
-
-  if (state_right != nullptr) {
-    speex_preprocess_ctl(state_right, SPEEX_PREPROCESS_SET_ECHO_STATE, echo_state_R);
+  util::debug(log_tag + name + " filter length: " + util::to_string(filter_length_ms) + " ms");
 
-    speex_preprocess_ctl(state_right, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS, &residual_echo_suppression);
-
-    speex_preprocess_ctl(state_right, SPEEX_PREPROCESS_SET_ECHO_SUPPRESS_ACTIVE, &near_end_suppression);
-  }
+  aec.init(rate, frame_size, filter_length_ms);
 
   ready = true;
 }
 
-void EchoCanceller::free_speex() {
-  if (state_left != nullptr) {
-    speex_preprocess_state_destroy(state_left);
-  }
+auto EchoCanceller::get_latency_seconds() -> float {
+  return latency_value;
+}
 
-  if (state_right != nullptr) {
-    speex_preprocess_state_destroy(state_right);
-  }
+auto EchoCanceller::get_tail_seconds() -> float {
+  // The adaptive filter keeps following the echo path of the probe while the microphone is muted.
 
-  state_left = nullptr;
-  state_right = nullptr;
+  return -1.0F;
 }
 
-auto EchoCanceller::get_latency_seconds() -> float {
-  return latency_value;
+auto EchoCanceller::get_quantum_preference(const uint& graph_rate) const -> QuantumPreference {
+  return {.frames = graph_rate * frame_size_ms / 1000U};
 }
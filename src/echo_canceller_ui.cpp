@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "echo_canceller.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -62,6 +63,8 @@ struct _EchoCancellerBox {
 
   GtkSpinButton *filter_length, *residual_echo_suppression, *near_end_suppression;
 
+  GtkSwitch* enable_multithreading;
+
   GSettings* settings;
 
   Data* data;
@@ -85,7 +88,7 @@ void setup(EchoCancellerBox* self, std::shared_ptr<EchoCanceller> echo_canceller
 
   self->data->echo_canceller = echo_canceller;
 
-  self->settings = g_settings_new_with_path(tags::schema::echo_canceller::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::echo_canceller::id, schema_path.c_str());
 
   echo_canceller->set_post_messages(true);
 
@@ -123,9 +126,9 @@ void setup(EchoCancellerBox* self, std::shared_ptr<EchoCanceller> echo_canceller
                      ui::get_plugin_credit_translated(self->data->echo_canceller->package).c_str());
 
   gsettings_bind_widgets<"input-gain", "output-gain", "filter-length", "residual-echo-suppression",
-                         "near-end-suppression">(self->settings, self->input_gain, self->output_gain,
-                                                 self->filter_length, self->residual_echo_suppression,
-                                                 self->near_end_suppression);
+                         "near-end-suppression", "enable-multithreading">(
+      self->settings, self->input_gain, self->output_gain, self->filter_length, self->residual_echo_suppression,
+      self->near_end_suppression, self->enable_multithreading);
 }
 
 void dispose(GObject* object) {
@@ -185,6 +188,7 @@ void echo_canceller_box_class_init(EchoCancellerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, filter_length);
   gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, residual_echo_suppression);
   gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, near_end_suppression);
+  gtk_widget_class_bind_template_child(widget_class, EchoCancellerBox, enable_multithreading);
 
   gtk_widget_class_bind_template_callback(widget_class, on_reset);
 }
@@ -22,11 +22,17 @@
 #include <glib-object.h>
 #include <glib.h>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <deque>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <ranges>
 #include <string>
 #include <utility>
+#include <vector>
 #include "autogain.hpp"
 #include "bass_enhancer.hpp"
 #include "bass_loudness.hpp"
@@ -59,6 +65,7 @@
 #include "speex.hpp"
 #include "stereo_tools.hpp"
 #include "tags_app.hpp"
+#include "tags_pipewire.hpp"
 #include "tags_plugin_name.hpp"
 #include "tags_schema.hpp"
 #include "util.hpp"
@@ -81,14 +88,6 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
   spectrum = std::make_shared<Spectrum>(log_tag, tags::schema::spectrum::id, tags::app::path + "/spectrum/"s, pm,
                                         pipeline_type);
 
-  if (!output_level->connected_to_pw) {
-    output_level->connect_to_pw();
-  }
-
-  if (!spectrum->connected_to_pw) {
-    spectrum->connect_to_pw();
-  }
-
   create_filters_if_necessary();
 
   gconnections.push_back(g_signal_connect(settings, "changed::plugins",
@@ -98,6 +97,16 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
                                             self->create_filters_if_necessary();
 
                                             self->broadcast_pipeline_latency();
+
+                                            self->update_quantum_request();
+                                          }),
+                                          this));
+
+  gconnections.push_back(g_signal_connect(settings, "changed::routing-rules",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                            auto* self = static_cast<EffectsBase*>(user_data);
+
+                                            self->apply_routing_rules();
                                           }),
                                           this));
 
@@ -115,6 +124,22 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
                                                  }),
                                                  this));
 
+  gconnections_global.push_back(g_signal_connect(
+      global_settings, "changed::standby-plugins", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+        auto* self = static_cast<EffectsBase*>(user_data);
+
+        self->release_unused_filters(util::gchar_array_to_vector(g_settings_get_strv(self->settings, "plugins")));
+      }),
+      this));
+
+  gconnections_global.push_back(g_signal_connect(global_settings, "changed::quantum-profile",
+                                                 G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                                   auto* self = static_cast<EffectsBase*>(user_data);
+
+                                                   self->update_quantum_request();
+                                                 }),
+                                                 this));
+
   gconnections_global.push_back(g_signal_connect(global_settings, "changed::lv2ui-update-frequency",
                                                  G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                                                    auto* self = static_cast<EffectsBase*>(user_data);
@@ -135,6 +160,8 @@ EffectsBase::EffectsBase(std::string tag, const std::string& schema, PipeManager
   for (auto& plugin : plugins | std::views::values) {
     plugin->notification_time_window = notification_time_window;
   }
+
+  update_quantum_request();
 }
 
 EffectsBase::~EffectsBase() {
@@ -177,78 +204,182 @@ void EffectsBase::create_filters_if_necessary() {
       continue;
     }
 
-    auto instance_id = util::to_string(tags::plugin_name::get_id(name));
-
-    auto path = schema_base_path + tags::plugin_name::get_base_name(name) + "/" + instance_id + "/";
-
-    path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
-
-    std::shared_ptr<PluginBase> filter;
-
-    if (name.starts_with(tags::plugin_name::autogain)) {
-      filter = std::make_shared<AutoGain>(log_tag, tags::schema::autogain::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::bass_enhancer)) {
-      filter = std::make_shared<BassEnhancer>(log_tag, tags::schema::bass_enhancer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::bass_loudness)) {
-      filter = std::make_shared<BassLoudness>(log_tag, tags::schema::bass_loudness::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::compressor)) {
-      filter = std::make_shared<Compressor>(log_tag, tags::schema::compressor::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::convolver)) {
-      filter = std::make_shared<Convolver>(log_tag, tags::schema::convolver::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::crossfeed)) {
-      filter = std::make_shared<Crossfeed>(log_tag, tags::schema::crossfeed::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::crystalizer)) {
-      filter = std::make_shared<Crystalizer>(log_tag, tags::schema::crystalizer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::deepfilternet)) {
-      filter = std::make_shared<DeepFilterNet>(log_tag, tags::schema::deepfilternet::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::deesser)) {
-      filter = std::make_shared<Deesser>(log_tag, tags::schema::deesser::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::delay)) {
-      filter = std::make_shared<Delay>(log_tag, tags::schema::delay::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
-      filter = std::make_shared<EchoCanceller>(log_tag, tags::schema::echo_canceller::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::exciter)) {
-      filter = std::make_shared<Exciter>(log_tag, tags::schema::exciter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::expander)) {
-      filter = std::make_shared<Expander>(log_tag, tags::schema::expander::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::equalizer)) {
-      filter = std::make_shared<Equalizer>(
-          log_tag, tags::schema::equalizer::id, path, tags::schema::equalizer::channel_id,
-          schema_base_path + "equalizer/" + instance_id + "/leftchannel/",
-          schema_base_path + "equalizer/" + instance_id + "/rightchannel/", pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::filter)) {
-      filter = std::make_shared<Filter>(log_tag, tags::schema::filter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::gate)) {
-      filter = std::make_shared<Gate>(log_tag, tags::schema::gate::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::level_meter)) {
-      filter = std::make_shared<LevelMeter>(log_tag, tags::schema::level_meter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::limiter)) {
-      filter = std::make_shared<Limiter>(log_tag, tags::schema::limiter::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::loudness)) {
-      filter = std::make_shared<Loudness>(log_tag, tags::schema::loudness::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::maximizer)) {
-      filter = std::make_shared<Maximizer>(log_tag, tags::schema::maximizer::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::multiband_compressor)) {
-      filter = std::make_shared<MultibandCompressor>(log_tag, tags::schema::multiband_compressor::id, path, pm,
-                                                     pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::multiband_gate)) {
-      filter = std::make_shared<MultibandGate>(log_tag, tags::schema::multiband_gate::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::pitch)) {
-      filter = std::make_shared<Pitch>(log_tag, tags::schema::pitch::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::reverb)) {
-      filter = std::make_shared<Reverb>(log_tag, tags::schema::reverb::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::rnnoise)) {
-      filter = std::make_shared<RNNoise>(log_tag, tags::schema::rnnoise::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::speex)) {
-      filter = std::make_shared<Speex>(log_tag, tags::schema::speex::id, path, pm, pipeline_type);
-    } else if (name.starts_with(tags::plugin_name::stereo_tools)) {
-      filter = std::make_shared<StereoTools>(log_tag, tags::schema::stereo_tools::id, path, pm, pipeline_type);
+    create_filter(name);
+  }
+}
+
+auto EffectsBase::make_plugin(const std::string& name,
+                              const std::string& tag,
+                              const std::string& base_path,
+                              PipeManager* pipe_manager,
+                              PipelineType pipe_type) -> std::shared_ptr<PluginBase> {
+  auto instance_id = util::to_string(tags::plugin_name::get_id(name));
+
+  auto path = base_path + tags::plugin_name::get_base_name(name) + "/" + instance_id + "/";
+
+  path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
+
+  std::shared_ptr<PluginBase> filter;
+
+  if (name.starts_with(tags::plugin_name::autogain)) {
+    filter = std::make_shared<AutoGain>(tag, tags::schema::autogain::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::bass_enhancer)) {
+    filter = std::make_shared<BassEnhancer>(tag, tags::schema::bass_enhancer::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::bass_loudness)) {
+    filter = std::make_shared<BassLoudness>(tag, tags::schema::bass_loudness::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::compressor)) {
+    filter = std::make_shared<Compressor>(tag, tags::schema::compressor::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::convolver)) {
+    filter = std::make_shared<Convolver>(tag, tags::schema::convolver::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::crossfeed)) {
+    filter = std::make_shared<Crossfeed>(tag, tags::schema::crossfeed::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::crystalizer)) {
+    filter = std::make_shared<Crystalizer>(tag, tags::schema::crystalizer::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::deepfilternet)) {
+    filter = std::make_shared<DeepFilterNet>(tag, tags::schema::deepfilternet::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::deesser)) {
+    filter = std::make_shared<Deesser>(tag, tags::schema::deesser::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::delay)) {
+    filter = std::make_shared<Delay>(tag, tags::schema::delay::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
+    filter = std::make_shared<EchoCanceller>(tag, tags::schema::echo_canceller::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::exciter)) {
+    filter = std::make_shared<Exciter>(tag, tags::schema::exciter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::expander)) {
+    filter = std::make_shared<Expander>(tag, tags::schema::expander::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::equalizer)) {
+    filter = std::make_shared<Equalizer>(
+        tag, tags::schema::equalizer::id, path, tags::schema::equalizer::channel_id,
+        base_path + "equalizer/" + instance_id + "/leftchannel/",
+        base_path + "equalizer/" + instance_id + "/rightchannel/", pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::filter)) {
+    filter = std::make_shared<Filter>(tag, tags::schema::filter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::gate)) {
+    filter = std::make_shared<Gate>(tag, tags::schema::gate::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::level_meter)) {
+    filter = std::make_shared<LevelMeter>(tag, tags::schema::level_meter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::limiter)) {
+    filter = std::make_shared<Limiter>(tag, tags::schema::limiter::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::loudness)) {
+    filter = std::make_shared<Loudness>(tag, tags::schema::loudness::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::maximizer)) {
+    filter = std::make_shared<Maximizer>(tag, tags::schema::maximizer::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::multiband_compressor)) {
+    filter = std::make_shared<MultibandCompressor>(tag, tags::schema::multiband_compressor::id, path, pipe_manager,
+                                                   pipe_type);
+  } else if (name.starts_with(tags::plugin_name::multiband_gate)) {
+    filter = std::make_shared<MultibandGate>(tag, tags::schema::multiband_gate::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::pitch)) {
+    filter = std::make_shared<Pitch>(tag, tags::schema::pitch::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::reverb)) {
+    filter = std::make_shared<Reverb>(tag, tags::schema::reverb::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::rnnoise)) {
+    filter = std::make_shared<RNNoise>(tag, tags::schema::rnnoise::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::speex)) {
+    filter = std::make_shared<Speex>(tag, tags::schema::speex::id, path, pipe_manager, pipe_type);
+  } else if (name.starts_with(tags::plugin_name::stereo_tools)) {
+    filter = std::make_shared<StereoTools>(tag, tags::schema::stereo_tools::id, path, pipe_manager, pipe_type);
+  }
+
+  return filter;
+}
+
+auto EffectsBase::create_filter(const std::string& name) -> std::shared_ptr<PluginBase> {
+  auto filter = make_plugin(name, log_tag, schema_base_path, pm, pipeline_type);
+
+  if (filter == nullptr) {
+    util::warning(log_tag + "the filter name " + name + " base name could not be recognized");
+
+    return nullptr;
+  }
+
+  connections.push_back(filter->latency.connect([this]() { broadcast_pipeline_latency(); }));
+
+  filter->global_bypass = bypass;
+
+  if (auto convolver_filter = std::dynamic_pointer_cast<Convolver>(filter)) {
+    connections.push_back(convolver_filter->section_changed.connect([this]() { relink_required.emit(); }));
+  }
+
+  plugins.insert(std::make_pair(name, filter));
+
+  return filter;
+}
+
+void EffectsBase::set_meters_enabled(const bool& state) {
+  if (state == meters_enabled) {
+    return;
+  }
+
+  meters_enabled = state;
+
+  // The meter nodes are only created when a window needs them for the first time.
+
+  if (meters_enabled) {
+    if (!output_level->connected_to_pw) {
+      output_level->connect_to_pw();
     }
 
-    connections.push_back(filter->latency.connect([this]() { broadcast_pipeline_latency(); }));
+    if (!spectrum->connected_to_pw) {
+      spectrum->connect_to_pw();
+    }
+  }
 
-    plugins.insert(std::make_pair(name, filter));
+  output_level->set_post_messages(meters_enabled);
+
+  relink_required.emit();
+}
+
+auto EffectsBase::get_meter_node_ids() -> std::vector<uint> {
+  if (!meters_enabled) {
+    return {};
+  }
+
+  return {spectrum->get_node_id(), output_level->get_node_id()};
+}
+
+void EffectsBase::set_bypass(const bool& state) {
+  bypass = state;
+
+  for (const auto& plugin : plugins | std::views::values) {
+    plugin->global_bypass = state;
+  }
+}
+
+auto EffectsBase::bake_linear_sections(const std::vector<std::string>& list) -> std::vector<std::string> {
+  std::vector<std::string> baked;
+
+  for (size_t n = 0U; n < list.size(); n++) {
+    if (!list[n].starts_with(tags::plugin_name::convolver) || !plugins.contains(list[n])) {
+      continue;
+    }
+
+    auto convolver_filter = std::dynamic_pointer_cast<Convolver>(plugins[list[n]]);
+
+    std::vector<std::string> names;
+    std::vector<std::shared_ptr<PluginBase>> section;
+
+    // The section goes back from the Convolver up to the first effect that can not be baked.
+
+    for (size_t m = n; convolver_filter->bake_linear_section && m > 0U; m--) {
+      const auto& name = list[m - 1U];
+
+      if (!plugins.contains(name) || !plugins[name]->bakeable) {
+        break;
+      }
+
+      names.insert(names.begin(), name);
+      section.insert(section.begin(), plugins[name]);
+    }
+
+    convolver_filter->set_linear_section(names, section);
+
+    if (!names.empty() && convolver_filter->get_baked_section() == names) {
+      baked.insert(baked.end(), names.begin(), names.end());
+    }
   }
+
+  return baked;
 }
 
 void EffectsBase::remove_unused_filters() {
@@ -281,6 +412,103 @@ void EffectsBase::remove_unused_filters() {
   }
 }
 
+void EffectsBase::release_unused_filters(const std::vector<std::string>& selected_plugins) {
+  /*
+    Filters that leave the pipeline are kept connected to PipeWire but unlinked. A standby filter is not scheduled by
+    PipeWire and costs no processing time, but it is ready to be linked again without waiting for a new node. The
+    most recently released filters are at the front of the standby list.
+  */
+
+  const auto is_selected = [&](const std::string& name) {
+    return std::ranges::find(selected_plugins, name) != selected_plugins.end();
+  };
+
+  std::erase_if(standby_plugins, is_selected);
+
+  for (const auto& [name, plugin] : plugins) {
+    if (!plugin->connected_to_pw || is_selected(name)) {
+      continue;
+    }
+
+    if (std::ranges::find(standby_plugins, name) != standby_plugins.end() ||
+        std::ranges::find(pinned_plugins, name) != pinned_plugins.end()) {
+      continue;
+    }
+
+    standby_plugins.push_front(name);
+  }
+
+  const auto limit = static_cast<size_t>(std::max(g_settings_get_int(global_settings, "standby-plugins"), 0));
+
+  while (standby_plugins.size() > limit) {
+    const auto name = standby_plugins.back();
+
+    standby_plugins.pop_back();
+
+    if (plugins.contains(name) && plugins[name]->connected_to_pw) {
+      util::debug(log_tag + "disconnecting the " + name + " filter from PipeWire");
+
+      plugins[name]->disconnect_from_pw();
+    }
+  }
+
+  for (const auto& name : standby_plugins) {
+    util::debug(log_tag + name + " filter is in standby");
+  }
+}
+
+auto EffectsBase::get_graph_clock() -> std::pair<uint, uint> {
+  for (const auto& [name, plugin] : plugins) {
+    const auto rate = plugin->requested_rate.load(std::memory_order_relaxed);
+    const auto n_samples = plugin->requested_n_samples.load(std::memory_order_relaxed);
+
+    if (rate != 0U && n_samples != 0U) {
+      return {rate, n_samples};
+    }
+  }
+
+  uint rate = 0U;
+  uint n_samples = 0U;
+
+  util::str_to_num(pm->default_clock_rate, rate);
+  util::str_to_num(pm->default_quantum, n_samples);
+
+  return {rate, n_samples};
+}
+
+void EffectsBase::set_pinned_filters(const std::vector<std::string>& names) {
+  pinned_plugins = names;
+
+  const auto [rate, n_samples] = get_graph_clock();
+
+  for (const auto& name : pinned_plugins) {
+    auto plugin = plugins.contains(name) ? plugins[name] : create_filter(name);
+
+    if (plugin == nullptr) {
+      continue;
+    }
+
+    std::erase(standby_plugins, name);
+
+    if (!plugin->connected_to_pw) {
+      plugin->connect_to_pw();
+    }
+
+    /*
+      An unlinked node is not scheduled, so its realtime thread would only ask for a setup after the preset is
+      linked, and the dry signal would be heard until it is done. The setup thread configures it now instead.
+    */
+
+    if (rate != 0U && n_samples != 0U && plugin->requested_rate.load(std::memory_order_relaxed) == 0U) {
+      plugin->request_setup(rate, n_samples);
+    }
+  }
+
+  // filters that are not pinned anymore go through the standby list like any other released filter
+
+  release_unused_filters(util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins")));
+}
+
 void EffectsBase::activate_filters() {
   for (auto& plugin : plugins | std::views::values) {
     plugin->set_active(true);
@@ -305,6 +533,59 @@ auto EffectsBase::get_pipeline_latency() -> float {
   return total * 1000.0F;
 }
 
+/*
+  node.latency is a fraction of a second, so the request is computed at 48 kHz and PipeWire converts it to the rate of
+  the graph. When the pipeline has both frame based effects and effects that need powers of two the frames win. They
+  would buffer a whole frame, while the others only buffer part of a partition.
+*/
+
+void EffectsBase::update_quantum_request() {
+  constexpr uint graph_rate = 48000U;
+
+  const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  uint frames = 0U;
+  uint power_of_two = 0U;
+
+  for (const auto& name : list) {
+    if (!plugins.contains(name)) {
+      continue;
+    }
+
+    const auto preference = plugins[name]->get_quantum_preference(graph_rate);
+
+    if (preference.frames == 0U) {
+      continue;
+    }
+
+    if (preference.power_of_two) {
+      power_of_two = std::max(power_of_two, preference.frames);
+    } else {
+      frames = (frames == 0U) ? preference.frames : std::lcm(frames, preference.frames);
+    }
+  }
+
+  uint quantum = 0U;
+
+  if (const auto profile = g_settings_get_enum(global_settings, "quantum-profile"); profile != 0) {
+    const uint target = (profile == 1) ? 256U : 1024U;
+
+    if (frames != 0U) {
+      quantum = frames * std::max(1U, (target + frames - 1U) / frames);
+    } else if (power_of_two != 0U) {
+      quantum = std::bit_ceil(std::max(target, power_of_two));
+    }
+  }
+
+  for (const auto& [name, plugin] : plugins) {
+    plugin->set_node_latency((std::ranges::find(list, name) != list.end()) ? quantum : 0U, graph_rate);
+  }
+
+  if (quantum != 0U) {
+    util::debug(log_tag + "requesting a quantum of " + util::to_string(quantum) + " samples at 48 kHz");
+  }
+}
+
 void EffectsBase::broadcast_pipeline_latency() {
   const auto latency_value = get_pipeline_latency();
 
@@ -316,3 +597,76 @@ void EffectsBase::broadcast_pipeline_latency() {
 auto EffectsBase::get_plugins_map() -> std::map<std::string, std::shared_ptr<PluginBase>> {
   return plugins;
 }
+
+auto EffectsBase::get_route(const NodeInfo& node_info) -> Route {
+  auto* rules = g_settings_get_value(settings, "routing-rules");
+
+  GVariantIter iter;
+
+  g_variant_iter_init(&iter, rules);
+
+  const gchar *pattern = nullptr, *target = nullptr;
+
+  auto route = Route::none;
+
+  while (route == Route::none && g_variant_iter_next(&iter, "(&s&s)", &pattern, &target)) {
+    const auto matches = std::ranges::any_of(
+        std::array{&node_info.application_id, &node_info.app_name, &node_info.app_process_binary, &node_info.name},
+        [&](const std::string* value) {
+          return !value->empty() && g_pattern_match_simple(pattern, value->c_str()) != 0;
+        });
+
+    if (!matches) {
+      continue;
+    }
+
+    if (g_strcmp0(target, "effects") == 0) {
+      route = Route::effects;
+    } else if (g_strcmp0(target, "device") == 0) {
+      route = Route::device;
+    } else {
+      util::warning(log_tag + "unknown routing target: " + target);
+    }
+  }
+
+  g_variant_unref(rules);
+
+  return route;
+}
+
+void EffectsBase::apply_routing_rules() {
+  const auto* media_class = (pipeline_type == PipelineType::output) ? tags::pipewire::media_class::output_stream
+                                                                    : tags::pipewire::media_class::input_stream;
+
+  std::vector<NodeInfo> streams;
+
+  for (const auto& node : pm->node_map | std::views::values) {
+    if (node.media_class == media_class) {
+      streams.push_back(node);
+    }
+  }
+
+  for (const auto& node : streams) {
+    const auto route = get_route(node);
+
+    if (route == Route::none) {
+      continue;
+    }
+
+    const auto connected = pm->stream_is_connected(node.id, media_class);
+
+    if (route == Route::effects && !connected) {
+      util::debug(log_tag + node.name + " is routed to the effects");
+
+      if (pipeline_type == PipelineType::output) {
+        pm->connect_stream_output(node.id);
+      } else {
+        pm->connect_stream_input(node.id);
+      }
+    } else if (route == Route::device && connected) {
+      util::debug(log_tag + node.name + " is routed to the device");
+
+      pm->disconnect_stream(node.id);
+    }
+  }
+}
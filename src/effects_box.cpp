@@ -27,8 +27,6 @@
 #include <glib.h>
 #include <glib/gi18n.h>
 #include <gobject/gobject.h>
-#include <gsl/gsl_interp.h>
-#include <gsl/gsl_spline.h>
 #include <gtk/gtk.h>
 #include <gtk/gtkshortcut.h>
 #include <sigc++/connection.h>
@@ -66,11 +64,11 @@ struct Data {
 
   PipelineType pipeline_type;
 
-  uint spectrum_rate, spectrum_n_bands;
+  uint spectrum_serial;
 
   float global_output_level_left, global_output_level_right, pipeline_latency_ms;
 
-  std::vector<double> spectrum_mag, spectrum_x_axis, spectrum_freqs;
+  std::vector<double> spectrum_mag, spectrum_x_axis;
 
   std::vector<sigc::connection> connections;
 
@@ -110,36 +108,18 @@ struct _EffectsBox {
 // NOLINTNEXTLINE
 G_DEFINE_TYPE(EffectsBox, effects_box, GTK_TYPE_BOX)
 
-void init_spectrum_frequency_axis(EffectsBox* self) {
-  self->data->spectrum_freqs.resize(self->data->spectrum_n_bands);
-
-  for (uint n = 0U; n < self->data->spectrum_n_bands; n++) {
-    self->data->spectrum_freqs[n] = 0.5F * static_cast<float>(self->data->spectrum_rate) * static_cast<float>(n) /
-                                    static_cast<float>(self->data->spectrum_n_bands);
-  }
-
-  if (!self->data->spectrum_freqs.empty()) {
-    const auto min_freq = static_cast<float>(g_settings_get_int(self->settings_spectrum, "minimum-frequency"));
-    const auto max_freq = static_cast<float>(g_settings_get_int(self->settings_spectrum, "maximum-frequency"));
-
-    if (min_freq > (max_freq - 100.0F)) {
-      return;
-    }
-
-    auto log_x_axis = util::logspace(min_freq, max_freq, g_settings_get_int(self->settings_spectrum, "n-points"));
+// The display frequencies are chosen by the spectrum plugin. They change with the rate and with the axis settings.
 
-    self->data->spectrum_x_axis.resize(log_x_axis.size());
-    self->data->spectrum_mag.resize(log_x_axis.size());
+void init_spectrum_frequency_axis(EffectsBox* self) {
+  self->data->spectrum_x_axis = self->data->effects_base->spectrum->get_frequencies();
 
-    std::copy(log_x_axis.begin(), log_x_axis.end(), self->data->spectrum_x_axis.begin());
+  self->data->spectrum_mag.resize(self->data->spectrum_x_axis.size());
 
-    ui::chart::set_x_data(self->spectrum_chart, self->data->spectrum_x_axis);
-  }
+  ui::chart::set_x_data(self->spectrum_chart, self->data->spectrum_x_axis);
 }
 
 void setup_spectrum(EffectsBox* self) {
-  self->data->spectrum_rate = 0U;
-  self->data->spectrum_n_bands = 0U;
+  self->data->spectrum_serial = 0U;
 
   ui::chart::set_color(self->spectrum_chart, util::gsettings_get_color(self->settings_spectrum, "color"));
 
@@ -252,32 +232,6 @@ void setup_spectrum(EffectsBox* self) {
         }
       }),
       self));
-
-  self->data->gconnections_spectrum.push_back(g_signal_connect(
-      self->settings_spectrum, "changed::n-points", G_CALLBACK(+[](GSettings* settings, char* key, EffectsBox* self) {
-        g_object_ref(self);
-
-        util::idle_add([=]() { init_spectrum_frequency_axis(self); }, [=]() { g_object_unref(self); });
-      }),
-      self));
-
-  self->data->gconnections_spectrum.push_back(
-      g_signal_connect(self->settings_spectrum, "changed::minimum-frequency",
-                       G_CALLBACK(+[](GSettings* settings, char* key, EffectsBox* self) {
-                         g_object_ref(self);
-
-                         util::idle_add([=]() { init_spectrum_frequency_axis(self); }, [=]() { g_object_unref(self); });
-                       }),
-                       self));
-
-  self->data->gconnections_spectrum.push_back(
-      g_signal_connect(self->settings_spectrum, "changed::maximum-frequency",
-                       G_CALLBACK(+[](GSettings* settings, char* key, EffectsBox* self) {
-                         g_object_ref(self);
-
-                         util::idle_add([=]() { init_spectrum_frequency_axis(self); }, [=]() { g_object_unref(self); });
-                       }),
-                       self));
 }
 
 void stack_visible_child_changed(EffectsBox* self, GParamSpec* pspec, GtkWidget* stack) {
@@ -396,7 +350,7 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
   // spectrum array
 
   self->data->connections.push_back(
-      self->data->effects_base->spectrum->power.connect([=](uint rate, uint n_bands, std::vector<double> magnitudes) {
+      self->data->effects_base->spectrum->power.connect([=](uint serial, std::vector<float> magnitudes) {
         if (self == nullptr) {
           return;
         }
@@ -409,35 +363,19 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
           return;
         }
 
-        if (self->data->spectrum_rate != rate || self->data->spectrum_n_bands != n_bands) {
-          self->data->spectrum_rate = rate;
-          self->data->spectrum_n_bands = n_bands;
+        if (self->data->spectrum_serial != serial) {
+          self->data->spectrum_serial = serial;
 
           init_spectrum_frequency_axis(self);
         }
 
-        auto* acc = gsl_interp_accel_alloc();
-        auto* spline = gsl_spline_alloc(gsl_interp_steffen, n_bands);
-
-        gsl_spline_init(spline, self->data->spectrum_freqs.data(), magnitudes.data(), n_bands);
+        // The frequencies may have changed again after these magnitudes were computed.
 
-        for (size_t n = 0; n < self->data->spectrum_x_axis.size(); n++) {
-          self->data->spectrum_mag[n] =
-              static_cast<float>(gsl_spline_eval(spline, self->data->spectrum_x_axis[n], acc));
+        if (magnitudes.size() != self->data->spectrum_mag.size()) {
+          return;
         }
 
-        gsl_spline_free(spline);
-        gsl_interp_accel_free(acc);
-
-        std::ranges::for_each(self->data->spectrum_mag, [](auto& v) {
-          v = 10.0F * std::log10(v);
-
-          if (!std::isinf(v)) {
-            v = (v > util::minimum_db_level) ? v : util::minimum_db_level;
-          } else {
-            v = util::minimum_db_level;
-          }
-        });
+        std::ranges::copy(magnitudes, self->data->spectrum_mag.begin());
 
         ui::chart::set_y_data(self->spectrum_chart, self->data->spectrum_mag);
       }));
@@ -446,7 +384,7 @@ void setup(EffectsBox* self, app::Application* application, PipelineType pipelin
 
   self->data->effects_base->spectrum->bypass = g_settings_get_boolean(self->settings_spectrum, "show") == 0;
 
-  self->data->effects_base->output_level->set_post_messages(true);
+  self->data->effects_base->set_meters_enabled(true);
 
   // pipeline latency
 
@@ -497,6 +435,8 @@ void dispose(GObject* object) {
 
   self->data->effects_base->spectrum->bypass = true;
 
+  self->data->effects_base->set_meters_enabled(false);
+
   for (auto& c : self->data->connections) {
     c.disconnect();
   }
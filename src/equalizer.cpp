@@ -23,15 +23,20 @@
 #include <glib.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <span>
 #include <string>
 #include <utility>
 #include <vector>
+#include "biquad_equalizer.hpp"
+#include "dsp.hpp"
 #include "lv2_wrapper.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
+#include "settings_store.hpp"
 #include "tags_equalizer.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
@@ -53,16 +58,20 @@ Equalizer::Equalizer(const std::string& tag,
                  schema_path,
                  pipe_manager,
                  pipe_type),
-      settings_left(g_settings_new_with_path(schema_channel.c_str(), schema_channel_left_path.c_str())),
-      settings_right(g_settings_new_with_path(schema_channel.c_str(), schema_channel_right_path.c_str())) {
+      settings_left(settings_store::get(schema_channel.c_str(), schema_channel_left_path.c_str())),
+      settings_right(settings_store::get(schema_channel.c_str(), schema_channel_right_path.c_str())),
+      biquad(std::make_unique<BiquadEqualizer>()) {
   lv2_wrapper = std::make_unique<lv2::Lv2Wrapper>("http://lsp-plug.in/plugins/lv2/para_equalizer_x32_lr");
 
-  package_installed = lv2_wrapper->found_plugin;
+  // Without the LSP plugin the built-in engine takes over.
 
-  if (!package_installed) {
+  if (!lv2_wrapper->found_plugin) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/para_equalizer_x32_lr is not installed");
+    util::debug(log_tag + name + " will use the built-in biquad engine");
   }
 
+  quantum_independent = true;
+
   lv2_wrapper->bind_key_enum<"mode", "mode">(settings);
 
   lv2_wrapper->bind_key_double<"bal", "balance">(settings);
@@ -71,7 +80,7 @@ Equalizer::Equalizer(const std::string& tag,
 
   lv2_wrapper->bind_key_double<"frqs_r", "pitch-right">(settings);
 
-  bind_bands(std::make_index_sequence<max_bands>());
+  bind_bands(std::make_index_sequence<lv2_max_bands>());
 
   on_split_channels();
 
@@ -102,6 +111,25 @@ Equalizer::Equalizer(const std::string& tag,
       settings, "changed::split-channels",
       G_CALLBACK(+[](GSettings* settings, char* key, Equalizer* self) { self->on_split_channels(); }), this));
 
+  // The bands are stored in the channel schemas. Their changes also affect the baked impulse response.
+
+  for (auto* channel_settings : {settings_left, settings_right}) {
+    g_signal_connect(channel_settings, "changed", G_CALLBACK(+[](GSettings* settings, char* key, Equalizer* self) {
+                       self->schedule_biquad_update(true);
+                     }),
+                     this);
+  }
+
+  gconnections.push_back(g_signal_connect(settings, "changed",
+                                          G_CALLBACK(+[](GSettings* settings, char* key, Equalizer* self) {
+                                            self->schedule_biquad_update(false);
+                                          }),
+                                          this));
+
+  update_biquad();
+
+  bakeable = true;
+
   setup_input_output_gain();
 }
 
@@ -116,6 +144,13 @@ Equalizer::~Equalizer() {
 
   this->gconnections_unified.clear();
 
+  g_signal_handlers_disconnect_by_data(settings_left, this);
+  g_signal_handlers_disconnect_by_data(settings_right, this);
+
+  if (biquad_source_id != 0U) {
+    g_source_remove(biquad_source_id);
+  }
+
   util::debug(log_tag + name + " destroyed");
 }
 
@@ -226,7 +261,121 @@ void Equalizer::on_split_channels() {
   }
 }
 
+auto Equalizer::read_bands(GSettings* channel_settings, const double& pitch) -> std::vector<BiquadEqualizer::Band> {
+  using namespace tags::equalizer;
+
+  const auto nbands = std::clamp(static_cast<uint>(g_settings_get_int(settings, "num-bands")), 1U, max_bands);
+
+  // The pitch is given in semitones and moves all the bands of the channel.
+
+  const auto shift = std::exp2(pitch / 12.0);
+
+  std::vector<BiquadEqualizer::Band> bands(nbands);
+
+  for (uint n = 0U; n < nbands; n++) {
+    bands[n] = {
+        .type = static_cast<BiquadEqualizer::BandType>(g_settings_get_enum(channel_settings, band_type[n].data())),
+        .mode = static_cast<BiquadEqualizer::BandMode>(g_settings_get_enum(channel_settings, band_mode[n].data())),
+        .slope = static_cast<uint>(g_settings_get_enum(channel_settings, band_slope[n].data())) + 1U,
+        .frequency = g_settings_get_double(channel_settings, band_frequency[n].data()) * shift,
+        .gain = g_settings_get_double(channel_settings, band_gain[n].data()),
+        .q = g_settings_get_double(channel_settings, band_q[n].data()),
+        .width = g_settings_get_double(channel_settings, band_width[n].data()),
+        .solo = g_settings_get_boolean(channel_settings, band_solo[n].data()) != 0,
+        .mute = g_settings_get_boolean(channel_settings, band_mute[n].data()) != 0};
+  }
+
+  return bands;
+}
+
+void Equalizer::schedule_biquad_update(const bool& response) {
+  response_pending = response_pending || response;
+
+  if (biquad_source_id != 0U) {
+    return;
+  }
+
+  biquad_source_id = g_idle_add(GSourceFunc(+[](Equalizer* self) {
+                                  self->biquad_source_id = 0U;
+
+                                  self->update_biquad();
+
+                                  if (self->response_pending) {
+                                    self->response_pending = false;
+
+                                    self->response_changed.emit();
+                                  }
+
+                                  return G_SOURCE_REMOVE;
+                                }),
+                                this);
+}
+
+void Equalizer::update_biquad() {
+  const auto nbands = static_cast<uint>(g_settings_get_int(settings, "num-bands"));
+
+  const auto balance = static_cast<float>(g_settings_get_double(settings, "balance")) / 100.0F;
+
+  const auto needed = !lv2_wrapper->found_plugin || nbands > lv2_max_bands;
+
+  if (!needed) {
+    std::scoped_lock<std::mutex> lock(data_mutex);
+
+    use_biquad = false;
+
+    return;
+  }
+
+  // The sections are designed without the lock. It is only taken to read the rate and to swap them in.
+
+  data_mutex.lock();
+
+  const auto current_rate = biquad->get_rate();
+
+  data_mutex.unlock();
+
+  BiquadEqualizer staging;
+
+  staging.set_bands(read_bands(settings_left, g_settings_get_double(settings, "pitch-left")),
+                    read_bands(settings_right, g_settings_get_double(settings, "pitch-right")));
+
+  staging.set_rate(current_rate);
+
+  bool rate_changed = false;
+
+  {
+    std::scoped_lock<std::mutex> lock(data_mutex);
+
+    rate_changed = biquad->get_rate() != current_rate;
+
+    if (!rate_changed) {
+      biquad->swap_design(staging);
+
+      use_biquad = true;
+
+      balance_left = std::min(1.0F, 1.0F - balance);
+      balance_right = std::min(1.0F, 1.0F + balance);
+    }
+  }
+
+  // The setup thread changed the rate in the meantime. The bands are designed again for the new one.
+
+  if (rate_changed) {
+    schedule_biquad_update(false);
+  }
+}
+
 void Equalizer::setup() {
+  {
+    std::scoped_lock<std::mutex> lock(data_mutex);
+
+    biquad->set_n_samples(n_samples);
+
+    if (biquad->get_rate() != rate) {
+      biquad->set_rate(rate);
+    }
+  }
+
   if (!lv2_wrapper->found_plugin) {
     return;
   }
@@ -242,7 +391,9 @@ void Equalizer::process(std::span<float>& left_in,
                         std::span<float>& right_in,
                         std::span<float>& left_out,
                         std::span<float>& right_out) {
-  if (!lv2_wrapper->found_plugin || !lv2_wrapper->has_instance() || bypass) {
+  std::scoped_lock<std::mutex> lock(data_mutex);
+
+  if (bypass || (!use_biquad && !lv2_wrapper->has_instance())) {
     std::copy(left_in.begin(), left_in.end(), left_out.begin());
     std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
@@ -253,18 +404,27 @@ void Equalizer::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  lv2_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
-  lv2_wrapper->run();
+  if (use_biquad) {
+    biquad->process(left_in, right_in, left_out, right_out);
+
+    if (balance_left != 1.0F || balance_right != 1.0F) {
+      dsp::scale(left_out, balance_left);
+      dsp::scale(right_out, balance_right);
+    }
+  } else {
+    lv2_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
+    lv2_wrapper->run();
+  }
 
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
   }
 
   /*
-    This plugin gives the latency in number of samples
+    The LSP plugin gives the latency in number of samples. The biquad cascade has none.
   */
 
-  const auto lv = static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
+  const auto lv = use_biquad ? 0U : static_cast<uint>(lv2_wrapper->get_control_port_value("out_latency"));
 
   if (latency_n_frames != lv) {
     latency_n_frames = lv;
@@ -274,6 +434,8 @@ void Equalizer::process(std::span<float>& left_in,
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -354,3 +516,59 @@ void Equalizer::sort_bands() {
 auto Equalizer::get_latency_seconds() -> float {
   return latency_value;
 }
+
+auto Equalizer::prepare_bake() -> Bake {
+  data_mutex.lock();
+
+  const auto native = use_biquad;
+  const auto bands = biquad->get_bands();
+  const auto gain_left = balance_left;
+  const auto gain_right = balance_right;
+
+  data_mutex.unlock();
+
+  if (!native) {
+    return PluginBase::prepare_bake();
+  }
+
+  return [bands, gain_left, gain_right, bypassed = bypass, gain_in = input_gain, gain_out = output_gain](
+             const uint& bake_rate, std::vector<float>& left, std::vector<float>& right) {
+    if (bake_rate == 0U) {
+      return false;
+    }
+
+    if (bypassed) {
+      return true;
+    }
+
+    BiquadEqualizer offline;
+
+    offline.set_n_samples(512U);
+    offline.set_rate(bake_rate);
+    offline.set_bands(bands.first, bands.second);
+
+    std::span<float> span_L(left);
+    std::span<float> span_R(right);
+
+    apply_gain(span_L, span_R, gain_in);
+
+    offline.process(span_L, span_R, span_L, span_R);
+
+    dsp::scale(left, gain_left * gain_out);
+    dsp::scale(right, gain_right * gain_out);
+
+    return true;
+  };
+}
+
+auto Equalizer::get_frequency_response(const std::vector<double>& frequencies)
+    -> std::pair<std::vector<double>, std::vector<double>> {
+  BiquadEqualizer response;
+
+  response.set_rate(rate != 0U ? rate : 48000U);
+
+  response.set_bands(read_bands(settings_left, g_settings_get_double(settings, "pitch-left")),
+                     read_bands(settings_right, g_settings_get_double(settings, "pitch-right")));
+
+  return {response.get_response(frequencies, 0U), response.get_response(frequencies, 1U)};
+}
@@ -54,6 +54,14 @@ EqualizerPreset::EqualizerPreset(PresetType preset_type, const int& index)
       (tags::schema::equalizer::output_path + util::to_string(index) + "/rightchannel/").c_str());
 
   instance_name.assign(tags::plugin_name::equalizer).append("#").append(util::to_string(index));
+
+  if (preset_type == PresetType::input) {
+    transaction_settings.push_back(input_settings_left);
+    transaction_settings.push_back(input_settings_right);
+  } else {
+    transaction_settings.push_back(output_settings_left);
+    transaction_settings.push_back(output_settings_right);
+  }
 }
 
 EqualizerPreset::~EqualizerPreset() {
@@ -136,7 +144,9 @@ void EqualizerPreset::load(const nlohmann::json& json) {
 
   update_key<double>(json.at(section).at(instance_name), settings, "pitch-right", "pitch-right");
 
-  const auto nbands = g_settings_get_int(settings, "num-bands");
+  // The staged value is not in the settings yet.
+
+  const auto nbands = json.at(section).at(instance_name).value("num-bands", get_default<int>(settings, "num-bands"));
 
   if (section == "input") {
     load_channel(json.at(section).at(instance_name).at("left"), input_settings_left, nbands);
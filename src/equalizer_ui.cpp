@@ -45,8 +45,10 @@
 #include <unordered_map>
 #include <vector>
 #include "application.hpp"
+#include "chart.hpp"
 #include "equalizer.hpp"
 #include "equalizer_band_box.hpp"
+#include "settings_store.hpp"
 #include "tags_equalizer.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -89,10 +91,14 @@ struct Data {
 
   uint serial = 0U;
 
+  guint response_source_id = 0U;
+
   app::Application* application{};
 
   std::shared_ptr<Equalizer> equalizer;
 
+  std::vector<double> freq_axis;
+
   std::vector<sigc::connection> connections;
 
   std::vector<gulong> gconnections;
@@ -112,6 +118,10 @@ struct _EqualizerBox {
 
   GtkStack* stack;
 
+  GtkBox* chart_box;
+
+  ui::chart::Chart* chart;
+
   GtkListView *listview_left, *listview_right;
 
   GtkSpinButton *nbands, *balance, *pitch_left, *pitch_right;
@@ -826,6 +836,33 @@ void on_sort_bands(EqualizerBox* self, GtkButton* btn) {
   self->data->equalizer->sort_bands();
 }
 
+void update_response(EqualizerBox* self) {
+  const auto [left, right] = self->data->equalizer->get_frequency_response(self->data->freq_axis);
+
+  const auto show_right = g_settings_get_boolean(self->settings, "split-channels") != 0 &&
+                          g_strcmp0(gtk_stack_get_visible_child_name(self->stack), "page_right_channel") == 0;
+
+  ui::chart::set_x_data(self->chart, self->data->freq_axis);
+  ui::chart::set_y_data(self->chart, show_right ? right : left);
+}
+
+// Importing a preset changes hundreds of keys. The response is computed once they settle.
+
+void schedule_response_update(EqualizerBox* self) {
+  if (self->data->response_source_id != 0U) {
+    return;
+  }
+
+  self->data->response_source_id = g_timeout_add(100, GSourceFunc(+[](EqualizerBox* self) {
+                                                    self->data->response_source_id = 0U;
+
+                                                    update_response(self);
+
+                                                    return G_SOURCE_REMOVE;
+                                                  }),
+                                                  self);
+}
+
 template <Channel channel>
 void setup_listview(EqualizerBox* self) {
   auto* factory = gtk_signal_list_item_factory_new();
@@ -890,13 +927,13 @@ void setup(EqualizerBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::equalizer::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::equalizer::id, schema_path.c_str());
 
   self->settings_left =
-      g_settings_new_with_path(tags::schema::equalizer::channel_id, (schema_path + "leftchannel/").c_str());
+      settings_store::get(tags::schema::equalizer::channel_id, (schema_path + "leftchannel/").c_str());
 
   self->settings_right =
-      g_settings_new_with_path(tags::schema::equalizer::channel_id, (schema_path + "rightchannel/").c_str());
+      settings_store::get(tags::schema::equalizer::channel_id, (schema_path + "rightchannel/").c_str());
 
   equalizer->set_post_messages(true);
 
@@ -905,6 +942,12 @@ void setup(EqualizerBox* self,
 
   build_all_bands(self);
 
+  self->data->freq_axis = util::logspace(20.0, 20000.0, 500U);
+
+  update_response(self);
+
+  self->data->connections.push_back(equalizer->response_changed.connect([=]() { schedule_response_update(self); }));
+
   self->data->connections.push_back(equalizer->input_level.connect([=](const float left, const float right) {
     g_object_ref(self);
 
@@ -969,6 +1012,10 @@ void setup(EqualizerBox* self,
         build_all_bands(self);
       }),
       self));
+
+  g_signal_connect(self->stack, "notify::visible-child-name",
+                   G_CALLBACK(+[](GtkStack* stack, GParamSpec* pspec, EqualizerBox* self) { update_response(self); }),
+                   self);
 }
 
 void dispose(GObject* object) {
@@ -978,6 +1025,14 @@ void dispose(GObject* object) {
 
   set_ignore_filter_idle_add(self->data->serial, true);
 
+  if (self->data->response_source_id != 0U) {
+    g_source_remove(self->data->response_source_id);
+
+    self->data->response_source_id = 0U;
+  }
+
+  g_signal_handlers_disconnect_by_data(self->stack, self);
+
   for (auto& c : self->data->connections) {
     c.disconnect();
   }
@@ -1031,6 +1086,7 @@ void equalizer_box_class_init(EqualizerBoxClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, plugin_credit);
 
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, stack);
+  gtk_widget_class_bind_template_child(widget_class, EqualizerBox, chart_box);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, listview_left);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, listview_right);
   gtk_widget_class_bind_template_child(widget_class, EqualizerBox, string_list_left);
@@ -1065,6 +1121,21 @@ void equalizer_box_init(EqualizerBox* self) {
   prepare_spinbuttons<"st">(self->pitch_left, self->pitch_right);
 
   prepare_scales<"dB">(self->input_gain, self->output_gain);
+
+  self->chart = ui::chart::create();
+
+  gtk_widget_set_vexpand(GTK_WIDGET(self->chart), 1);
+
+  ui::chart::set_chart_type(self->chart, ui::chart::ChartType::line);
+  ui::chart::set_chart_scale(self->chart, ui::chart::ChartScale::logarithmic);
+  ui::chart::set_fill_bars(self->chart, false);
+  ui::chart::set_line_width(self->chart, 2.0F);
+  ui::chart::set_n_x_decimals(self->chart, 0);
+  ui::chart::set_n_y_decimals(self->chart, 1);
+  ui::chart::set_x_unit(self->chart, "Hz");
+  ui::chart::set_y_unit(self->chart, "dB");
+
+  gtk_box_append(self->chart_box, GTK_WIDGET(self->chart));
 }
 
 auto create() -> EqualizerBox* {
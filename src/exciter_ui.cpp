@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 #include "exciter.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -94,7 +95,7 @@ void setup(ExciterBox* self, std::shared_ptr<Exciter> exciter, const std::string
 
   self->data->exciter = exciter;
 
-  self->settings = g_settings_new_with_path(tags::schema::exciter::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::exciter::id, schema_path.c_str());
 
   exciter->set_post_messages(true);
 
@@ -38,6 +38,7 @@
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -137,7 +138,7 @@ void setup(ExpanderBox* self, std::shared_ptr<Expander> expander, const std::str
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::expander::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::expander::id, schema_path.c_str());
 
   expander->set_post_messages(true);
 
@@ -44,6 +44,8 @@ Filter::Filter(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_independent = true;
+
   if (!package_installed) {
     util::debug(log_tag + "http://lsp-plug.in/plugins/lv2/sc_gate_stereo is not installed");
   }
@@ -66,6 +68,8 @@ Filter::Filter(const std::string& tag,
 
   lv2_wrapper->bind_key_enum<"s", "slope">(settings);
 
+  bakeable = true;
+
   setup_input_output_gain();
 
   // g_timeout_add_seconds(1, GSourceFunc(+[](Filter* self) {
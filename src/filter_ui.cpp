@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 #include "filter.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -98,7 +99,7 @@ void setup(FilterBox* self, std::shared_ptr<Filter> filter, const std::string& s
 
   self->data->filter = filter;
 
-  self->settings = g_settings_new_with_path(tags::schema::filter::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::filter::id, schema_path.c_str());
 
   filter->set_post_messages(true);
 
@@ -24,10 +24,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <mutex>
 #include <numbers>
 #include <string>
 #include <utility>
 #include <vector>
+#include "fftw_planner.hpp"
 #include "util.hpp"
 
 namespace {
@@ -46,6 +48,8 @@ FirFilterBase::~FirFilterBase() {
   if (conv != nullptr) {
     conv->stop_process();
 
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
     conv->cleanup();
 
     delete conv;
@@ -150,6 +154,10 @@ void FirFilterBase::setup_zita() {
     return;
   }
 
+  // zita creates and destroys fftw plans and the fftw planner is not thread safe.
+
+  std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
   if (conv != nullptr) {
     conv->stop_process();
 
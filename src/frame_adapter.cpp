@@ -0,0 +1,152 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "frame_adapter.hpp"
+#include <sys/types.h>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+FrameAdapter::FrameAdapter(const uint& n_inputs, const uint& n_outputs)
+    : in_buffers(n_inputs), out_buffers(n_outputs), ring(n_outputs), in_frames(n_inputs), out_frames(n_outputs) {}
+
+void FrameAdapter::set_frame_size(const uint& value) {
+  if (value == frame_size) {
+    return;
+  }
+
+  frame_size = value;
+
+  for (size_t c = 0U; c < in_buffers.size(); c++) {
+    in_buffers[c].resize(frame_size);
+
+    in_frames[c] = in_buffers[c];
+  }
+
+  for (size_t c = 0U; c < out_buffers.size(); c++) {
+    out_buffers[c].resize(frame_size);
+
+    out_frames[c] = out_buffers[c];
+  }
+
+  allocate_ring();
+
+  reset();
+}
+
+void FrameAdapter::set_max_block_size(const uint& value) {
+  if (value <= max_block_size) {
+    return;
+  }
+
+  max_block_size = value;
+
+  allocate_ring();
+}
+
+void FrameAdapter::reset() {
+  n_filled = 0U;
+
+  read_pos = 0U;
+
+  for (auto& r : ring) {
+    std::ranges::fill(r, 0.0F);
+  }
+
+  n_queued = std::min(static_cast<size_t>(frame_size), capacity());
+}
+
+auto FrameAdapter::get_frame_size() const -> uint {
+  return frame_size;
+}
+
+auto FrameAdapter::get_latency() const -> uint {
+  return frame_size;
+}
+
+auto FrameAdapter::capacity() const -> size_t {
+  return ring.empty() ? 0U : ring[0].size();
+}
+
+/*
+  Before a block is read the ring holds at most the priming frame plus the block minus what is still waiting in the
+  input frames, so one frame plus the largest block is always enough.
+*/
+
+void FrameAdapter::allocate_ring() {
+  const auto new_capacity = 2U * static_cast<size_t>(frame_size) + max_block_size;
+
+  if (new_capacity <= capacity()) {
+    return;
+  }
+
+  const auto old_capacity = capacity();
+
+  for (auto& r : ring) {
+    std::vector<float> buffer(new_capacity, 0.0F);
+
+    for (size_t n = 0U; n < n_queued && old_capacity > 0U; n++) {
+      buffer[n] = r[(read_pos + n) % old_capacity];
+    }
+
+    r = std::move(buffer);
+  }
+
+  read_pos = 0U;
+}
+
+void FrameAdapter::push_frame() {
+  const auto size = capacity();
+
+  const auto write_pos = (read_pos + n_queued) % size;
+
+  const auto first = std::min(static_cast<size_t>(frame_size), size - write_pos);
+
+  for (size_t c = 0U; c < ring.size(); c++) {
+    std::copy_n(out_buffers[c].begin(), first, ring[c].begin() + write_pos);
+    std::copy(out_buffers[c].begin() + first, out_buffers[c].end(), ring[c].begin());
+  }
+
+  n_queued = std::min(n_queued + frame_size, size);
+}
+
+void FrameAdapter::pop(std::span<const std::span<float>> outputs, const size_t& count) {
+  const auto size = capacity();
+
+  const auto available = std::min(count, n_queued);
+
+  const auto first = std::min(available, size - read_pos);
+
+  for (size_t c = 0U; c < outputs.size() && c < ring.size(); c++) {
+    auto& out = outputs[c];
+
+    std::copy_n(ring[c].begin() + read_pos, first, out.begin());
+    std::copy_n(ring[c].begin(), available - first, out.begin() + first);
+
+    // Only reached if the block was larger than announced in set_max_block_size.
+
+    std::fill(out.begin() + available, out.begin() + count, 0.0F);
+  }
+
+  read_pos = (read_pos + available) % size;
+
+  n_queued -= available;
+}
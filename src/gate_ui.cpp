@@ -39,6 +39,7 @@
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -140,7 +141,7 @@ void setup(GateBox* self, std::shared_ptr<Gate> gate, const std::string& schema_
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::gate::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::gate::id, schema_path.c_str());
 
   gate->set_post_messages(true);
 
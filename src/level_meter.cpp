@@ -24,10 +24,12 @@
 #include <mutex>
 #include <span>
 #include <string>
+#include "dsp.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 LevelMeter::LevelMeter(const std::string& tag,
                        const std::string& schema,
@@ -40,18 +42,16 @@ LevelMeter::LevelMeter(const std::string& tag,
                  schema,
                  schema_path,
                  pipe_manager,
-                 pipe_type) {}
+                 pipe_type) {
+  quantum_independent = true;
+}
 
 LevelMeter::~LevelMeter() {
   if (connected_to_pw) {
     disconnect_from_pw();
   }
 
-  for (auto& t : mythreads) {
-    t.join();
-  }
-
-  mythreads.clear();
+  WorkerPool::get().cancel_all(this);
 
   std::scoped_lock<std::mutex> lock(data_mutex);
 
@@ -83,9 +83,9 @@ auto LevelMeter::init_ebur128() -> bool {
 }
 
 void LevelMeter::setup() {
-  if (2U * static_cast<size_t>(n_samples) != data.size()) {
-    data.resize(static_cast<size_t>(n_samples) * 2U);
-  }
+  // Sized for the largest quantum. process() uses the size of the block it receives.
+
+  data.resize(2U * static_cast<size_t>(max_quantum));
 
   if (rate != old_rate) {
     data_mutex.lock();
@@ -94,7 +94,7 @@ void LevelMeter::setup() {
 
     data_mutex.unlock();
 
-    mythreads.emplace_back([this]() {  // Using emplace_back here makes sense
+    WorkerPool::get().submit(this, [this](const WorkerPool::Task& /*task*/) {
       if (ebur128_ready) {
         return;
       }
@@ -127,12 +127,9 @@ void LevelMeter::process(std::span<float>& left_in,
     return;
   }
 
-  for (size_t n = 0U; n < n_samples; n++) {
-    data[2U * n] = left_in[n];
-    data[2U * n + 1U] = right_in[n];
-  }
+  dsp::interleave(left_in, right_in, data);
 
-  ebur128_add_frames_float(ebur_state, data.data(), n_samples);
+  ebur128_add_frames_float(ebur_state, data.data(), left_in.size());
 
   if (EBUR128_SUCCESS != ebur128_loudness_momentary(ebur_state, &momentary)) {
     momentary = 0.0;
@@ -177,8 +174,14 @@ auto LevelMeter::get_latency_seconds() -> float {
   return 0.0F;
 }
 
+auto LevelMeter::get_tail_seconds() -> float {
+  // Silence is part of what the loudness measurement has to see.
+
+  return -1.0F;
+}
+
 void LevelMeter::reset_history() {
-  mythreads.emplace_back([this]() {  // Using emplace_back here makes sense
+  WorkerPool::get().submit(this, [this](const WorkerPool::Task& /*task*/) {
     data_mutex.lock();
 
     ebur128_ready = false;
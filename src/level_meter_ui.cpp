@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 #include "level_meter.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -92,7 +93,7 @@ void setup(LevelMeterBox* self, std::shared_ptr<LevelMeter> level_meter, const s
 
   self->data->level_meter = level_meter;
 
-  self->settings = g_settings_new_with_path(tags::schema::level_meter::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::level_meter::id, schema_path.c_str());
 
   level_meter->set_post_messages(true);
 
@@ -38,6 +38,7 @@
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -133,7 +134,7 @@ void setup(LimiterBox* self, std::shared_ptr<Limiter> limiter, const std::string
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::limiter::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::limiter::id, schema_path.c_str());
 
   limiter->set_post_messages(true);
 
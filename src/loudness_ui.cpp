@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 #include "loudness.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -100,7 +101,7 @@ void setup(LoudnessBox* self, std::shared_ptr<Loudness> loudness, const std::str
 
   self->data->loudness = loudness;
 
-  self->settings = g_settings_new_with_path(tags::schema::loudness::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::loudness::id, schema_path.c_str());
 
   loudness->set_post_messages(true);
 
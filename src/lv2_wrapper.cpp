@@ -35,6 +35,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstdarg>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <functional>
@@ -289,6 +290,8 @@ void Lv2Wrapper::connect_data_ports(std::span<float>& left_in,
     return;
   }
 
+  n_samples = static_cast<uint>(left_in.size());
+
   int count_input = 0;
   int count_output = 0;
 
@@ -325,6 +328,8 @@ void Lv2Wrapper::connect_data_ports(std::span<float>& left_in,
     return;
   }
 
+  n_samples = static_cast<uint>(left_in.size());
+
   int count_input = 0;
   int count_output = 0;
 
@@ -431,6 +436,46 @@ auto Lv2Wrapper::get_control_port_value(const std::string& symbol) -> float {
   return 0.0F;
 }
 
+auto Lv2Wrapper::get_control_values() const -> std::vector<float> {
+  std::vector<float> values;
+
+  for (const auto& p : ports) {
+    if (p.type == PortType::TYPE_CONTROL && p.is_input) {
+      values.push_back(p.value);
+    }
+  }
+
+  return values;
+}
+
+void Lv2Wrapper::set_control_values(const std::vector<float>& values) {
+  size_t count = 0U;
+
+  for (const auto& p : ports) {
+    if (p.type == PortType::TYPE_CONTROL && p.is_input) {
+      count++;
+    }
+  }
+
+  if (count != values.size()) {
+    util::warning(plugin_uri + " can not restore " + util::to_string(values.size()) + " control values");
+
+    return;
+  }
+
+  auto value = values.begin();
+
+  for (auto& p : ports) {
+    if (p.type == PortType::TYPE_CONTROL && p.is_input) {
+      p.value = *value++;
+    }
+  }
+}
+
+auto Lv2Wrapper::get_plugin_uri() const -> std::string {
+  return plugin_uri;
+}
+
 auto Lv2Wrapper::has_instance() -> bool {
   return instance != nullptr;
 }
@@ -45,6 +45,8 @@ Maximizer::Maximizer(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_independent = true;
+
   if (!package_installed) {
     util::debug(log_tag + "urn:zamaudio:ZaMaximX2 is not installed");
   }
@@ -125,6 +127,8 @@ void Maximizer::process(std::span<float>& left_in,
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 #include "maximizer.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -91,7 +92,7 @@ void setup(MaximizerBox* self, std::shared_ptr<Maximizer> maximizer, const std::
 
   self->data->maximizer = maximizer;
 
-  self->settings = g_settings_new_with_path(tags::schema::maximizer::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::maximizer::id, schema_path.c_str());
 
   maximizer->set_post_messages(true);
 
@@ -39,6 +39,7 @@
 #include "node_info_holder.hpp"
 #include "pipe_manager.hpp"
 #include "pipe_objects.hpp"
+#include "settings_store.hpp"
 #include "tags_multiband_compressor.hpp"
 #include "tags_pipewire.hpp"
 #include "tags_resources.hpp"
@@ -181,7 +182,7 @@ void setup(MultibandCompressorBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::multiband_compressor::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::multiband_compressor::id, schema_path.c_str());
 
   multiband_compressor->set_post_messages(true);
 
@@ -0,0 +1,300 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "offline_renderer.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <sndfile.hh>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "dsp.hpp"
+#include "effects_base.hpp"
+#include "pipeline_type.hpp"
+#include "plugin_base.hpp"
+#include "tags_schema.hpp"
+#include "util.hpp"
+
+namespace {
+
+constexpr uint block_size = 4096U;
+
+}  // namespace
+
+OfflineRenderer::OfflineRenderer(PipelineType pipe_type) : pipeline_type(pipe_type) {
+  const std::string schema =
+      (pipeline_type == PipelineType::output) ? tags::schema::id_output : tags::schema::id_input;
+
+  schema_base_path = "/" + schema + "/";
+
+  std::replace(schema_base_path.begin(), schema_base_path.end(), '.', '/');
+
+  auto* settings = g_settings_new(schema.c_str());
+
+  plugin_names = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  g_object_unref(settings);
+}
+
+auto OfflineRenderer::render(const std::filesystem::path& input, const std::filesystem::path& output) -> bool {
+  std::vector<Job> jobs;
+
+  if (std::filesystem::is_directory(input)) {
+    std::error_code error;
+
+    std::filesystem::create_directories(output, error);
+
+    if (error) {
+      util::warning(log_tag + "could not create the directory " + output.string() + ": " + error.message());
+
+      return false;
+    }
+
+    // Files libsndfile can not read, like cover images, are skipped.
+
+    for (const auto& entry : std::filesystem::directory_iterator(input, error)) {
+      if (!entry.is_regular_file() || SndfileHandle(entry.path().c_str()).error() != 0) {
+        continue;
+      }
+
+      jobs.push_back({.input_path = entry.path(), .output_path = output / entry.path().filename()});
+    }
+
+    std::ranges::sort(jobs, {}, &Job::input_path);
+  } else {
+    jobs.push_back({.input_path = input, .output_path = output});
+  }
+
+  if (jobs.empty()) {
+    util::warning(log_tag + "no audio file found in " + input.string());
+
+    return false;
+  }
+
+  const auto n_threads = std::max(1U, std::thread::hardware_concurrency());
+
+  bool success = true;
+
+  for (size_t first = 0U; first < jobs.size(); first += n_threads) {
+    const auto count = std::min(static_cast<size_t>(n_threads), jobs.size() - first);
+
+    render_jobs(std::span(jobs).subspan(first, count));
+
+    for (const auto& job : std::span(jobs).subspan(first, count)) {
+      success = success && job.success;
+
+      if (job.success) {
+        util::info(log_tag + job.input_path.string() + " -> " + job.output_path.string());
+      }
+    }
+  }
+
+  return success;
+}
+
+auto OfflineRenderer::create_chain(const uint& rate) -> std::vector<std::shared_ptr<PluginBase>> {
+  std::vector<std::shared_ptr<PluginBase>> chain;
+
+  for (const auto& name : plugin_names) {
+    auto plugin = EffectsBase::make_plugin(name, log_tag, schema_base_path, nullptr, pipeline_type);
+
+    if (plugin == nullptr) {
+      util::warning(log_tag + "the filter name " + name + " base name could not be recognized");
+
+      continue;
+    }
+
+    if (!plugin->package_installed) {
+      util::warning(log_tag + name + " is not installed and will be skipped");
+
+      continue;
+    }
+
+    plugin->prepare_offline(rate, block_size);
+
+    chain.push_back(plugin);
+  }
+
+  return chain;
+}
+
+/*
+  The effects are created and configured in this thread because some of them finish their setup in the main context.
+  Only the processing runs in one thread per file.
+*/
+
+void OfflineRenderer::render_jobs(std::span<Job> jobs) {
+  for (auto& job : jobs) {
+    const auto rate = SndfileHandle(job.input_path.c_str()).samplerate();
+
+    if (rate > 0) {
+      job.chain = create_chain(static_cast<uint>(rate));
+    }
+  }
+
+  dispatch_main_context();
+
+  std::vector<std::thread> threads;
+
+  for (auto& job : jobs) {
+    threads.emplace_back([&job, this]() { job.success = render_file(job); });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The latency notifications sent while rendering still point to the effects.
+
+  dispatch_main_context();
+
+  for (auto& job : jobs) {
+    job.chain.clear();
+  }
+}
+
+auto OfflineRenderer::render_file(Job& job) const -> bool {
+  // SndfileHandle might have issues with std::string, so we provide cstring
+
+  auto input_file = SndfileHandle(job.input_path.c_str());
+
+  if (input_file.error() != 0) {
+    util::warning(log_tag + "could not read " + job.input_path.string() + ": " + input_file.strError());
+
+    return false;
+  }
+
+  const auto n_channels = input_file.channels();
+
+  if (n_channels > 2) {
+    util::warning(log_tag + job.input_path.string() + " has more than two channels");
+
+    return false;
+  }
+
+  auto output_file =
+      SndfileHandle(job.output_path.c_str(), SFM_WRITE, input_file.format(), n_channels, input_file.samplerate());
+
+  if (output_file.error() != 0) {
+    util::warning(log_tag + "could not write " + job.output_path.string() + ": " + output_file.strError());
+
+    return false;
+  }
+
+  output_file.command(SFC_SET_CLIPPING, nullptr, SF_TRUE);
+
+  std::vector<float> interleaved(2U * block_size);
+
+  std::vector<float> buffer_left(block_size), buffer_right(block_size);
+  std::vector<float> other_left(block_size), other_right(block_size);
+
+  const auto n_frames = input_file.frames();
+
+  sf_count_t n_written = 0;
+
+  /*
+    The output is shifted back by the latency of the chain. It is known once the first block went through the
+    effects. The input is followed by silence until the tail of the last block has been written.
+  */
+
+  sf_count_t n_skip = 0;
+
+  bool first_block = true;
+
+  while (n_written < n_frames) {
+    const auto n_read = std::max(input_file.readf(interleaved.data(), block_size), static_cast<sf_count_t>(0));
+
+    std::fill(interleaved.begin() + n_read * n_channels, interleaved.end(), 0.0F);
+
+    if (n_channels == 1) {
+      std::copy_n(interleaved.begin(), block_size, buffer_left.begin());
+      std::copy_n(interleaved.begin(), block_size, buffer_right.begin());
+    } else {
+      dsp::deinterleave(interleaved, buffer_left, buffer_right);
+    }
+
+    std::span<float> left_in(buffer_left);
+    std::span<float> right_in(buffer_right);
+    std::span<float> left_out(other_left);
+    std::span<float> right_out(other_right);
+
+    for (const auto& plugin : job.chain) {
+      plugin->process_offline(left_in, right_in, left_out, right_out);
+
+      std::swap(left_in, left_out);
+      std::swap(right_in, right_out);
+    }
+
+    if (first_block) {
+      float latency = 0.0F;
+
+      for (const auto& plugin : job.chain) {
+        latency += plugin->get_latency_seconds();
+      }
+
+      n_skip = std::llround(latency * static_cast<float>(input_file.samplerate()));
+
+      first_block = false;
+    }
+
+    const auto skipped = std::min(n_skip, static_cast<sf_count_t>(block_size));
+
+    n_skip -= skipped;
+
+    const auto count = std::min(static_cast<sf_count_t>(block_size) - skipped, n_frames - n_written);
+
+    if (count == 0) {
+      continue;
+    }
+
+    const auto left = left_in.subspan(static_cast<size_t>(skipped), static_cast<size_t>(count));
+    const auto right = right_in.subspan(static_cast<size_t>(skipped), static_cast<size_t>(count));
+
+    if (n_channels == 1) {
+      dsp::mix(left, 0.5F, right, 0.5F, interleaved);
+    } else {
+      dsp::interleave(left, right, interleaved);
+    }
+
+    if (output_file.writef(interleaved.data(), count) != count) {
+      util::warning(log_tag + "could not write " + job.output_path.string() + ": " + output_file.strError());
+
+      return false;
+    }
+
+    n_written += count;
+  }
+
+  return true;
+}
+
+void OfflineRenderer::dispatch_main_context() {
+  while (g_main_context_iteration(nullptr, 0) != 0) {
+  }
+}
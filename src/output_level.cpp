@@ -31,7 +31,11 @@ OutputLevel::OutputLevel(const std::string& tag,
                          const std::string& schema_path,
                          PipeManager* pipe_manager,
                          PipelineType pipe_type)
-    : PluginBase(tag, "output_level", tags::plugin_package::ee, schema, schema_path, pipe_manager, pipe_type) {}
+    : PluginBase(tag, "output_level", tags::plugin_package::ee, schema, schema_path, pipe_manager, pipe_type) {
+  // Nothing depends on the quantum.
+
+  quantum_independent = true;
+}
 
 OutputLevel::~OutputLevel() {
   if (connected_to_pw) {
@@ -28,6 +28,7 @@
 #include <mutex>
 #include <span>
 #include <string>
+#include "dsp.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -193,6 +194,10 @@ Pitch::Pitch(const std::string& tag,
                                           }),
                                           this));
 
+  // The interleaved buffer holds the largest quantum, so only rate changes have to go through setup().
+
+  quantum_independent = true;
+
   setup_input_output_gain();
 }
 
@@ -209,9 +214,7 @@ void Pitch::setup() {
 
   latency_n_frames = 0U;
 
-  if (data.size() != static_cast<size_t>(n_samples) * 2) {
-    data.resize(2U * static_cast<size_t>(n_samples));
-  }
+  data.resize(2U * static_cast<size_t>(max_quantum));
 
   deque_out_L.resize(0U);
   deque_out_R.resize(0U);
@@ -246,17 +249,14 @@ void Pitch::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  for (size_t n = 0U; n < left_in.size(); n++) {
-    data[n * 2U] = left_in[n];
-    data[n * 2U + 1U] = right_in[n];
-  }
+  dsp::interleave(left_in, right_in, data);
 
-  snd_touch->putSamples(data.data(), n_samples);
+  snd_touch->putSamples(data.data(), left_in.size());
 
   uint n_received = 0U;
 
   do {
-    n_received = snd_touch->receiveSamples(data.data(), n_samples);
+    n_received = snd_touch->receiveSamples(data.data(), data.size() / 2U);
 
     for (size_t n = 0U; n < n_received; n++) {
       deque_out_L.push_back(data[n * 2U]);
@@ -310,6 +310,8 @@ void Pitch::process(std::span<float>& left_in,
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "pitch.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -87,7 +88,7 @@ void setup(PitchBox* self, std::shared_ptr<Pitch> pitch, const std::string& sche
 
   self->data->pitch = pitch;
 
-  self->settings = g_settings_new_with_path(tags::schema::pitch::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::pitch::id, schema_path.c_str());
 
   pitch->set_post_messages(true);
 
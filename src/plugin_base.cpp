@@ -36,24 +36,235 @@
 #include <spa/pod/pod.h>
 #include <spa/support/loop.h>
 #include <spa/utils/defs.h>
+#include <spa/utils/dict.h>
 #include <spa/utils/hook.h>
 #include <sys/types.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <set>
 #include <span>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <utility>
+#include <vector>
+#include "dsp.hpp"
+#include "lv2_wrapper.hpp"
 #include "pipe_manager.hpp"
+#include "rt_sanitizer.hpp"
+#include "settings_store.hpp"
 #include "tags_app.hpp"
 #include "tags_plugin_name.hpp"
 #include "util.hpp"
+#include "worker_pool.hpp"
 
 namespace {
 
+constexpr auto bypass_fade_seconds = 0.02F;
+
+constexpr auto max_dry_delay_seconds = 0.5F;
+
+constexpr auto default_tail_seconds = 1.0F;
+
+/*
+  Calls setup() on the connected effects whose realtime thread asked for it. The realtime thread only increments the
+  serial and wakes this thread, which does not allocate or take a lock on its side. The list is only locked while it
+  is copied, so add() and remove() do not wait for the setup of other effects.
+*/
+
+class SetupThread {
+ public:
+  SetupThread(const SetupThread&) = delete;
+  auto operator=(const SetupThread&) -> SetupThread& = delete;
+  SetupThread(const SetupThread&&) = delete;
+  auto operator=(const SetupThread&&) -> SetupThread& = delete;
+
+  static auto get() -> SetupThread& {
+    static SetupThread instance;
+
+    return instance;
+  }
+
+  void add(PluginBase* plugin) {
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      plugins.insert(plugin);
+    }
+
+    wake();
+  }
+
+  // Returns after the setup that may be running for this plugin.
+
+  void remove(PluginBase* plugin) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    plugins.erase(plugin);
+
+    setup_done.wait(lock, [&]() { return running != plugin; });
+  }
+
+  void wake() {
+    serial.fetch_add(1U, std::memory_order_release);
+
+    serial.notify_one();
+  }
+
+ private:
+  std::mutex mutex;
+
+  std::condition_variable setup_done;
+
+  std::set<PluginBase*> plugins;
+
+  std::vector<PluginBase*> work;
+
+  PluginBase* running = nullptr;
+
+  std::atomic<uint> serial = 0U;
+
+  std::atomic<bool> quit = false;
+
+  std::thread thread;
+
+  SetupThread() : thread([this]() { run(); }) {}
+
+  ~SetupThread() {
+    quit = true;
+
+    wake();
+
+    thread.join();
+  }
+
+  void run() {
+    while (!quit) {
+      const auto current = serial.load(std::memory_order_acquire);
+
+      {
+        std::scoped_lock<std::mutex> lock(mutex);
+
+        work.assign(plugins.begin(), plugins.end());
+      }
+
+      for (auto* plugin : work) {
+        {
+          std::scoped_lock<std::mutex> lock(mutex);
+
+          // It may have been removed, and destroyed, after the list was copied.
+
+          if (!plugins.contains(plugin)) {
+            continue;
+          }
+
+          running = plugin;
+        }
+
+        plugin->apply_requested_setup();
+
+        {
+          std::scoped_lock<std::mutex> lock(mutex);
+
+          running = nullptr;
+        }
+
+        setup_done.notify_all();
+      }
+
+      serial.wait(current, std::memory_order_acquire);
+    }
+  }
+};
+
+/*
+  Once the input has been digitally silent for longer than the tail and the latency of the effect its output is silent
+  too, and the effect does not have to run. It runs again on the first quantum that has sound. Any nonzero sample
+  counts as sound because the effect may amplify it by any amount.
+*/
+
+auto is_idle(PluginBase* pb,
+             std::span<const float> left_in,
+             std::span<const float> right_in,
+             const uint& n_samples,
+             const uint& rate) -> bool {
+  if (!dsp::is_silent(left_in, right_in, 0.0F)) {
+    pb->silent_frames = 0U;
+
+    return false;
+  }
+
+  const auto idle_after = pb->idle_after_seconds.load(std::memory_order_relaxed);
+
+  if (idle_after < 0.0F) {
+    return false;
+  }
+
+  if (static_cast<float>(pb->silent_frames) >= idle_after * static_cast<float>(rate)) {
+    return true;
+  }
+
+  pb->silent_frames += n_samples;
+
+  return false;
+}
+
+/*
+  Stores the input in the dry history and reads it back delayed by the latency of the effect, so that the dry signal
+  lines up with the processed one. Latencies longer than the history are cut to its length.
+*/
+
+void delay_dry(PluginBase* pb,
+               std::span<const float> left_in,
+               std::span<const float> right_in,
+               std::span<float> left_out,
+               std::span<float> right_out,
+               const uint& rate) {
+  const auto capacity = pb->dry_history_left.size();
+  const auto n = left_in.size();
+
+  if (capacity < n) {
+    std::copy(left_in.begin(), left_in.end(), left_out.begin());
+    std::copy(right_in.begin(), right_in.end(), right_out.begin());
+
+    return;
+  }
+
+  const auto pos = pb->dry_history_pos;
+
+  const auto write = [&](std::span<const float> input, std::vector<float>& history) {
+    const auto first = std::min(n, capacity - pos);
+
+    std::copy_n(input.begin(), first, history.begin() + static_cast<std::ptrdiff_t>(pos));
+    std::copy(input.begin() + static_cast<std::ptrdiff_t>(first), input.end(), history.begin());
+  };
+
+  write(left_in, pb->dry_history_left);
+  write(right_in, pb->dry_history_right);
+
+  const auto delay = std::min(static_cast<size_t>(pb->latency_value * static_cast<float>(rate) + 0.5F), capacity - n);
+
+  const auto start = (pos + capacity - delay) % capacity;
+
+  const auto read = [&](const std::vector<float>& history, std::span<float> output) {
+    const auto first = std::min(n, capacity - start);
+
+    std::copy_n(history.begin() + static_cast<std::ptrdiff_t>(start), first, output.begin());
+    std::copy_n(history.begin(), n - first, output.begin() + static_cast<std::ptrdiff_t>(first));
+  };
+
+  read(pb->dry_history_left, left_out);
+  read(pb->dry_history_right, right_out);
+
+  pb->dry_history_pos = (pos + n) % capacity;
+}
+
 void on_process(void* userdata, spa_io_position* position) {
   auto* d = static_cast<PluginBase::data*>(userdata);
 
@@ -64,19 +275,11 @@ void on_process(void* userdata, spa_io_position* position) {
     return;
   }
 
-  if (rate != d->pb->rate || n_samples != d->pb->n_samples) {
-    d->pb->rate = rate;
-    d->pb->n_samples = n_samples;
-
-    d->pb->dummy_left.resize(n_samples);
-    d->pb->dummy_right.resize(n_samples);
-
-    std::ranges::fill(d->pb->dummy_left, 0.0F);
-    std::ranges::fill(d->pb->dummy_right, 0.0F);
+  [[maybe_unused]] const rt_sanitizer::ScopedRealtime realtime;
 
-    d->pb->clock_start = std::chrono::system_clock::now();
-
-    d->pb->setup();
+  if (rate != d->pb->requested_rate.load(std::memory_order_relaxed) ||
+      (n_samples != d->pb->requested_n_samples.load(std::memory_order_relaxed) && !d->pb->quantum_independent)) {
+    d->pb->request_setup(rate, n_samples);
   }
 
   d->pb->delta_t = 0.001F * static_cast<float>(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -93,6 +296,20 @@ void on_process(void* userdata, spa_io_position* position) {
   auto* out_left = static_cast<float*>(pw_filter_get_dsp_buffer(d->out_left, n_samples));
   auto* out_right = static_cast<float*>(pw_filter_get_dsp_buffer(d->out_right, n_samples));
 
+  // The buffers below are allocated for the largest quantum. Anything bigger is passed through.
+
+  if (n_samples > PluginBase::max_quantum) {
+    if (in_left != nullptr && out_left != nullptr) {
+      std::copy_n(in_left, n_samples, out_left);
+    }
+
+    if (in_right != nullptr && out_right != nullptr) {
+      std::copy_n(in_right, n_samples, out_right);
+    }
+
+    return;
+  }
+
   std::span<float> left_in;
   std::span<float> right_in;
   std::span<float> left_out;
@@ -101,44 +318,104 @@ void on_process(void* userdata, spa_io_position* position) {
   if (in_left != nullptr) {
     left_in = std::span(in_left, n_samples);
   } else {
-    left_in = d->pb->dummy_left;
+    left_in = std::span(d->pb->dummy_left.data(), n_samples);
   }
 
   if (in_right != nullptr) {
     right_in = std::span(in_right, n_samples);
   } else {
-    right_in = d->pb->dummy_right;
+    right_in = std::span(d->pb->dummy_right.data(), n_samples);
   }
 
   if (out_left != nullptr) {
     left_out = std::span(out_left, n_samples);
   } else {
-    left_out = d->pb->dummy_left;
+    left_out = std::span(d->pb->dummy_left.data(), n_samples);
   }
 
   if (out_right != nullptr) {
     right_out = std::span(out_right, n_samples);
   } else {
-    right_out = d->pb->dummy_right;
+    right_out = std::span(d->pb->dummy_right.data(), n_samples);
   }
 
-  if (!d->pb->enable_probe) {
-    d->pb->process(left_in, right_in, left_out, right_out);
-  } else {
-    auto* probe_left = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_left, n_samples));
-    auto* probe_right = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_right, n_samples));
+  /*
+    The effect state belongs to this thread only while it is marked as processing. When the setup thread owns it, or
+    when it was configured for another rate or quantum, the audio is passed through.
+  */
+
+  auto expected = PluginBase::DspState::idle;
+
+  if (!d->pb->dsp_state.compare_exchange_strong(expected, PluginBase::DspState::processing,
+                                                std::memory_order_acquire)) {
+    std::copy(left_in.begin(), left_in.end(), left_out.begin());
+    std::copy(right_in.begin(), right_in.end(), right_out.begin());
 
-    if (probe_left == nullptr || probe_right == nullptr) {
-      std::span l(d->pb->dummy_left.data(), n_samples);
-      std::span r(d->pb->dummy_right.data(), n_samples);
+    return;
+  }
+
+  if (rate != d->pb->rate || (n_samples != d->pb->n_samples && !d->pb->quantum_independent)) {
+    std::copy(left_in.begin(), left_in.end(), left_out.begin());
+    std::copy(right_in.begin(), right_in.end(), right_out.begin());
+
+    d->pb->dsp_state.store(PluginBase::DspState::idle, std::memory_order_release);
 
-      d->pb->process(left_in, right_in, left_out, right_out, l, r);
+    return;
+  }
+
+  auto run_dsp = [&]() {
+    if (!d->pb->enable_probe) {
+      d->pb->process(left_in, right_in, left_out, right_out);
     } else {
-      std::span l(probe_left, n_samples);
-      std::span r(probe_right, n_samples);
+      auto* probe_left = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_left, n_samples));
+      auto* probe_right = static_cast<float*>(pw_filter_get_dsp_buffer(d->probe_right, n_samples));
+
+      if (probe_left == nullptr || probe_right == nullptr) {
+        std::span l(d->pb->dummy_left.data(), n_samples);
+        std::span r(d->pb->dummy_right.data(), n_samples);
 
-      d->pb->process(left_in, right_in, left_out, right_out, l, r);
+        d->pb->process(left_in, right_in, left_out, right_out, l, r);
+      } else {
+        std::span l(probe_left, n_samples);
+        std::span r(probe_right, n_samples);
+
+        d->pb->process(left_in, right_in, left_out, right_out, l, r);
+      }
     }
+  };
+
+  /*
+    A bypassed effect does not run its DSP. It passes the input through delayed by its latency, which keeps the latency
+    reported to PipeWire right. When the bypass state changes the processed and the delayed dry signals are aligned, so
+    they are mixed with an equal-power crossfade that neither clicks nor comb filters.
+  */
+
+  const auto target_level = (d->pb->bypass || d->pb->global_bypass) ? 1.0F : 0.0F;
+
+  const auto dry_left = std::span(d->pb->dry_left.data(), n_samples);
+  const auto dry_right = std::span(d->pb->dry_right.data(), n_samples);
+
+  delay_dry(d->pb, left_in, right_in, dry_left, dry_right, rate);
+
+  if (d->pb->dry_level == target_level) {
+    if (target_level == 1.0F) {
+      std::copy(dry_left.begin(), dry_left.end(), left_out.begin());
+      std::copy(dry_right.begin(), dry_right.end(), right_out.begin());
+    } else if (is_idle(d->pb, left_in, right_in, n_samples, rate)) {
+      d->pb->process_idle(left_out, right_out);
+    } else {
+      run_dsp();
+    }
+  } else {
+    run_dsp();
+
+    const auto step = 1.0F / (bypass_fade_seconds * static_cast<float>(rate));
+
+    const auto level = dsp::crossfade(left_out, dry_left, d->pb->dry_level, target_level, step);
+
+    dsp::crossfade(right_out, dry_right, d->pb->dry_level, target_level, step);
+
+    d->pb->dry_level = level;
   }
 
   if (d->pb->send_notifications) {
@@ -146,6 +423,8 @@ void on_process(void* userdata, spa_io_position* position) {
 
     d->pb->send_notifications = false;
   }
+
+  d->pb->dsp_state.store(PluginBase::DspState::idle, std::memory_order_release);
 }
 
 auto update_filter(struct spa_loop* loop, bool async, uint32_t seq, const void* data, size_t size, void* user_data)
@@ -212,7 +491,7 @@ PluginBase::PluginBase(std::string tag,
       package(std::move(package)),
       pipeline_type(pipe_type),
       enable_probe(enable_probe),
-      settings(g_settings_new_with_path(schema.c_str(), schema_path.c_str())),
+      settings(settings_store::get(schema.c_str(), schema_path.c_str())),
       global_settings(g_settings_new(tags::app::id)),
       pm(pipe_manager) {
   std::string description;
@@ -229,14 +508,42 @@ PluginBase::PluginBase(std::string tag,
                                               self->bypass = g_settings_get_boolean(settings, "bypass") != 0;
                                             }),
                                             this));
+
+    gconnections.push_back(g_signal_connect(settings, "changed",
+                                            G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                              auto* self = static_cast<PluginBase*>(user_data);
+
+                                              self->response_changed.emit();
+                                            }),
+                                            this));
   } else if (name == "output_level") {
     description = _("Output Level Meter");
   } else if (name == "spectrum") {
     description = _("Spectrum");
   }
 
+  // Connected after the handlers of the effect, so that the tail is read from the new parameters.
+
+  gconnections.push_back(g_signal_connect_after(settings, "changed",
+                                                G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                                                  static_cast<PluginBase*>(user_data)->update_tail();
+                                                }),
+                                                this));
+
   pf_data.pb = this;
 
+  dummy_left.resize(max_quantum);
+  dummy_right.resize(max_quantum);
+
+  dry_left.resize(max_quantum);
+  dry_right.resize(max_quantum);
+
+  // Effects created by the offline renderer have no PipeWire node.
+
+  if (pm == nullptr) {
+    return;
+  }
+
   const auto filter_name = "ee_" + log_tag.substr(0U, log_tag.size() - 2U) + "_" + name;
 
   pm->lock();
@@ -330,15 +637,19 @@ PluginBase::PluginBase(std::string tag,
 PluginBase::~PluginBase() {
   post_messages = false;
 
-  pm->lock();
+  if (pm != nullptr) {
+    SetupThread::get().remove(this);
 
-  if (listener.link.next != nullptr || listener.link.prev != nullptr) {
-    spa_hook_remove(&listener);
-  }
+    pm->lock();
+
+    if (listener.link.next != nullptr || listener.link.prev != nullptr) {
+      spa_hook_remove(&listener);
+    }
 
-  pw_filter_destroy(filter);
+    pw_filter_destroy(filter);
 
-  pm->sync_wait_unlock();
+    pm->sync_wait_unlock();
+  }
 
   for (auto& handler_id : gconnections) {
     g_signal_handler_disconnect(settings, handler_id);
@@ -350,7 +661,23 @@ PluginBase::~PluginBase() {
 }
 
 void PluginBase::set_post_messages(const bool& state) {
-  post_messages = state;
+  window_messages = state;
+
+  post_messages = window_messages || meter_subscribers > 0U;
+}
+
+void PluginBase::add_meter_subscriber() {
+  meter_subscribers++;
+
+  post_messages = true;
+}
+
+void PluginBase::remove_meter_subscriber() {
+  if (meter_subscribers > 0U) {
+    meter_subscribers--;
+  }
+
+  post_messages = window_messages || meter_subscribers > 0U;
 }
 
 void PluginBase::reset_settings() {
@@ -362,6 +689,10 @@ auto PluginBase::connect_to_pw() -> bool {
   can_get_node_id = false;
   state = PW_FILTER_STATE_UNCONNECTED;
 
+  update_tail();
+
+  SetupThread::get().add(this);
+
   pm->lock();
 
   if (pw_filter_connect(filter, PW_FILTER_FLAG_RT_PROCESS, nullptr, 0) != 0) {
@@ -436,9 +767,63 @@ void PluginBase::disconnect_from_pw() {
 
   pm->sync_wait_unlock();
 
+  SetupThread::get().remove(this);
+
   node_id = SPA_ID_INVALID;
 }
 
+void PluginBase::request_setup(const uint& new_rate, const uint& new_n_samples) {
+  requested_rate.store(new_rate, std::memory_order_relaxed);
+  requested_n_samples.store(new_n_samples, std::memory_order_relaxed);
+
+  setup_requested.store(true, std::memory_order_release);
+
+  SetupThread::get().wake();
+}
+
+void PluginBase::apply_requested_setup() {
+  if (!setup_requested.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  const auto new_rate = requested_rate.load(std::memory_order_relaxed);
+  const auto new_n_samples = requested_n_samples.load(std::memory_order_relaxed);
+
+  if (new_rate == rate && new_n_samples == n_samples) {
+    return;
+  }
+
+  // The realtime thread holds the state for one quantum at most.
+
+  for (auto expected = DspState::idle;
+       !dsp_state.compare_exchange_weak(expected, DspState::configuring, std::memory_order_acquire);
+       expected = DspState::idle) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  // The dry history covers max_dry_delay_seconds at the new rate plus the largest quantum.
+
+  if (new_rate != rate || dry_history_left.empty()) {
+    const auto capacity = static_cast<size_t>(max_dry_delay_seconds * static_cast<float>(new_rate)) + max_quantum;
+
+    dry_history_left.assign(capacity, 0.0F);
+    dry_history_right.assign(capacity, 0.0F);
+
+    dry_history_pos = 0U;
+  }
+
+  rate = new_rate;
+  n_samples = new_n_samples;
+
+  clock_start = std::chrono::system_clock::now();
+
+  setup();
+
+  update_tail();
+
+  dsp_state.store(DspState::idle, std::memory_order_release);
+}
+
 void PluginBase::setup() {}
 
 void PluginBase::process(std::span<float>& left_in,
@@ -453,10 +838,57 @@ void PluginBase::process(std::span<float>& left_in,
                          std::span<float>& probe_left,
                          std::span<float>& probe_right) {}
 
+void PluginBase::process_idle(std::span<float>& left_out, std::span<float>& right_out) {
+  std::ranges::fill(left_out, 0.0F);
+  std::ranges::fill(right_out, 0.0F);
+
+  // The meters show silence while the effect does not run.
+
+  if (post_messages && send_notifications) {
+    notify();
+  }
+}
+
 auto PluginBase::get_latency_seconds() -> float {
   return 0.0F;
 }
 
+auto PluginBase::get_tail_seconds() -> float {
+  return default_tail_seconds;
+}
+
+void PluginBase::update_tail() {
+  const auto tail = get_tail_seconds();
+
+  idle_after_seconds.store((tail < 0.0F) ? -1.0F : tail + get_latency_seconds(), std::memory_order_relaxed);
+}
+
+auto PluginBase::get_quantum_preference(const uint& graph_rate) const -> QuantumPreference {
+  return {};
+}
+
+void PluginBase::set_node_latency(const uint& quantum, const uint& graph_rate) {
+  if (pm == nullptr || quantum == node_latency_quantum) {
+    return;
+  }
+
+  node_latency_quantum = quantum;
+
+  const auto value = util::to_string(quantum) + "/" + util::to_string(graph_rate);
+
+  // A null value removes the key.
+
+  const spa_dict_item item = SPA_DICT_ITEM_INIT(PW_KEY_NODE_LATENCY, (quantum != 0U) ? value.c_str() : nullptr);
+
+  const spa_dict dict = SPA_DICT_INIT(&item, 1U);
+
+  pm->lock();
+
+  pw_filter_update_properties(filter, nullptr, &dict);
+
+  pm->sync_wait_unlock();
+}
+
 void PluginBase::show_native_ui() {
   if (lv2_wrapper == nullptr) {
     return;
@@ -494,16 +926,14 @@ void PluginBase::get_peaks(const std::span<float>& left_in,
 
   // input level
 
-  float peak_l = std::ranges::max(left_in);
-  float peak_r = std::ranges::max(right_in);
+  auto [peak_l, peak_r] = dsp::peak(left_in, right_in);
 
   input_peak_left = (peak_l > input_peak_left) ? peak_l : input_peak_left;
   input_peak_right = (peak_r > input_peak_right) ? peak_r : input_peak_right;
 
   // output level
 
-  peak_l = std::ranges::max(left_out);
-  peak_r = std::ranges::max(right_out);
+  std::tie(peak_l, peak_r) = dsp::peak(left_out, right_out);
 
   output_peak_left = (peak_l > output_peak_left) ? peak_l : output_peak_left;
   output_peak_right = (peak_r > output_peak_right) ? peak_r : output_peak_right;
@@ -534,8 +964,8 @@ void PluginBase::apply_gain(std::span<float>& left, std::span<float>& right, con
     return;
   }
 
-  std::ranges::for_each(left, [&](auto& v) { v *= gain; });
-  std::ranges::for_each(right, [&](auto& v) { v *= gain; });
+  dsp::scale(left, gain);
+  dsp::scale(right, gain);
 }
 
 void PluginBase::notify() {
@@ -556,6 +986,110 @@ void PluginBase::notify() {
 
 void PluginBase::update_probe_links() {}
 
+auto PluginBase::prepare_bake() -> Bake {
+  if (!bakeable || lv2_wrapper == nullptr || !lv2_wrapper->found_plugin) {
+    return {};
+  }
+
+  return [uri = lv2_wrapper->get_plugin_uri(), values = lv2_wrapper->get_control_values(), bypassed = bypass,
+          gain_in = input_gain, gain_out = output_gain](const uint& bake_rate, std::vector<float>& left,
+                                                        std::vector<float>& right) {
+    if (bake_rate == 0U) {
+      return false;
+    }
+
+    if (bypassed) {
+      return true;
+    }
+
+    constexpr uint block_size = 512U;
+
+    lv2::Lv2Wrapper offline(uri);
+
+    offline.set_n_samples(block_size);
+
+    if (!offline.create_instance(bake_rate)) {
+      return false;
+    }
+
+    offline.set_control_values(values);
+
+    std::vector<float> buffer_in_L(block_size);
+    std::vector<float> buffer_in_R(block_size);
+    std::vector<float> buffer_out_L(block_size);
+    std::vector<float> buffer_out_R(block_size);
+
+    std::span<float> in_L(buffer_in_L);
+    std::span<float> in_R(buffer_in_R);
+    std::span<float> out_L(buffer_out_L);
+    std::span<float> out_R(buffer_out_R);
+
+    offline.connect_data_ports(in_L, in_R, out_L, out_R);
+
+    for (size_t offset = 0U; offset < left.size(); offset += block_size) {
+      const auto count = std::min(static_cast<size_t>(block_size), left.size() - offset);
+
+      std::ranges::fill(buffer_in_L, 0.0F);
+      std::ranges::fill(buffer_in_R, 0.0F);
+
+      std::copy_n(left.begin() + static_cast<std::ptrdiff_t>(offset), count, buffer_in_L.begin());
+      std::copy_n(right.begin() + static_cast<std::ptrdiff_t>(offset), count, buffer_in_R.begin());
+
+      apply_gain(in_L, in_R, gain_in);
+
+      offline.run();
+
+      apply_gain(out_L, out_R, gain_out);
+
+      std::copy_n(buffer_out_L.begin(), count, left.begin() + static_cast<std::ptrdiff_t>(offset));
+      std::copy_n(buffer_out_R.begin(), count, right.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+
+    offline.deactivate();
+
+    return true;
+  };
+}
+
+void PluginBase::prepare_offline(const uint& offline_rate, const uint& block_size) {
+  rate = offline_rate;
+  n_samples = block_size;
+
+  std::ranges::fill(dummy_left, 0.0F);
+  std::ranges::fill(dummy_right, 0.0F);
+
+  setup();
+
+  WorkerPool::get().wait(this);
+}
+
+void PluginBase::process_offline(std::span<float>& left_in,
+                                 std::span<float>& right_in,
+                                 std::span<float>& left_out,
+                                 std::span<float>& right_out) {
+  [[maybe_unused]] const rt_sanitizer::ScopedRealtime realtime;
+
+  if (bypass) {
+    std::copy(left_in.begin(), left_in.end(), left_out.begin());
+    std::copy(right_in.begin(), right_in.end(), right_out.begin());
+
+    return;
+  }
+
+  if (!enable_probe) {
+    process(left_in, right_in, left_out, right_out);
+  } else {
+    std::span l(dummy_left.data(), n_samples);
+    std::span r(dummy_right.data(), n_samples);
+
+    process(left_in, right_in, left_out, right_out, l, r);
+  }
+}
+
 void PluginBase::update_filter_params() {
+  if (pm == nullptr) {
+    return;
+  }
+
   pw_loop_invoke(pw_thread_loop_get_loop(pm->thread_loop), update_filter, 1, nullptr, 0, false, this);
 }
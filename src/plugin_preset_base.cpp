@@ -20,6 +20,10 @@
 #include "plugin_preset_base.hpp"
 #include <gio/gio.h>
 #include <glib-object.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <map>
+#include <string>
 #include "preset_type.hpp"
 #include "util.hpp"
 
@@ -41,8 +45,50 @@ PluginPresetBase::PluginPresetBase(const char* schema_id,
       settings = g_settings_new_with_path(schema_id, (schema_path_output + util::to_string(index) + "/").c_str());
       break;
   }
+
+  transaction_settings.push_back(settings);
 }
 
 PluginPresetBase::~PluginPresetBase() {
+  revert();
+
   g_object_unref(settings);
 }
+
+void PluginPresetBase::stage_value(GSettings* settings, const std::string& key, GVariant* value) {
+  staged_values.push_back({.settings = settings, .key = key, .value = g_variant_ref_sink(value)});
+}
+
+void PluginPresetBase::apply() {
+  std::map<GSettings*, uint> delayed_changes;
+
+  for (auto* s : transaction_settings) {
+    g_settings_delay(s);
+
+    delayed_changes[s] = 0U;
+  }
+
+  for (const auto& staged : staged_values) {
+    g_settings_set_value(staged.settings, staged.key.c_str(), staged.value);
+
+    if (++delayed_changes[staged.settings] == max_delayed_changes) {
+      g_settings_apply(staged.settings);
+
+      delayed_changes[staged.settings] = 0U;
+    }
+  }
+
+  for (auto* s : transaction_settings) {
+    g_settings_apply(s);
+  }
+
+  revert();
+}
+
+void PluginPresetBase::revert() {
+  for (auto& staged : staged_values) {
+    g_variant_unref(staged.value);
+  }
+
+  staged_values.clear();
+}
@@ -91,6 +91,7 @@
 #include "reverb_ui.hpp"
 #include "rnnoise.hpp"
 #include "rnnoise_ui.hpp"
+#include "settings_store.hpp"
 #include "speex.hpp"
 #include "speex_ui.hpp"
 #include "stereo_tools.hpp"
@@ -106,6 +107,8 @@ namespace ui::plugins_box {
 
 using namespace std::string_literals;
 
+constexpr uint page_lifetime = 60U;  // seconds
+
 struct Data {
  public:
   Data() { this->translated = tags::plugin_name::get_translated(); }
@@ -114,12 +117,16 @@ struct Data {
 
   bool schedule_signal_idle = false;
 
+  bool rebuilding_stack = false;
+
   app::Application* application = nullptr;
 
   PipelineType pipeline_type{};
 
   std::string schema_path;
 
+  std::string visible_page;
+
   std::map<std::string, std::string> translated;
 
   std::vector<sigc::connection> connections;
@@ -158,389 +165,492 @@ struct _PluginsBox {
 // NOLINTNEXTLINE
 G_DEFINE_TYPE(PluginsBox, plugins_box, GTK_TYPE_BOX)
 
-template <PipelineType pipeline_type>
-void add_plugins_to_stack(PluginsBox* self) {
-  EffectsBase* effects_base = nullptr;
-
-  if constexpr (pipeline_type == PipelineType::input) {
-    effects_base = self->data->application->sie;
-  } else if constexpr (pipeline_type == PipelineType::output) {
-    effects_base = self->data->application->soe;
+auto get_effects_base(PluginsBox* self) -> EffectsBase* {
+  if (self->data->pipeline_type == PipelineType::input) {
+    return self->data->application->sie;
   }
 
-  // saving the current visible page name for later usage
+  return self->data->application->soe;
+}
 
-  const std::string visible_page_name =
-      (gtk_stack_get_visible_child_name(self->stack) != nullptr) ? gtk_stack_get_visible_child_name(self->stack) : "";
+auto create_plugin_box(PluginsBox* self, const std::string& name) -> GtkWidget* {
+  auto* effects_base = get_effects_base(self);
 
-  // removing all plugins
+  auto path = self->data->schema_path + tags::plugin_name::get_base_name(name) + "/" +
+              util::to_string(tags::plugin_name::get_id(name)) + "/";
 
-  for (auto* child = gtk_widget_get_first_child(GTK_WIDGET(self->stack)); child != nullptr;) {
-    auto* next_child = gtk_widget_get_next_sibling(child);
+  path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
 
-    uint serial = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(child), "serial"));
+  if (name.starts_with(tags::plugin_name::autogain)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<AutoGain>(name);
 
-    set_ignore_filter_idle_add(serial, true);
+    auto* box = ui::autogain_box::create();
 
-    gtk_stack_remove(self->stack, child);
+    ui::autogain_box::setup(box, plugin_ptr, path);
 
-    child = next_child;
-  }
+    return GTK_WIDGET(box);
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::bass_enhancer)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<BassEnhancer>(name);
 
-  // Adding to the stack the plugins in the list that are not there yet
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::bass_enhancer_box::create();
 
-  auto plugins_list = util::gchar_array_to_vector(g_settings_get_strv(self->settings, "plugins"));
+      ui::bass_enhancer_box::setup(plugin_box, plugin_ptr, path);
 
-  for (const auto& name : plugins_list) {
-    auto path = self->data->schema_path + tags::plugin_name::get_base_name(name) + "/" +
-                util::to_string(tags::plugin_name::get_id(name)) + "/";
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
+
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::bass_loudness)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<BassLoudness>(name);
+
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::bass_loudness_box::create();
+
+      ui::bass_loudness_box::setup(plugin_box, plugin_ptr, path);
 
-    path.erase(std::remove(path.begin(), path.end(), '_'), path.end());
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
+
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::compressor)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Compressor>(name);
 
-    if (name.starts_with(tags::plugin_name::autogain)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<AutoGain>(name);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::compressor_box::create();
 
-      auto* box = ui::autogain_box::create();
+      ui::compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      ui::autogain_box::setup(box, plugin_ptr, path);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::bass_enhancer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<BassEnhancer>(name);
+    return box;
+  } else if (name.starts_with(tags::plugin_name::convolver)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Convolver>(name);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::bass_enhancer_box::create();
+    auto* box = ui::convolver_box::create();
 
-        ui::bass_enhancer_box::setup(plugin_box, plugin_ptr, path);
+    ui::convolver_box::setup(box, plugin_ptr, path, self->data->application);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    return GTK_WIDGET(box);
+  } else if (name.starts_with(tags::plugin_name::crossfeed)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Crossfeed>(name);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::bass_loudness)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<BassLoudness>(name);
+    auto* box = ui::crossfeed_box::create();
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::bass_loudness_box::create();
+    ui::crossfeed_box::setup(box, plugin_ptr, path);
 
-        ui::bass_loudness_box::setup(plugin_box, plugin_ptr, path);
+    return GTK_WIDGET(box);
+  } else if (name.starts_with(tags::plugin_name::crystalizer)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Crystalizer>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    auto* box = ui::crystalizer_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::compressor)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Compressor>(name);
+    ui::crystalizer_box::setup(box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::compressor_box::create();
+    return GTK_WIDGET(box);
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::deepfilternet)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<DeepFilterNet>(name);
 
-        ui::compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::deepfilternet_box::create();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+      ui::deepfilternet_box::setup(plugin_box, plugin_ptr, path);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (name.starts_with(tags::plugin_name::convolver)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Convolver>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      auto* box = ui::convolver_box::create();
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::deesser)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Deesser>(name);
 
-      ui::convolver_box::setup(box, plugin_ptr, path, self->data->application);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::deesser_box::create();
+
+      ui::deesser_box::setup(plugin_box, plugin_ptr, path);
+
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (name.starts_with(tags::plugin_name::crossfeed)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Crossfeed>(name);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::delay)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Delay>(name);
 
-      auto* box = ui::crossfeed_box::create();
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::delay_box::create();
 
-      ui::crossfeed_box::setup(box, plugin_ptr, path);
+      ui::delay_box::setup(plugin_box, plugin_ptr, path);
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (name.starts_with(tags::plugin_name::crystalizer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Crystalizer>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      auto* box = ui::crystalizer_box::create();
+    return box;
+  } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<EchoCanceller>(name);
 
-      ui::crystalizer_box::setup(box, plugin_ptr, path);
+    auto* box = ui::echo_canceller_box::create();
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::deepfilternet)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<DeepFilterNet>(name);
+    ui::echo_canceller_box::setup(box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::deepfilternet_box::create();
+    return GTK_WIDGET(box);
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::exciter)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Exciter>(name);
 
-        ui::deepfilternet_box::setup(plugin_box, plugin_ptr, path);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::exciter_box::create();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+      ui::exciter_box::setup(plugin_box, plugin_ptr, path);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::deesser)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Deesser>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::deesser_box::create();
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::expander)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Expander>(name);
 
-        ui::deesser_box::setup(plugin_box, plugin_ptr, path);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::expander_box::create();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+      ui::expander_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::delay)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Delay>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::delay_box::create();
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::equalizer)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Equalizer>(name);
 
-        ui::delay_box::setup(plugin_box, plugin_ptr, path);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::equalizer_box::create();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+      ui::equalizer_box::setup(plugin_box, plugin_ptr, path, self->data->application);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (name.starts_with(tags::plugin_name::echo_canceller)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<EchoCanceller>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      auto* box = ui::echo_canceller_box::create();
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::filter)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Filter>(name);
 
-      ui::echo_canceller_box::setup(box, plugin_ptr, path);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::filter_box::create();
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::exciter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Exciter>(name);
+      ui::filter_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::exciter_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::exciter_box::setup(plugin_box, plugin_ptr, path);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::gate)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Gate>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::gate_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::expander)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Expander>(name);
+      ui::gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::expander_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::expander_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::level_meter)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<LevelMeter>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::level_meter_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::equalizer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Equalizer>(name);
+      ui::level_meter_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::equalizer_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::equalizer_box::setup(plugin_box, plugin_ptr, path, self->data->application);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::limiter)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Limiter>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::limiter_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::filter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Filter>(name);
+      ui::limiter_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::filter_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::filter_box::setup(plugin_box, plugin_ptr, path);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::loudness)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Loudness>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::loudness_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::gate)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Gate>(name);
+      ui::loudness_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::gate_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::maximizer)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Maximizer>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::maximizer_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::level_meter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<LevelMeter>(name);
+      ui::maximizer_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::level_meter_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::level_meter_box::setup(plugin_box, plugin_ptr, path);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::multiband_compressor)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<MultibandCompressor>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::multiband_compressor_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::limiter)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Limiter>(name);
+      ui::multiband_compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::limiter_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::limiter_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::multiband_gate)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<MultibandGate>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::multiband_gate_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::loudness)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Loudness>(name);
+      ui::multiband_gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::loudness_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::loudness_box::setup(plugin_box, plugin_ptr, path);
+    return box;
+  } else if (name.starts_with(tags::plugin_name::pitch)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Pitch>(name);
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+    auto* box = ui::pitch_box::create();
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::maximizer)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Maximizer>(name);
+    ui::pitch_box::setup(box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::maximizer_box::create();
+    return GTK_WIDGET(box);
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::reverb)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Reverb>(name);
 
-        ui::maximizer_box::setup(plugin_box, plugin_ptr, path);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::reverb_box::create();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+      ui::reverb_box::setup(plugin_box, plugin_ptr, path);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::multiband_compressor)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<MultibandCompressor>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::multiband_compressor_box::create();
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::rnnoise)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<RNNoise>(name);
 
-        ui::multiband_compressor_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::rnnoise_box::create();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+      ui::rnnoise_box::setup(plugin_box, plugin_ptr, path, self->data->application);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::multiband_gate)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<MultibandGate>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::multiband_gate_box::create();
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::speex)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<Speex>(name);
 
-        ui::multiband_gate_box::setup(plugin_box, plugin_ptr, path, self->data->application->pm);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::speex_box::create();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+      ui::speex_box::setup(plugin_box, plugin_ptr, path, self->data->application);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (name.starts_with(tags::plugin_name::pitch)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Pitch>(name);
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-      auto* box = ui::pitch_box::create();
+    return box;
+  } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::stereo_tools)) {
+    auto plugin_ptr = effects_base->get_plugin_instance<StereoTools>(name);
 
-      ui::pitch_box::setup(box, plugin_ptr, path);
+    if (plugin_ptr->package_installed) {
+      auto* plugin_box = ui::stereo_tools_box::create();
 
-      gtk_stack_add_named(self->stack, GTK_WIDGET(box), name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::reverb)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Reverb>(name);
+      ui::stereo_tools_box::setup(plugin_box, plugin_ptr, path);
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::reverb_box::create();
+      box = GTK_WIDGET(plugin_box);
+    } else {
+      box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
+    }
 
-        ui::reverb_box::setup(plugin_box, plugin_ptr, path);
+    return box;
+  }
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+  return nullptr;
+}
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::rnnoise)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<RNNoise>(name);
+/*
+  The stack holds an empty box for each plugin. The plugin page is put inside it the first time it is shown and only
+  the visible page asks its plugin for level messages. Hidden pages are destroyed after page_lifetime seconds.
+*/
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::rnnoise_box::create();
+void cancel_page_teardown(GtkWidget* slot) {
+  if (auto source_id = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(slot), "teardown-source")); source_id != 0U) {
+    g_source_remove(source_id);
 
-        ui::rnnoise_box::setup(plugin_box, plugin_ptr, path, self->data->application);
+    g_object_set_data(G_OBJECT(slot), "teardown-source", nullptr);
+  }
+}
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+void schedule_page_teardown(GtkWidget* slot) {
+  cancel_page_teardown(slot);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::speex)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<Speex>(name);
+  if (gtk_widget_get_first_child(slot) == nullptr) {
+    return;
+  }
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::speex_box::create();
+  auto source_id = g_timeout_add_seconds(page_lifetime, GSourceFunc(+[](GtkWidget* slot) {
+                                           g_object_set_data(G_OBJECT(slot), "teardown-source", nullptr);
 
-        ui::speex_box::setup(plugin_box, plugin_ptr, path, self->data->application);
+                                           if (auto* page = gtk_widget_get_first_child(slot); page != nullptr) {
+                                             gtk_box_remove(GTK_BOX(slot), page);
+                                           }
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+                                           return G_SOURCE_REMOVE;
+                                         }),
+                                         slot);
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
-    } else if (GtkWidget* box = nullptr; name.starts_with(tags::plugin_name::stereo_tools)) {
-      auto plugin_ptr = effects_base->get_plugin_instance<StereoTools>(name);
+  g_object_set_data(G_OBJECT(slot), "teardown-source", GUINT_TO_POINTER(source_id));
+}
 
-      if (plugin_ptr->package_installed) {
-        auto* plugin_box = ui::stereo_tools_box::create();
+void update_visible_page(PluginsBox* self) {
+  if (self->data->rebuilding_stack) {
+    return;
+  }
 
-        ui::stereo_tools_box::setup(plugin_box, plugin_ptr, path);
+  const auto plugins = get_effects_base(self)->get_plugins_map();
 
-        box = GTK_WIDGET(plugin_box);
-      } else {
-        box = ui::missing_plugin_box(plugin_ptr->name, plugin_ptr->package);
-      }
+  const std::string name =
+      (gtk_stack_get_visible_child_name(self->stack) != nullptr) ? gtk_stack_get_visible_child_name(self->stack) : "";
 
-      gtk_stack_add_named(self->stack, box, name.c_str());
+  if (name == self->data->visible_page) {
+    return;
+  }
+
+  if (!self->data->visible_page.empty()) {
+    if (auto it = plugins.find(self->data->visible_page); it != plugins.end()) {
+      it->second->set_post_messages(false);
+    }
+
+    if (auto* slot = gtk_stack_get_child_by_name(self->stack, self->data->visible_page.c_str()); slot != nullptr) {
+      schedule_page_teardown(slot);
+    }
+  }
+
+  self->data->visible_page = name;
+
+  if (name.empty()) {
+    return;
+  }
+
+  auto* slot = gtk_stack_get_visible_child(self->stack);
+
+  cancel_page_teardown(slot);
+
+  if (auto* page = gtk_widget_get_first_child(slot); page == nullptr) {
+    if (auto* box = create_plugin_box(self, name); box != nullptr) {
+      gtk_widget_set_hexpand(box, 1);
+      gtk_widget_set_vexpand(box, 1);
+
+      gtk_box_append(GTK_BOX(slot), box);
+    }
+  } else if (g_object_get_data(G_OBJECT(page), "serial") != nullptr) {
+    // only the pages of installed plugins turn the messages on when they are set up
+
+    if (auto it = plugins.find(name); it != plugins.end()) {
+      it->second->set_post_messages(true);
     }
   }
+}
+
+void add_plugins_to_stack(PluginsBox* self) {
+  // saving the current visible page name for later usage
+
+  const std::string visible_page_name =
+      (gtk_stack_get_visible_child_name(self->stack) != nullptr) ? gtk_stack_get_visible_child_name(self->stack) : "";
+
+  self->data->rebuilding_stack = true;
+
+  self->data->visible_page.clear();
+
+  for (auto& plugin : get_effects_base(self)->get_plugins_map() | std::views::values) {
+    plugin->set_post_messages(false);
+  }
+
+  // removing all plugins
+
+  for (auto* child = gtk_widget_get_first_child(GTK_WIDGET(self->stack)); child != nullptr;) {
+    auto* next_child = gtk_widget_get_next_sibling(child);
+
+    cancel_page_teardown(child);
+
+    if (auto* page = gtk_widget_get_first_child(child); page != nullptr) {
+      uint serial = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(page), "serial"));
+
+      set_ignore_filter_idle_add(serial, true);
+    }
+
+    gtk_stack_remove(self->stack, child);
+
+    child = next_child;
+  }
+
+  // Adding an empty page for each plugin in the list. Their contents are created by update_visible_page.
+
+  auto plugins_list = util::gchar_array_to_vector(g_settings_get_strv(self->settings, "plugins"));
+
+  for (const auto& name : plugins_list) {
+    gtk_stack_add_named(self->stack, gtk_box_new(GTK_ORIENTATION_VERTICAL, 0), name.c_str());
+  }
 
   if (plugins_list.empty()) {
     gtk_widget_set_visible(GTK_WIDGET(self->overlay_no_plugins), 1);
@@ -559,6 +669,10 @@ void add_plugins_to_stack(PluginsBox* self) {
       gtk_stack_set_visible_child_name(self->stack, visible_page_name.c_str());
     }
   }
+
+  self->data->rebuilding_stack = false;
+
+  update_visible_page(self);
 }
 
 void show_adjacent_plugin(PluginsBox* self, const int& increment) {
@@ -770,7 +884,7 @@ void setup_listview(PluginsBox* self) {
 
         auto schema_id = tags::app::id + "."s + gname;
 
-        auto* settings = g_settings_new_with_path(schema_id.c_str(), schema_path.c_str());
+        auto* settings = settings_store::get(schema_id.c_str(), schema_path.c_str());
 
         gsettings_bind_widget(settings, "bypass", enable, G_SETTINGS_BIND_INVERT_BOOLEAN);
 
@@ -787,17 +901,21 @@ void setup(PluginsBox* self, app::Application* application, PipelineType pipelin
   self->data->application = application;
   self->data->pipeline_type = pipeline_type;
 
+  g_signal_connect(self->stack, "notify::visible-child",
+                   G_CALLBACK(+[](GtkStack* stack, GParamSpec* pspec, PluginsBox* self) { update_visible_page(self); }),
+                   self);
+
   switch (pipeline_type) {
     case PipelineType::input: {
       self->settings = g_settings_new(tags::schema::id_input);
 
       self->data->schema_path = tags::app::path_stream_inputs;
 
-      add_plugins_to_stack<PipelineType::input>(self);
+      add_plugins_to_stack(self);
 
       self->data->gconnections.push_back(g_signal_connect(
           self->settings, "changed::plugins", G_CALLBACK(+[](GSettings* settings, char* key, PluginsBox* self) {
-            add_plugins_to_stack<PipelineType::input>(self);
+            add_plugins_to_stack(self);
           }),
           self));
 
@@ -814,11 +932,11 @@ void setup(PluginsBox* self, app::Application* application, PipelineType pipelin
 
       self->data->schema_path = tags::app::path_stream_outputs;
 
-      add_plugins_to_stack<PipelineType::output>(self);
+      add_plugins_to_stack(self);
 
       self->data->gconnections.push_back(g_signal_connect(
           self->settings, "changed::plugins", G_CALLBACK(+[](GSettings* settings, char* key, PluginsBox* self) {
-            add_plugins_to_stack<PipelineType::output>(self);
+            add_plugins_to_stack(self);
           }),
           self));
 
@@ -860,15 +978,7 @@ void dispose(GObject* object) {
 
   // Setting post_messages = false for all plugins now that the window is not visible.
 
-  EffectsBase* effects_base = nullptr;
-
-  if (self->data->pipeline_type == PipelineType::input) {
-    effects_base = self->data->application->sie;
-  } else if (self->data->pipeline_type == PipelineType::output) {
-    effects_base = self->data->application->soe;
-  }
-
-  for (auto& plugin : effects_base->get_plugins_map() | std::views::values) {
+  for (auto& plugin : get_effects_base(self)->get_plugins_map() | std::views::values) {
     plugin->set_post_messages(false);
   }
 
@@ -885,6 +995,8 @@ void dispose(GObject* object) {
   self->data->connections.clear();
   self->data->gconnections.clear();
 
+  g_signal_handlers_disconnect_by_data(self->stack, self);
+
   g_object_unref(self->settings);
 
   // Trying to avoid that the functions scheduled by the plugins are executed when the widgets have already been
@@ -893,9 +1005,13 @@ void dispose(GObject* object) {
   for (auto* child = gtk_widget_get_first_child(GTK_WIDGET(self->stack)); child != nullptr;) {
     auto* next_child = gtk_widget_get_next_sibling(child);
 
-    uint serial = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(child), "serial"));
+    cancel_page_teardown(child);
+
+    if (auto* page = gtk_widget_get_first_child(child); page != nullptr) {
+      uint serial = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(page), "serial"));
 
-    set_ignore_filter_idle_add(serial, true);
+      set_ignore_filter_idle_add(serial, true);
+    }
 
     child = next_child;
   }
@@ -42,7 +42,9 @@ struct _PreferencesGeneral {
       *use_cubic_volumes, *inactivity_timer_enable, *autohide_popovers, *exclude_monitor_streams,
       *show_native_plugin_ui;
 
-  GtkSpinButton *inactivity_timeout, *meters_update_interval, *lv2ui_update_frequency;
+  GtkSpinButton *inactivity_timeout, *meters_update_interval, *lv2ui_update_frequency, *standby_plugins;
+
+  AdwComboRow* quantum_profile;
 
   GSettings* settings;
 };
@@ -126,7 +128,9 @@ void preferences_general_class_init(PreferencesGeneralClass* klass) {
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, inactivity_timeout);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, meters_update_interval);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, lv2ui_update_frequency);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, standby_plugins);
   gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, show_native_plugin_ui);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesGeneral, quantum_profile);
 }
 
 void preferences_general_init(PreferencesGeneral* self) {
@@ -143,11 +147,13 @@ void preferences_general_init(PreferencesGeneral* self) {
   gsettings_bind_widgets<"process-all-inputs", "process-all-outputs", "use-dark-theme", "shutdown-on-window-close",
                          "use-cubic-volumes", "autohide-popovers", "exclude-monitor-streams", "inactivity-timer-enable",
                          "inactivity-timeout", "meters-update-interval", "lv2ui-update-frequency",
-                         "show-native-plugin-ui">(
+                         "show-native-plugin-ui", "standby-plugins">(
       self->settings, self->process_all_inputs, self->process_all_outputs, self->theme_switch,
       self->shutdown_on_window_close, self->use_cubic_volumes, self->autohide_popovers, self->exclude_monitor_streams,
       self->inactivity_timer_enable, self->inactivity_timeout, self->meters_update_interval,
-      self->lv2ui_update_frequency, self->show_native_plugin_ui);
+      self->lv2ui_update_frequency, self->show_native_plugin_ui, self->standby_plugins);
+
+  ui::gsettings_bind_enum_to_combo_widget(self->settings, "quantum-profile", self->quantum_profile);
 
 #ifdef ENABLE_LIBPORTAL
   libportal::init(self->enable_autostart, self->shutdown_on_window_close);
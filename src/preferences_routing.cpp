@@ -0,0 +1,279 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "preferences_routing.hpp"
+#include <adwaita.h>
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <glib/gi18n.h>
+#include <gobject/gobject.h>
+#include <gtk/gtk.h>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+#include "tags_resources.hpp"
+#include "tags_schema.hpp"
+#include "util.hpp"
+
+namespace ui::preferences::routing {
+
+using Rules = std::vector<std::pair<std::string, std::string>>;
+
+// The widgets and the settings of the output or of the input streams.
+
+struct Section {
+  GSettings* settings = nullptr;
+
+  AdwPreferencesGroup* group = nullptr;
+
+  AdwEntryRow* pattern = nullptr;
+
+  GtkDropDown* target = nullptr;
+
+  std::vector<GtkWidget*> rows;
+
+  std::vector<gulong> gconnections;
+};
+
+struct Data {
+ public:
+  ~Data() { util::debug("data struct destroyed"); }
+
+  Section output, input;
+};
+
+struct _PreferencesRouting {
+  AdwPreferencesPage parent_instance;
+
+  AdwPreferencesGroup *output_group, *input_group;
+
+  AdwEntryRow *output_pattern, *input_pattern;
+
+  GtkDropDown *output_target, *input_target;
+
+  Data* data;
+};
+
+// NOLINTNEXTLINE
+G_DEFINE_TYPE(PreferencesRouting, preferences_routing, ADW_TYPE_PREFERENCES_PAGE)
+
+auto read_rules(GSettings* settings) -> Rules {
+  Rules rules;
+
+  auto* value = g_settings_get_value(settings, "routing-rules");
+
+  GVariantIter iter;
+
+  g_variant_iter_init(&iter, value);
+
+  const gchar *pattern = nullptr, *target = nullptr;
+
+  while (g_variant_iter_next(&iter, "(&s&s)", &pattern, &target)) {
+    rules.emplace_back(pattern, target);
+  }
+
+  g_variant_unref(value);
+
+  return rules;
+}
+
+void write_rules(GSettings* settings, const Rules& rules) {
+  GVariantBuilder builder;
+
+  g_variant_builder_init(&builder, G_VARIANT_TYPE("a(ss)"));
+
+  for (const auto& [pattern, target] : rules) {
+    g_variant_builder_add(&builder, "(ss)", pattern.c_str(), target.c_str());
+  }
+
+  g_settings_set_value(settings, "routing-rules", g_variant_builder_end(&builder));
+}
+
+// The rules are shown in the order they are tried. Each row removes its rule by index.
+
+void populate(Section& section) {
+  for (auto* row : section.rows) {
+    adw_preferences_group_remove(section.group, row);
+  }
+
+  section.rows.clear();
+
+  const auto rules = read_rules(section.settings);
+
+  for (size_t n = 0U; n < rules.size(); n++) {
+    const auto& [pattern, target] = rules[n];
+
+    auto* row = adw_action_row_new();
+    auto* button = gtk_button_new_from_icon_name("user-trash-symbolic");
+
+    adw_preferences_row_set_use_markup(ADW_PREFERENCES_ROW(row), 0);
+    adw_preferences_row_set_title(ADW_PREFERENCES_ROW(row), pattern.c_str());
+    adw_action_row_set_subtitle(ADW_ACTION_ROW(row), (target == "device") ? _("Device") : _("Effects"));
+
+    gtk_widget_set_valign(button, GTK_ALIGN_CENTER);
+    gtk_widget_add_css_class(button, "flat");
+    gtk_widget_set_tooltip_text(button, _("Remove Rule"));
+
+    adw_action_row_add_suffix(ADW_ACTION_ROW(row), button);
+
+    g_object_set_data(G_OBJECT(button), "index", GUINT_TO_POINTER(static_cast<guint>(n)));
+
+    g_signal_connect(button, "clicked", G_CALLBACK(+[](GtkButton* btn, Section* section) {
+                       const auto index = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(btn), "index"));
+
+                       auto rules = read_rules(section->settings);
+
+                       if (index < rules.size()) {
+                         rules.erase(rules.begin() + static_cast<std::ptrdiff_t>(index));
+
+                         write_rules(section->settings, rules);
+                       }
+                     }),
+                     &section);
+
+    adw_preferences_group_add(section.group, row);
+
+    section.rows.push_back(row);
+  }
+}
+
+// A rule for a pattern that already has one replaces it and keeps its place.
+
+void add_rule(Section& section) {
+  std::string pattern = gtk_editable_get_text(GTK_EDITABLE(section.pattern));
+
+  pattern.erase(0, pattern.find_first_not_of(' '));
+  pattern.erase(pattern.find_last_not_of(' ') + 1U);
+
+  if (pattern.empty()) {
+    return;
+  }
+
+  const std::string target = (gtk_drop_down_get_selected(section.target) == 1U) ? "device" : "effects";
+
+  auto rules = read_rules(section.settings);
+
+  if (auto it = std::ranges::find(rules, pattern, &Rules::value_type::first); it != rules.end()) {
+    it->second = target;
+  } else {
+    rules.emplace_back(pattern, target);
+  }
+
+  write_rules(section.settings, rules);
+
+  gtk_editable_set_text(GTK_EDITABLE(section.pattern), "");
+}
+
+void on_add_output_rule(PreferencesRouting* self, GtkButton* button) {
+  add_rule(self->data->output);
+}
+
+void on_add_input_rule(PreferencesRouting* self, GtkButton* button) {
+  add_rule(self->data->input);
+}
+
+void setup_section(Section& section,
+                   const char* schema_id,
+                   AdwPreferencesGroup* group,
+                   AdwEntryRow* pattern,
+                   GtkDropDown* target) {
+  section.settings = g_settings_new(schema_id);
+  section.group = group;
+  section.pattern = pattern;
+  section.target = target;
+
+  populate(section);
+
+  section.gconnections.push_back(g_signal_connect(
+      section.settings, "changed::routing-rules",
+      G_CALLBACK(+[](GSettings* settings, char* key, Section* section) { populate(*section); }), &section));
+
+  g_signal_connect(pattern, "entry-activated",
+                   G_CALLBACK(+[](AdwEntryRow* row, Section* section) { add_rule(*section); }), &section);
+}
+
+void dispose(GObject* object) {
+  auto* self = EE_PREFERENCES_ROUTING(object);
+
+  for (auto* section : {&self->data->output, &self->data->input}) {
+    for (auto& handler_id : section->gconnections) {
+      g_signal_handler_disconnect(section->settings, handler_id);
+    }
+
+    section->gconnections.clear();
+
+    g_clear_object(&section->settings);
+  }
+
+  util::debug("disposed");
+
+  G_OBJECT_CLASS(preferences_routing_parent_class)->dispose(object);
+}
+
+void finalize(GObject* object) {
+  auto* self = EE_PREFERENCES_ROUTING(object);
+
+  delete self->data;
+
+  util::debug("finalized");
+
+  G_OBJECT_CLASS(preferences_routing_parent_class)->finalize(object);
+}
+
+void preferences_routing_class_init(PreferencesRoutingClass* klass) {
+  auto* object_class = G_OBJECT_CLASS(klass);
+  auto* widget_class = GTK_WIDGET_CLASS(klass);
+
+  object_class->dispose = dispose;
+  object_class->finalize = finalize;
+
+  gtk_widget_class_set_template_from_resource(widget_class, tags::resources::preferences_routing_ui);
+
+  gtk_widget_class_bind_template_child(widget_class, PreferencesRouting, output_group);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesRouting, input_group);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesRouting, output_pattern);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesRouting, input_pattern);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesRouting, output_target);
+  gtk_widget_class_bind_template_child(widget_class, PreferencesRouting, input_target);
+
+  gtk_widget_class_bind_template_callback(widget_class, on_add_output_rule);
+  gtk_widget_class_bind_template_callback(widget_class, on_add_input_rule);
+}
+
+void preferences_routing_init(PreferencesRouting* self) {
+  gtk_widget_init_template(GTK_WIDGET(self));
+
+  self->data = new Data();
+
+  setup_section(self->data->output, tags::schema::id_output, self->output_group, self->output_pattern,
+                self->output_target);
+
+  setup_section(self->data->input, tags::schema::id_input, self->input_group, self->input_pattern,
+                self->input_target);
+}
+
+auto create() -> PreferencesRouting* {
+  return static_cast<PreferencesRouting*>(g_object_new(EE_TYPE_PREFERENCES_ROUTING, nullptr));
+}
+
+}  // namespace ui::preferences::routing
@@ -25,6 +25,7 @@
 #include <string>
 #include "config.h"
 #include "preferences_general.hpp"
+#include "preferences_routing.hpp"
 #include "preferences_spectrum.hpp"
 #include "tags_app.hpp"
 #include "tags_resources.hpp"
@@ -37,6 +38,8 @@ struct _PreferencesWindow {
 
   ui::preferences::general::PreferencesGeneral* page_general;
 
+  ui::preferences::routing::PreferencesRouting* page_routing;
+
   ui::preferences::spectrum::PreferencesSpectrum* page_spectrum;
 };
 
@@ -50,6 +53,7 @@ void dispose(GObject* object) {
                            IS_DEVEL_BUILD ? std::string(tags::app::id).append(".Devel").c_str() : tags::app::id);
 
   adw_preferences_window_remove(ADW_PREFERENCES_WINDOW(self), ADW_PREFERENCES_PAGE(self->page_general));
+  adw_preferences_window_remove(ADW_PREFERENCES_WINDOW(self), ADW_PREFERENCES_PAGE(self->page_routing));
   adw_preferences_window_remove(ADW_PREFERENCES_WINDOW(self), ADW_PREFERENCES_PAGE(self->page_spectrum));
 
   util::debug("disposed");
@@ -70,9 +74,11 @@ void preferences_window_init(PreferencesWindow* self) {
   gtk_widget_init_template(GTK_WIDGET(self));
 
   self->page_general = ui::preferences::general::create();
+  self->page_routing = ui::preferences::routing::create();
   self->page_spectrum = ui::preferences::spectrum::create();
 
   adw_preferences_window_add(ADW_PREFERENCES_WINDOW(self), ADW_PREFERENCES_PAGE(self->page_general));
+  adw_preferences_window_add(ADW_PREFERENCES_WINDOW(self), ADW_PREFERENCES_PAGE(self->page_routing));
   adw_preferences_window_add(ADW_PREFERENCES_WINDOW(self), ADW_PREFERENCES_PAGE(self->page_spectrum));
 }
 
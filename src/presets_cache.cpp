@@ -0,0 +1,186 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "presets_cache.hpp"
+#include <glib.h>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "util.hpp"
+
+PresetsCache::PresetsCache() : cache_dir(std::string(g_get_user_cache_dir()) + "/easyeffects/presets") {
+  std::error_code ec;
+
+  if (!std::filesystem::is_directory(cache_dir, ec) && !std::filesystem::create_directories(cache_dir, ec)) {
+    util::warning("failed to create the presets cache directory: " + cache_dir.string());
+  }
+}
+
+void PresetsCache::read(const std::filesystem::path& input_file, nlohmann::json& json) {
+  std::error_code ec_mtime;
+  std::error_code ec_size;
+
+  const auto source_mtime =
+      static_cast<int64_t>(std::filesystem::last_write_time(input_file, ec_mtime).time_since_epoch().count());
+
+  const auto source_size = static_cast<uint64_t>(std::filesystem::file_size(input_file, ec_size));
+
+  if (ec_mtime || ec_size) {
+    // Let the stream report the error like it did before the cache existed.
+
+    std::ifstream is(input_file);
+
+    is >> json;
+
+    return;
+  }
+
+  const auto key = input_file.string();
+
+  if (auto it = entries.find(key); it != entries.end()) {
+    if (it->second.source_mtime == source_mtime && it->second.source_size == source_size) {
+      json = it->second.json;
+
+      return;
+    }
+
+    entries.erase(it);
+  }
+
+  const auto compiled_file = get_compiled_path(input_file);
+
+  if (!read_compiled(compiled_file, source_mtime, source_size, json)) {
+    std::ifstream is(input_file);
+
+    is >> json;
+
+    write_compiled(compiled_file, source_mtime, source_size, json);
+  }
+
+  entries[key] = Entry{.source_mtime = source_mtime, .source_size = source_size, .json = json};
+}
+
+void PresetsCache::invalidate(const std::filesystem::path& input_file) {
+  entries.erase(input_file.string());
+
+  std::error_code ec;
+
+  std::filesystem::remove(get_compiled_path(input_file), ec);
+}
+
+auto PresetsCache::get_compiled_path(const std::filesystem::path& input_file) const -> std::filesystem::path {
+  const auto hash = std::hash<std::string>{}(input_file.string());
+
+  return cache_dir / (util::to_string(hash) + ".msgpack");
+}
+
+auto PresetsCache::read_compiled(const std::filesystem::path& compiled_file,
+                                 const int64_t& source_mtime,
+                                 const uint64_t& source_size,
+                                 nlohmann::json& json) const -> bool {
+  std::ifstream is(compiled_file, std::ios::binary);
+
+  if (!is.is_open()) {
+    return false;
+  }
+
+  Header header;
+
+  is.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+  if (!is || header.magic != magic || header.version != format_version || header.source_mtime != source_mtime ||
+      header.source_size != source_size) {
+    return false;
+  }
+
+  std::vector<std::uint8_t> payload(header.payload_size);
+
+  is.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+
+  if (static_cast<uint64_t>(is.gcount()) != header.payload_size) {
+    return false;
+  }
+
+  try {
+    json = nlohmann::json::from_msgpack(payload);
+  } catch (const std::exception& e) {
+    util::debug("discarding the invalid compiled preset " + compiled_file.string() + ": " + e.what());
+
+    return false;
+  }
+
+  return true;
+}
+
+void PresetsCache::write_compiled(const std::filesystem::path& compiled_file,
+                                  const int64_t& source_mtime,
+                                  const uint64_t& source_size,
+                                  const nlohmann::json& json) const {
+  std::vector<std::uint8_t> payload;
+
+  try {
+    payload = nlohmann::json::to_msgpack(json);
+  } catch (const std::exception& e) {
+    util::debug(e.what());
+
+    return;
+  }
+
+  Header header{.magic = magic,
+                .version = format_version,
+                .source_mtime = source_mtime,
+                .source_size = source_size,
+                .payload_size = payload.size()};
+
+  // Written to a temporary file first, so a concurrent reader never sees a partial file.
+
+  auto tmp_file = compiled_file;
+
+  tmp_file += ".tmp";
+
+  {
+    std::ofstream os(tmp_file, std::ios::binary | std::ios::trunc);
+
+    if (!os.is_open()) {
+      return;
+    }
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+
+    if (!os) {
+      return;
+    }
+  }
+
+  std::error_code ec;
+
+  std::filesystem::rename(tmp_file, compiled_file, ec);
+
+  if (ec) {
+    std::filesystem::remove(tmp_file, ec);
+  }
+}
@@ -23,6 +23,7 @@
 #include <glib.h>
 #include <glib/gi18n.h>
 #include <sys/types.h>
+#include <algorithm>
 #include <exception>
 #include <filesystem>
 #include <fstream>
@@ -62,8 +63,11 @@
 #include "pitch_preset.hpp"
 #include "plugin_preset_base.hpp"
 #include "preset_type.hpp"
+#include "presets_cache.hpp"
+#include "resource_catalog.hpp"
 #include "reverb_preset.hpp"
 #include "rnnoise_preset.hpp"
+#include "settings_store.hpp"
 #include "speex_preset.hpp"
 #include "stereo_tools_preset.hpp"
 #include "tags_app.hpp"
@@ -214,6 +218,8 @@ PresetsManager::PresetsManager()
                    this);
 
   g_object_unref(gfile);
+
+  ResourceCatalog::get().refresh();
 }
 
 PresetsManager::~PresetsManager() {
@@ -300,6 +306,18 @@ void PresetsManager::add(const PresetType& preset_type, const std::string& name)
 auto PresetsManager::get_all_community_presets_paths(const PresetType& preset_type) -> std::vector<std::string> {
   std::vector<std::string> cp_paths;
 
+  if (const auto& catalog = ResourceCatalog::get(); catalog.ready()) {
+    using Type = ResourceCatalog::Type;
+
+    const auto type = (preset_type == PresetType::output) ? Type::output_preset : Type::input_preset;
+
+    for (const auto& entry : catalog.list(type)) {
+      cp_paths.push_back((entry.path.parent_path() / entry.path.stem()).string());
+    }
+
+    return cp_paths;
+  }
+
   const auto scan_level = 2U;
 
   const auto cp_dir_vect = (preset_type == PresetType::output) ? system_data_dir_output : system_data_dir_input;
@@ -468,7 +486,8 @@ void PresetsManager::save_blocklist(const PresetType& preset_type, nlohmann::jso
   }
 }
 
-auto PresetsManager::load_blocklist(const PresetType& preset_type, const nlohmann::json& json) -> bool {
+auto PresetsManager::load_blocklist(const PresetType& preset_type, const nlohmann::json& json, GSettings* settings)
+    -> bool {
   std::vector<std::string> blocklist;
 
   switch (preset_type) {
@@ -476,9 +495,9 @@ auto PresetsManager::load_blocklist(const PresetType& preset_type, const nlohman
       try {
         auto list = json.at("input").at("blocklist").get<std::vector<std::string>>();
 
-        g_settings_set_strv(sie_settings, "blocklist", util::make_gchar_pointer_vector(list).data());
+        g_settings_set_strv(settings, "blocklist", util::make_gchar_pointer_vector(list).data());
       } catch (const nlohmann::json::exception& e) {
-        g_settings_reset(sie_settings, "blocklist");
+        g_settings_reset(settings, "blocklist");
 
         notify_error(PresetError::blocklist_format);
 
@@ -486,7 +505,7 @@ auto PresetsManager::load_blocklist(const PresetType& preset_type, const nlohman
 
         return false;
       } catch (...) {
-        g_settings_reset(sie_settings, "blocklist");
+        g_settings_reset(settings, "blocklist");
 
         notify_error(PresetError::blocklist_generic);
 
@@ -499,9 +518,9 @@ auto PresetsManager::load_blocklist(const PresetType& preset_type, const nlohman
       try {
         auto list = json.at("output").at("blocklist").get<std::vector<std::string>>();
 
-        g_settings_set_strv(soe_settings, "blocklist", util::make_gchar_pointer_vector(list).data());
+        g_settings_set_strv(settings, "blocklist", util::make_gchar_pointer_vector(list).data());
       } catch (const nlohmann::json::exception& e) {
-        g_settings_reset(soe_settings, "blocklist");
+        g_settings_reset(settings, "blocklist");
 
         notify_error(PresetError::blocklist_format);
 
@@ -509,7 +528,7 @@ auto PresetsManager::load_blocklist(const PresetType& preset_type, const nlohman
 
         return false;
       } catch (...) {
-        g_settings_reset(soe_settings, "blocklist");
+        g_settings_reset(settings, "blocklist");
 
         notify_error(PresetError::blocklist_generic);
 
@@ -575,6 +594,10 @@ void PresetsManager::save_preset_file(const PresetType& preset_type, const std::
 
   o << std::setw(4) << json << '\n';
 
+  o.close();
+
+  presets_cache.invalidate(output_file);
+
   // std::cout << std::setw(4) << json << std::endl;
 
   util::debug("saved preset: " + output_file.string());
@@ -583,6 +606,10 @@ void PresetsManager::save_preset_file(const PresetType& preset_type, const std::
 void PresetsManager::write_plugins_preset(const PresetType& preset_type,
                                           const std::vector<std::string>& plugins,
                                           nlohmann::json& json) {
+  // The wrappers have their own GSettings objects. They read what is in dconf.
+
+  settings_store::flush();
+
   for (const auto& name : plugins) {
     if (auto wrapper = create_wrapper(preset_type, name); wrapper != std::nullopt) {
       if (wrapper.has_value()) {
@@ -602,6 +629,8 @@ void PresetsManager::remove(const PresetType& preset_type, const std::string& na
   if (std::filesystem::exists(preset_file)) {
     std::filesystem::remove(preset_file);
 
+    presets_cache.invalidate(preset_file);
+
     util::debug("removed preset: " + preset_file.string());
   }
 }
@@ -657,20 +686,65 @@ auto PresetsManager::load_preset_file(const PresetType& preset_type, const std::
 
   std::vector<std::string> plugins;
 
+  std::vector<std::unique_ptr<PluginPresetBase>> staged_wrappers;
+
   // Read effects_pipeline
   if (!read_effects_pipeline_from_preset(preset_type, input_file, json, plugins)) {
     return false;
   }
 
-  // After the plugin order list, load the blocklist and then
-  // apply the parameters of the loaded plugins.
-  if (load_blocklist(preset_type, json) && read_plugins_preset(preset_type, plugins, json)) {
-    util::debug("successfully loaded the preset: " + input_file.string());
+  /*
+    The preset is loaded as a single transaction. The parameters of all plugins are staged in memory before
+    anything is committed. If one of them fails nothing is applied and the staged values are dropped together with
+    the wrappers.
+  */
 
-    return true;
+  if (!read_plugins_preset(preset_type, plugins, json, staged_wrappers)) {
+    for (auto& wrapper : staged_wrappers) {
+      wrapper->revert();
+    }
+
+    return false;
   }
 
-  return false;
+  // A private object is used for the transaction. The shared one stays in immediate mode for the other writers.
+
+  auto* pipeline_settings =
+      g_settings_new((preset_type == PresetType::input) ? tags::schema::id_input : tags::schema::id_output);
+
+  g_settings_delay(pipeline_settings);
+
+  if (!load_blocklist(preset_type, json, pipeline_settings)) {
+    g_settings_revert(pipeline_settings);
+
+    g_object_unref(pipeline_settings);
+
+    for (auto& wrapper : staged_wrappers) {
+      wrapper->revert();
+    }
+
+    return false;
+  }
+
+  /*
+    The plugins parameters are committed before the effects list. This way the filters created by the pipeline when
+    the list changes already read their final values instead of receiving one notification per key, and the pipeline
+    is relinked only once.
+  */
+
+  for (auto& wrapper : staged_wrappers) {
+    wrapper->apply();
+  }
+
+  g_settings_set_strv(pipeline_settings, "plugins", util::make_gchar_pointer_vector(plugins).data());
+
+  g_settings_apply(pipeline_settings);
+
+  g_object_unref(pipeline_settings);
+
+  util::debug("successfully loaded the preset: " + input_file.string());
+
+  return true;
 }
 
 auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_type,
@@ -679,12 +753,8 @@ auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_
                                                        std::vector<std::string>& plugins) -> bool {
   const auto* preset_type_str = (preset_type == PresetType::input) ? "input" : "output";
 
-  GSettings* settings = (preset_type == PresetType::input) ? sie_settings : soe_settings;
-
   try {
-    std::ifstream is(input_file);
-
-    is >> json;
+    presets_cache.read(input_file, json);
 
     for (const auto& p : json.at(preset_type_str).at("plugins_order").get<std::vector<std::string>>()) {
       for (const auto& v : tags::plugin_name::list) {
@@ -716,27 +786,36 @@ auto PresetsManager::read_effects_pipeline_from_preset(const PresetType& preset_
     return false;
   }
 
-  g_settings_set_strv(settings, "plugins", util::make_gchar_pointer_vector(plugins).data());
-
   return true;
 }
 
 auto PresetsManager::read_plugins_preset(const PresetType& preset_type,
                                          const std::vector<std::string>& plugins,
-                                         const nlohmann::json& json) -> bool {
+                                         const nlohmann::json& json,
+                                         std::vector<std::unique_ptr<PluginPresetBase>>& staged_wrappers) -> bool {
+  // Values still pending in the effects would overwrite the preset when they are sent to dconf.
+
+  settings_store::flush();
+
   for (const auto& name : plugins) {
     if (auto wrapper = create_wrapper(preset_type, name); wrapper != std::nullopt) {
       try {
         if (wrapper.has_value()) {
-          wrapper.value()->read(json);
+          wrapper.value()->stage(json);
+
+          staged_wrappers.push_back(std::move(wrapper.value()));
         }
       } catch (const nlohmann::json::exception& e) {
+        wrapper.value()->revert();
+
         notify_error(PresetError::plugin_format, name);
 
         util::warning(e.what());
 
         return false;
       } catch (...) {
+        wrapper.value()->revert();
+
         notify_error(PresetError::plugin_generic, name);
 
         return false;
@@ -747,6 +826,49 @@ auto PresetsManager::read_plugins_preset(const PresetType& preset_type,
   return true;
 }
 
+auto PresetsManager::prepare_standby_preset(const PresetType& preset_type, const std::string& name)
+    -> std::vector<std::string> {
+  const auto conf_dir = (preset_type == PresetType::output) ? user_output_dir : user_input_dir;
+
+  const auto input_file = conf_dir / std::filesystem::path{name + json_ext};
+
+  if (!std::filesystem::exists(input_file)) {
+    util::debug("can't find the standby preset \"" + name + "\" on the filesystem");
+
+    return {};
+  }
+
+  nlohmann::json json;
+
+  std::vector<std::string> plugins;
+
+  if (!read_effects_pipeline_from_preset(preset_type, input_file, json, plugins)) {
+    return {};
+  }
+
+  /*
+    The parameters are staged only to check them and are dropped with the wrappers. Writing them into the plugin
+    instances would change the settings of the user, and two standby presets using the same instance would overwrite
+    each other. The parsed preset stays in memory in the presets cache, so loading it later does not touch the disk.
+  */
+
+  std::vector<std::unique_ptr<PluginPresetBase>> staged_wrappers;
+
+  const auto valid = read_plugins_preset(preset_type, plugins, json, staged_wrappers);
+
+  for (auto& wrapper : staged_wrappers) {
+    wrapper->revert();
+  }
+
+  if (!valid) {
+    return {};
+  }
+
+  util::debug("prepared the standby preset: " + input_file.string());
+
+  return plugins;
+}
+
 void PresetsManager::import_from_filesystem(const PresetType& preset_type, const std::string& file_path) {
   // When importing presets from the filesystem, we overwrite the file if it already exists.
 
@@ -769,6 +891,8 @@ void PresetsManager::import_from_filesystem(const PresetType& preset_type, const
   try {
     std::filesystem::copy_file(p, out_path, std::filesystem::copy_options::overwrite_existing);
 
+    presets_cache.invalidate(out_path);
+
     util::debug("imported preset to: " + out_path.string());
   } catch (const std::exception& e) {
     util::warning("can't import preset to: " + out_path.string());
@@ -776,6 +900,30 @@ void PresetsManager::import_from_filesystem(const PresetType& preset_type, const
   }
 }
 
+auto PresetsManager::search_community_addon(const ResourceCatalog::Type& type,
+                                            const std::string& package,
+                                            const std::string& filename) -> std::string {
+  if (const auto& catalog = ResourceCatalog::get(); catalog.ready()) {
+    if (const auto entry = catalog.find(type, package, filename)) {
+      return entry->path.string();
+    }
+  }
+
+  // Packages installed after the last refresh of the catalogue are only found by walking their directories.
+
+  std::string path;
+
+  const auto& xdg_dirs = (type == ResourceCatalog::Type::irs) ? system_data_dir_irs : system_data_dir_rnnoise;
+
+  for (const auto& xdg_dir : xdg_dirs) {
+    if (util::search_filename(std::filesystem::path{xdg_dir + "/" + package}, filename, path, 3U)) {
+      break;
+    }
+  }
+
+  return path;
+}
+
 auto PresetsManager::import_addons_from_community_package(const PresetType& preset_type,
                                                           const std::filesystem::path& path,
                                                           const std::string& package) -> bool {
@@ -814,55 +962,35 @@ auto PresetsManager::import_addons_from_community_package(const PresetType& pres
 
     // For every filename of both vectors, search the full path and copy the file locally.
     for (const auto& irs_name : conv_irs) {
-      std::string path;
-
-      bool found = false;
-
-      for (const auto& xdg_dir : system_data_dir_irs) {
-        if (util::search_filename(std::filesystem::path{xdg_dir + "/" + package}, irs_name, path, 3U)) {
-          const auto out_path = std::filesystem::path{user_irs_dir} / irs_name;
-
-          std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
-
-          util::debug("successfully imported community preset addon " + irs_name + " locally");
+      const auto path = search_community_addon(ResourceCatalog::Type::irs, package, irs_name);
 
-          found = true;
-
-          break;
-        }
-      }
-
-      if (!found) {
+      if (path.empty()) {
         util::warning("community preset addon " + irs_name + " not found!");
 
         return false;
       }
-    }
-
-    for (const auto& model_name : rn_models) {
-      std::string path;
-
-      bool found = false;
 
-      for (const auto& xdg_dir : system_data_dir_rnnoise) {
-        if (util::search_filename(std::filesystem::path{xdg_dir + "/" + package}, model_name, path, 3U)) {
-          const auto out_path = std::filesystem::path{user_rnnoise_dir} / model_name;
+      const auto out_path = std::filesystem::path{user_irs_dir} / irs_name;
 
-          std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
+      std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
 
-          util::debug("successfully imported community preset addon " + model_name + " locally");
-
-          found = true;
+      util::debug("successfully imported community preset addon " + irs_name + " locally");
+    }
 
-          break;
-        }
-      }
+    for (const auto& model_name : rn_models) {
+      const auto path = search_community_addon(ResourceCatalog::Type::rnnoise, package, model_name);
 
-      if (!found) {
+      if (path.empty()) {
         util::warning("community preset addon " + model_name + " not found!");
 
         return false;
       }
+
+      const auto out_path = std::filesystem::path{user_rnnoise_dir} / model_name;
+
+      std::filesystem::copy_file(path, out_path, std::filesystem::copy_options::overwrite_existing);
+
+      util::debug("successfully imported community preset addon " + model_name + " locally");
     }
 
     return true;
@@ -951,6 +1079,8 @@ void PresetsManager::import_from_community_package(const PresetType& preset_type
 
   std::filesystem::copy_file(p, out_path);
 
+  presets_cache.invalidate(out_path);
+
   util::debug("successfully imported the community preset to: " + out_path.string());
 }
 
@@ -981,6 +1111,10 @@ void PresetsManager::add_autoload(const PresetType& preset_type,
 
   o << std::setw(4) << json << '\n';
 
+  o.close();
+
+  presets_cache.invalidate(output_file);
+
   util::debug("added autoload preset file: " + output_file.string());
 }
 
@@ -1005,13 +1139,13 @@ void PresetsManager::remove_autoload(const PresetType& preset_type,
 
   nlohmann::json json;
 
-  std::ifstream is(input_file);
-
-  is >> json;
+  presets_cache.read(input_file, json);
 
   if (preset_name == json.value("preset-name", "") && device_profile == json.value("device-profile", "")) {
     std::filesystem::remove(input_file);
 
+    presets_cache.invalidate(input_file);
+
     util::debug("removed autoload: " + input_file.string());
   }
 }
@@ -1036,9 +1170,7 @@ auto PresetsManager::find_autoload(const PresetType& preset_type,
 
   nlohmann::json json;
 
-  std::ifstream is(input_file);
-
-  is >> json;
+  presets_cache.read(input_file, json);
 
   return json.value("preset-name", "");
 }
@@ -1079,9 +1211,7 @@ auto PresetsManager::get_autoload_profiles(const PresetType& preset_type) -> std
         if (it->path().extension().c_str() == json_ext) {
           nlohmann::json json;
 
-          std::ifstream is(autoload_dir / it->path());
-
-          is >> json;
+          presets_cache.read(autoload_dir / it->path(), json);
 
           list.push_back(json);
         }
@@ -1098,6 +1228,30 @@ auto PresetsManager::get_autoload_profiles(const PresetType& preset_type) -> std
   }
 }
 
+void PresetsManager::prepare_autoload_cache() {
+  // Reading the autoload files and their presets ahead of time keeps json parsing out of the device change path.
+
+  for (const auto preset_type : {PresetType::output, PresetType::input}) {
+    const auto conf_dir = (preset_type == PresetType::output) ? user_output_dir : user_input_dir;
+
+    for (const auto& profile : get_autoload_profiles(preset_type)) {
+      const auto preset_file = conf_dir / std::filesystem::path{profile.value("preset-name", "") + json_ext};
+
+      if (!std::filesystem::is_regular_file(preset_file)) {
+        continue;
+      }
+
+      try {
+        nlohmann::json json;
+
+        presets_cache.read(preset_file, json);
+      } catch (const std::exception& e) {
+        util::warning(e.what());
+      }
+    }
+  }
+}
+
 void PresetsManager::set_last_preset_keys(const PresetType& preset_type,
                                           const std::string& preset_name,
                                           const std::string& package_name) {
@@ -35,6 +35,7 @@
 #include <vector>
 #include "application.hpp"
 #include "preset_type.hpp"
+#include "resource_catalog.hpp"
 #include "tags_app.hpp"
 #include "tags_resources.hpp"
 #include "util.hpp"
@@ -327,6 +328,11 @@ void setup_community_presets_listview(PresetsMenu* self,
 
   g_signal_connect(self->refresh_community_list, "clicked", G_CALLBACK(refresh_community_listview), self);
 
+  // The catalogue is rebuilt in the background when community packages are installed or removed.
+
+  self->data->connections.push_back(ResourceCatalog::get().changed.connect(
+      [=]() { refresh_community_listview(self->refresh_community_list, self); }));
+
   gtk_list_view_set_factory(listview_community, factory);
 
   g_object_unref(factory);
@@ -20,10 +20,11 @@
 #include "resampler.hpp"
 #include <samplerate.h>
 
-Resampler::Resampler(const int& input_rate, const int& output_rate) : output(1, 0) {
+Resampler::Resampler(const int& input_rate, const int& output_rate, const int& channels)
+    : channels(static_cast<size_t>(channels)), output(1, 0) {
   resample_ratio = static_cast<double>(output_rate) / static_cast<double>(input_rate);
 
-  src_state = src_new(SRC_SINC_FASTEST, 1, nullptr);
+  src_state = src_new(SRC_SINC_FASTEST, channels, nullptr);
 }
 
 Resampler::~Resampler() {
@@ -0,0 +1,310 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "resource_catalog.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sndfile.hh>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "tags_resources.hpp"
+#include "util.hpp"
+#include "worker_pool.hpp"
+
+namespace {
+
+// Installing a package creates many files at once. The catalogue is rebuilt once they settle.
+
+constexpr auto refresh_delay = 1000U;  // milliseconds
+
+auto get_extension(const ResourceCatalog::Type& type) -> std::string {
+  switch (type) {
+    case ResourceCatalog::Type::irs:
+      return ".irs";
+    case ResourceCatalog::Type::rnnoise:
+      return ".rnnn";
+    default:
+      return ".json";
+  }
+}
+
+auto is_preset(const ResourceCatalog::Type& type) -> bool {
+  return type == ResourceCatalog::Type::input_preset || type == ResourceCatalog::Type::output_preset;
+}
+
+}  // namespace
+
+ResourceCatalog::ResourceCatalog() {
+  // The builds run in the pool, so it has to outlive the catalogue.
+
+  WorkerPool::get();
+
+  std::vector<std::string> data_dirs;
+
+  // Flatpak specific path (.flatpak-info always present for apps running in the flatpak sandbox).
+  if (std::filesystem::is_regular_file(tags::resources::flatpak_info_file)) {
+    data_dirs.emplace_back("/app/extensions/Presets/");
+  }
+
+  for (const gchar* const* xdg_data_dirs = g_get_system_data_dirs(); *xdg_data_dirs != nullptr;) {
+    std::string dir = *xdg_data_dirs++;
+
+    dir += dir.ends_with("/") ? "easyeffects/" : "/easyeffects/";
+
+    data_dirs.push_back(dir);
+  }
+
+  for (const auto& dir : data_dirs) {
+    parents.emplace_back(dir);
+
+    roots.emplace_back(Type::input_preset, dir + "input");
+    roots.emplace_back(Type::output_preset, dir + "output");
+    roots.emplace_back(Type::irs, dir + "irs");
+    roots.emplace_back(Type::rnnoise, dir + "rnnoise");
+  }
+}
+
+ResourceCatalog::~ResourceCatalog() {
+  WorkerPool::get().cancel_all(this);
+
+  if (refresh_source_id != 0U) {
+    g_source_remove(refresh_source_id);
+  }
+
+  set_monitors({});
+}
+
+auto ResourceCatalog::get() -> ResourceCatalog& {
+  static ResourceCatalog catalog;
+
+  return catalog;
+}
+
+void ResourceCatalog::refresh() {
+  const auto serial = ++generation;
+
+  WorkerPool::get().cancel_all(this);
+
+  WorkerPool::get().submit(this, [this, serial](const WorkerPool::Task& task) {
+    auto index = std::make_shared<Index>();
+
+    // When the easyeffects folder does not exist yet the data directory holding it is watched instead.
+
+    for (const auto& parent : parents) {
+      std::error_code ec;
+
+      const auto dir = parent.parent_path();  // the path ends with a slash
+
+      if (std::filesystem::is_directory(dir, ec)) {
+        index->directories.push_back(dir);
+      } else if (std::filesystem::is_directory(dir.parent_path(), ec)) {
+        index->directories.push_back(dir.parent_path());
+      }
+    }
+
+    for (const auto& [type, root] : roots) {
+      std::error_code ec;
+
+      if (!std::filesystem::is_directory(root, ec)) {
+        continue;
+      }
+
+      index->directories.push_back(root);
+
+      // Each folder inside a root is a package.
+
+      for (auto it = std::filesystem::directory_iterator{root, ec}; !ec && it != std::filesystem::directory_iterator{};
+           it.increment(ec)) {
+        if (task.is_cancelled()) {
+          return;
+        }
+
+        if (it->is_directory(ec)) {
+          scan_directory(*index, task, type, it->path().filename().string(), it->path(), is_preset(type) ? 2U : 3U);
+        }
+      }
+    }
+
+    if (task.is_cancelled()) {
+      return;
+    }
+
+    util::idle_add([this, serial, index]() {
+      if (serial != generation) {
+        return;
+      }
+
+      util::debug("resource catalogue built with " + util::to_string(index->entries.size()) + " files in " +
+                  util::to_string(index->directories.size()) + " directories");
+
+      {
+        std::scoped_lock<std::mutex> lock(mutex);
+
+        entries = std::move(index->entries);
+      }
+
+      set_monitors(index->directories);
+
+      is_ready = true;
+
+      changed.emit();
+    });
+  });
+}
+
+auto ResourceCatalog::ready() const -> bool {
+  return is_ready;
+}
+
+auto ResourceCatalog::find(const Type& type, const std::string& package, const std::string& filename) const
+    -> std::optional<Entry> {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  if (auto it = entries.find(Key{type, package, filename}); it != entries.end()) {
+    return it->second;
+  }
+
+  return std::nullopt;
+}
+
+auto ResourceCatalog::list(const Type& type) const -> std::vector<Entry> {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  std::vector<Entry> output;
+
+  for (auto it = entries.lower_bound(Key{type, "", ""}); it != entries.end() && std::get<0>(it->first) == type; ++it) {
+    output.push_back(it->second);
+  }
+
+  return output;
+}
+
+void ResourceCatalog::scan_directory(Index& index,
+                                     const WorkerPool::Task& task,
+                                     const Type& type,
+                                     const std::string& package,
+                                     const std::filesystem::path& dir,
+                                     const uint& scan_level) {
+  const auto extension = get_extension(type);
+
+  std::vector<std::filesystem::path> subdirs;
+
+  std::error_code ec;
+
+  index.directories.push_back(dir);
+
+  // The files of a folder take precedence over the ones with the same name in its subfolders.
+
+  for (auto it = std::filesystem::directory_iterator{dir, ec}; !ec && it != std::filesystem::directory_iterator{};
+       it.increment(ec)) {
+    if (task.is_cancelled()) {
+      return;
+    }
+
+    const auto& path = it->path();
+
+    if (it->is_directory(ec)) {
+      if (scan_level > 1U) {
+        subdirs.push_back(path);
+      }
+
+      continue;
+    }
+
+    if (!it->is_regular_file(ec) || path.extension() != extension) {
+      continue;
+    }
+
+    Entry entry{.package = package, .path = path};
+
+    entry.size = static_cast<uint64_t>(it->file_size(ec));
+    entry.mtime = static_cast<int64_t>(it->last_write_time(ec).time_since_epoch().count());
+
+    if (type == Type::irs) {
+      // Only the header is read.
+
+      const auto sndfile = SndfileHandle(path.c_str());
+
+      entry.rate = static_cast<uint>(sndfile.samplerate());
+      entry.channels = static_cast<uint>(sndfile.channels());
+    }
+
+    index.entries.emplace(Key{type, package, is_preset(type) ? path.string() : path.filename().string()}, entry);
+  }
+
+  for (const auto& subdir : subdirs) {
+    scan_directory(index, task, type, package, subdir, scan_level - 1U);
+  }
+}
+
+void ResourceCatalog::set_monitors(const std::vector<std::filesystem::path>& directories) {
+  for (auto* monitor : monitors) {
+    g_file_monitor_cancel(monitor);
+
+    g_object_unref(monitor);
+  }
+
+  monitors.clear();
+
+  for (const auto& dir : directories) {
+    auto* gfile = g_file_new_for_path(dir.c_str());
+
+    if (auto* monitor = g_file_monitor_directory(gfile, G_FILE_MONITOR_NONE, nullptr, nullptr); monitor != nullptr) {
+      g_signal_connect(monitor, "changed",
+                       G_CALLBACK(+[](GFileMonitor* monitor, GFile* file, GFile* other_file,
+                                      GFileMonitorEvent event_type, ResourceCatalog* self) {
+                         // Writes are reported by the changes done hint that follows them.
+
+                         if (event_type != G_FILE_MONITOR_EVENT_CHANGED &&
+                             event_type != G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED) {
+                           self->schedule_refresh();
+                         }
+                       }),
+                       this);
+
+      monitors.push_back(monitor);
+    }
+
+    g_object_unref(gfile);
+  }
+}
+
+void ResourceCatalog::schedule_refresh() {
+  if (refresh_source_id != 0U) {
+    return;
+  }
+
+  refresh_source_id = g_timeout_add(refresh_delay, GSourceFunc(+[](ResourceCatalog* self) {
+                                      self->refresh_source_id = 0U;
+
+                                      self->refresh();
+
+                                      return G_SOURCE_REMOVE;
+                                    }),
+                                    this);
+}
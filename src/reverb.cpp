@@ -44,6 +44,8 @@ Reverb::Reverb(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_independent = true;
+
   if (!package_installed) {
     util::debug(log_tag + "http://calf.sourceforge.net/plugins/Reverb is not installed");
   }
@@ -124,3 +126,14 @@ void Reverb::process(std::span<float>& left_in,
 auto Reverb::get_latency_seconds() -> float {
   return 0.0F;
 }
+
+auto Reverb::get_tail_seconds() -> float {
+  if (!lv2_wrapper->found_plugin) {
+    return 0.0F;
+  }
+
+  // The decay time is measured down to -60 dB. Twice that is -120 dB, where cutting the tail can not be heard.
+
+  return 2.0F * lv2_wrapper->get_control_port_value("decay_time") +
+         0.001F * lv2_wrapper->get_control_port_value("predelay");
+}
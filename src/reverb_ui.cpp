@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "reverb.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -159,7 +160,7 @@ void setup(ReverbBox* self, std::shared_ptr<Reverb> reverb, const std::string& s
 
   self->data->reverb = reverb;
 
-  self->settings = g_settings_new_with_path(tags::schema::reverb::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::reverb::id, schema_path.c_str());
 
   reverb->set_post_messages(true);
 
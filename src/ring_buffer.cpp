@@ -0,0 +1,96 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ring_buffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+void RingBuffer::resize(const size_t& capacity) {
+  buffer.assign(capacity, 0.0F);
+
+  reset();
+}
+
+void RingBuffer::reset() {
+  write_count = 0U;
+  read_count = 0U;
+}
+
+auto RingBuffer::write(std::span<const float> data) -> size_t {
+  if (buffer.empty()) {
+    return 0U;
+  }
+
+  const auto w = write_count.load(std::memory_order_relaxed);
+  const auto r = read_count.load(std::memory_order_acquire);
+
+  const auto count = std::min(data.size(), buffer.size() - (w - r));
+
+  const auto pos = w % buffer.size();
+  const auto first = std::min(count, buffer.size() - pos);
+
+  std::copy_n(data.begin(), first, buffer.begin() + pos);
+  std::copy_n(data.begin() + first, count - first, buffer.begin());
+
+  write_count.store(w + count, std::memory_order_release);
+
+  return count;
+}
+
+auto RingBuffer::read(std::span<float> data) -> size_t {
+  if (buffer.empty()) {
+    return 0U;
+  }
+
+  const auto r = read_count.load(std::memory_order_relaxed);
+  const auto w = write_count.load(std::memory_order_acquire);
+
+  const auto count = std::min(data.size(), w - r);
+
+  const auto pos = r % buffer.size();
+  const auto first = std::min(count, buffer.size() - pos);
+
+  std::copy_n(buffer.begin() + pos, first, data.begin());
+  std::copy_n(buffer.begin(), count - first, data.begin() + first);
+
+  read_count.store(r + count, std::memory_order_release);
+
+  return count;
+}
+
+auto RingBuffer::skip(const size_t& count) -> size_t {
+  const auto r = read_count.load(std::memory_order_relaxed);
+  const auto w = write_count.load(std::memory_order_acquire);
+
+  const auto n = std::min(count, w - r);
+
+  read_count.store(r + n, std::memory_order_release);
+
+  return n;
+}
+
+auto RingBuffer::read_available() const -> size_t {
+  return write_count.load(std::memory_order_acquire) - read_count.load(std::memory_order_relaxed);
+}
+
+auto RingBuffer::write_available() const -> size_t {
+  return buffer.size() - (write_count.load(std::memory_order_relaxed) - read_count.load(std::memory_order_acquire));
+}
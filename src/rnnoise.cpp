@@ -35,6 +35,7 @@
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "resampler.hpp"
+#include "resource_catalog.hpp"
 #include "tags_plugin_name.hpp"
 #include "tags_resources.hpp"
 #include "util.hpp"
@@ -105,6 +106,10 @@ RNNoise::RNNoise(const std::string& tag,
                                           }),
                                           this));
 
+  // Blocks of any size are queued in the deques, and setup() reserves room for the largest quantum.
+
+  quantum_independent = true;
+
   setup_input_output_gain();
 
 #ifdef ENABLE_RNNOISE
@@ -198,6 +203,18 @@ void RNNoise::setup() {
   resampler_outL = std::make_unique<Resampler>(rnnoise_rate, rate);
   resampler_outR = std::make_unique<Resampler>(rnnoise_rate, rate);
 
+  const auto max_resampled = static_cast<size_t>(
+      std::ceil(static_cast<double>(max_quantum) * rnnoise_rate / static_cast<double>(rate)));
+
+  resampler_inL->reserve(max_quantum);
+  resampler_inR->reserve(max_quantum);
+
+  resampler_outL->reserve(max_resampled + blocksize);
+  resampler_outR->reserve(max_resampled + blocksize);
+
+  resampled_data_L.reserve(max_resampled + blocksize);
+  resampled_data_R.reserve(max_resampled + blocksize);
+
   resampler_ready = true;
 }
 
@@ -300,6 +317,8 @@ void RNNoise::process(std::span<float>& left_in,
     util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
 
     util::idle_add([this]() {
+      update_tail();
+
       if (!post_messages || latency.empty()) {
         return;
       }
@@ -340,11 +359,19 @@ auto RNNoise::search_model_path(const std::string& name) -> std::string {
       model_full_path = local_model_file.c_str();
     }
   } else {
-    // Search model in community package paths
-    for (const auto& xdg_model_dir : system_data_dir_rnnoise) {
-      if (util::search_filename(std::filesystem::path{xdg_model_dir + "/" + community_package}, model_filename,
-                                model_full_path, 3U)) {
-        break;
+    if (const auto& catalog = ResourceCatalog::get(); catalog.ready()) {
+      if (const auto entry = catalog.find(ResourceCatalog::Type::rnnoise, community_package, model_filename)) {
+        model_full_path = entry->path.string();
+      }
+    }
+
+    // Search model in community package paths when the catalogue does not know it yet
+    if (model_full_path.empty()) {
+      for (const auto& xdg_model_dir : system_data_dir_rnnoise) {
+        if (util::search_filename(std::filesystem::path{xdg_model_dir + "/" + community_package}, model_filename,
+                                  model_full_path, 3U)) {
+          break;
+        }
       }
     }
   }
@@ -429,6 +456,10 @@ auto RNNoise::get_latency_seconds() -> float {
   return latency_value;
 }
 
+auto RNNoise::get_quantum_preference(const uint& graph_rate) const -> QuantumPreference {
+  return {.frames = graph_rate * blocksize / rnnoise_rate};
+}
+
 void RNNoise::init_release() {
 #ifdef ENABLE_RNNOISE
 
@@ -89,6 +89,6 @@ void RNNoisePreset::load(const nlohmann::json& json) {
   const auto current_model_name = util::gsettings_get_string(settings, model_name_key);
 
   if (new_model_name != current_model_name) {
-    g_settings_set_string(settings, model_name_key, new_model_name.c_str());
+    stage_value(settings, model_name_key, g_variant_new_string(new_model_name.c_str()));
   }
 }
@@ -36,6 +36,7 @@
 #include "application.hpp"
 #include "config.h"
 #include "rnnoise.hpp"
+#include "settings_store.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
 #include "ui_helpers.hpp"
@@ -230,7 +231,7 @@ void setup(RNNoiseBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::rnnoise::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::rnnoise::id, schema_path.c_str());
 
   rnnoise->set_post_messages(true);
 
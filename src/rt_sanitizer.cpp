@@ -0,0 +1,303 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "rt_sanitizer.hpp"
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+/*
+  The functions below replace the ones of the C library for the whole process. The allocator is reached through its
+  glibc internal names, because dlsym() itself allocates. The other functions are looked up with dlsym() the first
+  time they are called.
+*/
+
+extern "C" {
+
+auto __libc_malloc(size_t size) -> void*;
+auto __libc_calloc(size_t n, size_t size) -> void*;
+auto __libc_realloc(void* ptr, size_t size) -> void*;
+auto __libc_memalign(size_t alignment, size_t size) -> void*;
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+constexpr size_t max_depth = 24U;
+
+constexpr size_t max_sites = 512U;
+
+// Call sites are compared when they are recorded, so a callback running on every quantum takes a single entry.
+
+struct Site {
+  std::atomic<bool> ready = false;
+
+  const char* function = nullptr;
+
+  int depth = 0;
+
+  std::array<void*, max_depth> frames{};
+
+  std::atomic<uint64_t> count = 0U;
+};
+
+std::array<Site, max_sites> sites;
+
+std::atomic<size_t> n_sites = 0U;
+
+std::atomic<uint64_t> n_dropped = 0U;
+
+thread_local bool realtime = false;
+
+thread_local bool recording = false;
+
+void record(const char* function) {
+  if (!realtime || recording) {
+    return;
+  }
+
+  recording = true;
+
+  std::array<void*, max_depth> frames{};
+
+  const auto depth = backtrace(frames.data(), static_cast<int>(frames.size()));
+
+  const auto n = std::min(n_sites.load(std::memory_order_acquire), max_sites);
+
+  bool found = false;
+
+  for (size_t i = 0U; i < n && !found; i++) {
+    auto& site = sites[i];
+
+    if (site.ready.load(std::memory_order_acquire) && site.function == function && site.depth == depth &&
+        std::equal(frames.begin(), frames.begin() + depth, site.frames.begin())) {
+      site.count.fetch_add(1U, std::memory_order_relaxed);
+
+      found = true;
+    }
+  }
+
+  if (!found) {
+    if (const auto i = n_sites.fetch_add(1U, std::memory_order_acq_rel); i < max_sites) {
+      auto& site = sites[i];
+
+      site.function = function;
+      site.depth = depth;
+      site.frames = frames;
+      site.count.store(1U, std::memory_order_relaxed);
+      site.ready.store(true, std::memory_order_release);
+    } else {
+      n_dropped.fetch_add(1U, std::memory_order_relaxed);
+    }
+  }
+
+  recording = false;
+}
+
+template <typename T>
+auto next_symbol(std::atomic<T>& cache, const char* name) -> T {
+  auto function = cache.load(std::memory_order_relaxed);
+
+  if (function == nullptr) {
+    function = reinterpret_cast<T>(dlsym(RTLD_NEXT, name));
+
+    cache.store(function, std::memory_order_relaxed);
+  }
+
+  return function;
+}
+
+std::atomic<int (*)(pthread_mutex_t*)> real_mutex_lock = nullptr;
+
+std::atomic<int (*)(pthread_cond_t*, pthread_mutex_t*)> real_cond_wait = nullptr;
+
+std::atomic<int (*)(const timespec*, timespec*)> real_nanosleep = nullptr;
+
+std::atomic<int (*)(clockid_t, int, const timespec*, timespec*)> real_clock_nanosleep = nullptr;
+
+std::atomic<int (*)(useconds_t)> real_usleep = nullptr;
+
+std::atomic<int (*)()> real_sched_yield = nullptr;
+
+// backtrace() loads libgcc the first time it is called. That has to happen before any realtime block.
+
+__attribute__((constructor)) void initialize() {
+  std::array<void*, 1U> frames{};
+
+  backtrace(frames.data(), static_cast<int>(frames.size()));
+}
+
+__attribute__((destructor)) void write_report() {
+  const auto n = std::min(n_sites.load(), max_sites);
+
+  if (n == 0U) {
+    return;
+  }
+
+  const auto* path = std::getenv("EE_RT_SANITIZER_REPORT");
+
+  const auto fd = (path != nullptr) ? open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDERR_FILENO;
+
+  if (fd < 0) {
+    return;
+  }
+
+  dprintf(fd, "rt sanitizer: %zu call sites in realtime code\n", n);
+
+  for (size_t i = 0U; i < n; i++) {
+    const auto& site = sites[i];
+
+    if (!site.ready.load()) {
+      continue;
+    }
+
+    dprintf(fd, "\n%s called %llu times from:\n", site.function,
+            static_cast<unsigned long long>(site.count.load()));
+
+    // The first frame is record().
+
+    backtrace_symbols_fd(site.frames.data() + 1, site.depth - 1, fd);
+  }
+
+  if (const auto dropped = n_dropped.load(); dropped != 0U) {
+    dprintf(fd, "\n%llu calls from other sites were not recorded\n", static_cast<unsigned long long>(dropped));
+  }
+
+  if (fd != STDERR_FILENO) {
+    close(fd);
+  }
+}
+
+}  // namespace
+
+namespace rt_sanitizer {
+
+ScopedRealtime::ScopedRealtime() : previous(realtime) {
+  realtime = true;
+}
+
+ScopedRealtime::~ScopedRealtime() {
+  realtime = previous;
+}
+
+ScopedAllowed::ScopedAllowed() : previous(realtime) {
+  realtime = false;
+}
+
+ScopedAllowed::~ScopedAllowed() {
+  realtime = previous;
+}
+
+}  // namespace rt_sanitizer
+
+// NOLINTBEGIN(readability-inconsistent-declaration-parameter-name)
+
+extern "C" {
+
+auto malloc(size_t size) noexcept -> void* {
+  record("malloc");
+
+  return __libc_malloc(size);
+}
+
+auto calloc(size_t n, size_t size) noexcept -> void* {
+  record("calloc");
+
+  return __libc_calloc(n, size);
+}
+
+auto realloc(void* ptr, size_t size) noexcept -> void* {
+  record("realloc");
+
+  return __libc_realloc(ptr, size);
+}
+
+auto aligned_alloc(size_t alignment, size_t size) noexcept -> void* {
+  record("aligned_alloc");
+
+  return __libc_memalign(alignment, size);
+}
+
+auto posix_memalign(void** ptr, size_t alignment, size_t size) noexcept -> int {
+  record("posix_memalign");
+
+  *ptr = __libc_memalign(alignment, size);
+
+  return (*ptr != nullptr || size == 0U) ? 0 : ENOMEM;
+}
+
+void free(void* ptr) noexcept {
+  if (ptr != nullptr) {
+    record("free");
+  }
+
+  __libc_free(ptr);
+}
+
+auto pthread_mutex_lock(pthread_mutex_t* mutex) noexcept -> int {
+  record("pthread_mutex_lock");
+
+  return next_symbol(real_mutex_lock, "pthread_mutex_lock")(mutex);
+}
+
+auto pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) -> int {
+  record("pthread_cond_wait");
+
+  return next_symbol(real_cond_wait, "pthread_cond_wait")(cond, mutex);
+}
+
+auto nanosleep(const timespec* duration, timespec* remaining) -> int {
+  record("nanosleep");
+
+  return next_symbol(real_nanosleep, "nanosleep")(duration, remaining);
+}
+
+auto clock_nanosleep(clockid_t clock, int flags, const timespec* duration, timespec* remaining) -> int {
+  record("clock_nanosleep");
+
+  return next_symbol(real_clock_nanosleep, "clock_nanosleep")(clock, flags, duration, remaining);
+}
+
+auto usleep(useconds_t duration) -> int {
+  record("usleep");
+
+  return next_symbol(real_usleep, "usleep")(duration);
+}
+
+auto sched_yield() noexcept -> int {
+  record("sched_yield");
+
+  return next_symbol(real_sched_yield, "sched_yield")();
+}
+}
+
+// NOLINTEND(readability-inconsistent-declaration-parameter-name)
@@ -0,0 +1,128 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "settings_store.hpp"
+#include <gio/gio.h>
+#include <glib-object.h>
+#include <glib.h>
+#include <sys/types.h>
+#include <map>
+#include <ranges>
+#include <string>
+
+namespace {
+
+constexpr auto flush_interval = 500U;  // milliseconds
+
+// GSettings does not handle large delayed trees well (see issue #2215). Like util::reset_all_keys_except the changes
+// are sent before they reach the limit.
+
+constexpr auto max_pending_changes = 128U;
+
+struct Entry {
+  std::string key;
+
+  GSettings* settings = nullptr;
+
+  guint source_id = 0U;
+
+  uint pending_changes = 0U;
+};
+
+std::map<std::string, Entry*> entries;
+
+void apply(Entry* entry) {
+  if (entry->source_id != 0U) {
+    g_source_remove(entry->source_id);
+
+    entry->source_id = 0U;
+  }
+
+  entry->pending_changes = 0U;
+
+  if (g_settings_get_has_unapplied(entry->settings) != 0) {
+    g_settings_apply(entry->settings);
+  }
+}
+
+void on_changed(GSettings* settings, char* key, Entry* entry) {
+  if (g_settings_get_has_unapplied(settings) == 0) {
+    return;
+  }
+
+  if (++entry->pending_changes >= max_pending_changes) {
+    apply(entry);
+
+    return;
+  }
+
+  if (entry->source_id == 0U) {
+    entry->source_id = g_timeout_add(flush_interval, GSourceFunc(+[](Entry* entry) {
+                                       entry->source_id = 0U;
+
+                                       apply(entry);
+
+                                       return G_SOURCE_REMOVE;
+                                     }),
+                                     entry);
+  }
+}
+
+void on_last_unref(Entry* entry, GObject* object) {
+  // The object is being disposed but its backend is still there.
+
+  apply(entry);
+
+  entries.erase(entry->key);
+
+  delete entry;
+}
+
+}  // namespace
+
+namespace settings_store {
+
+auto get(const char* schema_id, const char* path) -> GSettings* {
+  auto key = std::string(schema_id) + ":" + path;
+
+  if (auto it = entries.find(key); it != entries.end()) {
+    return static_cast<GSettings*>(g_object_ref(it->second->settings));
+  }
+
+  auto* entry = new Entry{.key = key, .settings = g_settings_new_with_path(schema_id, path)};
+
+  g_settings_delay(entry->settings);
+
+  g_signal_connect(entry->settings, "changed", G_CALLBACK(on_changed), entry);
+
+  g_object_weak_ref(G_OBJECT(entry->settings), GWeakNotify(on_last_unref), entry);
+
+  entries[key] = entry;
+
+  return entry->settings;
+}
+
+void flush() {
+  for (auto* entry : entries | std::views::values) {
+    apply(entry);
+  }
+}
+
+}  // namespace settings_store
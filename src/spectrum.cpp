@@ -30,6 +30,8 @@
 #include <numbers>
 #include <span>
 #include <string>
+#include <vector>
+#include "fftw_planner.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -47,7 +49,16 @@ Spectrum::Spectrum(const std::string& tag,
 
   complex_output = fftwf_alloc_complex(n_bands);
 
-  plan = fftwf_plan_dft_r2c_1d(static_cast<int>(n_bands), real_input.data(), complex_output, FFTW_ESTIMATE);
+  {
+    std::scoped_lock<std::mutex> lock(fftw_planner::mutex);
+
+    plan = fftwf_plan_dft_r2c_1d(static_cast<int>(n_bands), real_input.data(), complex_output, FFTW_ESTIMATE);
+  }
+
+  n_points = static_cast<uint>(g_settings_get_int(settings, "n-points"));
+
+  min_frequency = static_cast<double>(g_settings_get_int(settings, "minimum-frequency"));
+  max_frequency = static_cast<double>(g_settings_get_int(settings, "maximum-frequency"));
 
   g_signal_connect(settings, "changed::show", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
                      auto* self = static_cast<Spectrum*>(user_data);
@@ -57,6 +68,45 @@ Spectrum::Spectrum(const std::string& tag,
                      self->bypass = g_settings_get_boolean(settings, key) == 0;
                    }),
                    this);
+
+  g_signal_connect(settings, "changed::n-points", G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                     auto* self = static_cast<Spectrum*>(user_data);
+
+                     std::scoped_lock<std::mutex> lock(self->data_mutex);
+
+                     self->n_points = static_cast<uint>(g_settings_get_int(settings, key));
+
+                     self->init_display_points();
+                   }),
+                   this);
+
+  g_signal_connect(settings, "changed::minimum-frequency",
+                   G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                     auto* self = static_cast<Spectrum*>(user_data);
+
+                     std::scoped_lock<std::mutex> lock(self->data_mutex);
+
+                     self->min_frequency = static_cast<double>(g_settings_get_int(settings, key));
+
+                     self->init_display_points();
+                   }),
+                   this);
+
+  g_signal_connect(settings, "changed::maximum-frequency",
+                   G_CALLBACK(+[](GSettings* settings, char* key, gpointer user_data) {
+                     auto* self = static_cast<Spectrum*>(user_data);
+
+                     std::scoped_lock<std::mutex> lock(self->data_mutex);
+
+                     self->max_frequency = static_cast<double>(g_settings_get_int(settings, key));
+
+                     self->init_display_points();
+                   }),
+                   this);
+
+  // The deque keeps its length whatever the block size, so only rate changes need a new setup().
+
+  quantum_independent = true;
 }
 
 Spectrum::~Spectrum() {
@@ -72,7 +122,11 @@ Spectrum::~Spectrum() {
     fftwf_free(complex_output);
   }
 
-  fftwf_destroy_plan(plan);
+  {
+    std::scoped_lock<std::mutex> fftw_lock(fftw_planner::mutex);
+
+    fftwf_destroy_plan(plan);
+  }
 
   util::debug(log_tag + name + " destroyed");
 }
@@ -93,6 +147,75 @@ void Spectrum::setup() {
       deque_in_mono.push_back(0.0F);
     }
   }
+
+  std::scoped_lock<std::mutex> lock(data_mutex);
+
+  init_display_points();
+}
+
+/*
+  Each display point averages the power of the bins between the geometric middles with its neighbours. At low
+  frequencies the points are closer than the bins and the power is linearly interpolated between the two bins around
+  the point instead. The weights only depend on the rate and on the axis settings, so they are computed here once.
+*/
+
+void Spectrum::init_display_points() {
+  axis_serial++;
+
+  frequencies.clear();
+  points.clear();
+
+  weight_offsets.assign(1U, 0U);
+  weight_bins.clear();
+  weight_values.clear();
+
+  if (rate == 0U || min_frequency > max_frequency - 100.0) {
+    return;
+  }
+
+  frequencies = util::logspace(min_frequency, max_frequency, n_points);
+
+  if (frequencies.size() < 2U) {
+    frequencies.clear();
+
+    return;
+  }
+
+  points.resize(frequencies.size(), util::minimum_db_level);
+
+  const auto bin_width = static_cast<double>(rate) / static_cast<double>(n_bands);
+
+  const auto last_bin = static_cast<uint>(output.size()) - 1U;
+
+  const auto half_step = std::sqrt(frequencies[1] / frequencies[0]);  // the points are evenly spaced in log scale
+
+  for (const auto& f : frequencies) {
+    const auto first = static_cast<uint>(std::ceil(f / half_step / bin_width));
+    const auto last = std::min(static_cast<uint>(std::floor(f * half_step / bin_width)), last_bin);
+
+    if (last > first) {
+      const auto w = 1.0F / static_cast<float>(last - first + 1U);
+
+      for (uint i = first; i <= last; i++) {
+        weight_bins.push_back(i);
+        weight_values.push_back(w);
+      }
+    } else {
+      const auto position = std::min(f / bin_width, static_cast<double>(last_bin));
+
+      const auto i = std::min(static_cast<uint>(position), last_bin - 1U);
+
+      const auto t = static_cast<float>(position - static_cast<double>(i));
+
+      weight_bins.push_back(i);
+      weight_values.push_back(1.0F - t);
+
+      weight_bins.push_back(i + 1U);
+      weight_values.push_back(t);
+    }
+
+    weight_offsets.push_back(static_cast<uint>(weight_bins.size()));
+  }
 }
 
 void Spectrum::process(std::span<float>& left_in,
@@ -112,25 +235,33 @@ void Spectrum::process(std::span<float>& left_in,
     deque_in_mono.push_back(0.5F * (left_in[n] + right_in[n]));
   }
 
-  for (size_t n = 0; n < deque_in_mono.size(); n++) {
-    if (n < real_input.size()) {
-      // https :  // en.wikipedia.org/wiki/Hann_function
+  // Nobody looks at the spectrum between two notifications. The fft is only computed when one is sent.
+
+  if (send_notifications) {
+    for (size_t n = 0; n < deque_in_mono.size(); n++) {
+      if (n < real_input.size()) {
+        // https :  // en.wikipedia.org/wiki/Hann_function
 
-      const float w = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
-                                              static_cast<float>(real_input.size() - 1U)));
+        const float w = 0.5F * (1.0F - std::cos(2.0F * std::numbers::pi_v<float> * static_cast<float>(n) /
+                                                static_cast<float>(real_input.size() - 1U)));
 
-      real_input[n] = deque_in_mono[n] * w;
+        real_input[n] = deque_in_mono[n] * w;
+      }
     }
   }
 
   size_t count = 0U;
 
-  while (count < n_samples && !deque_in_mono.empty()) {
+  while (count < left_in.size() && !deque_in_mono.empty()) {
     deque_in_mono.pop_front();
 
     count++;
   }
 
+  if (!send_notifications) {
+    return;
+  }
+
   fftwf_execute(plan);
 
   for (uint i = 0U; i < output.size(); i++) {
@@ -138,20 +269,48 @@ void Spectrum::process(std::span<float>& left_in,
 
     sqr /= static_cast<float>(output.size() * output.size());
 
-    output[i] = static_cast<double>(sqr);
+    output[i] = sqr;
   }
 
-  if (send_notifications) {
-    util::idle_add([this]() {
-      if (bypass) {
-        return;
-      }
+  for (size_t k = 0U; k < points.size(); k++) {
+    float sum = 0.0F;
 
-      power.emit(rate, output.size(), output);
-    });
+    for (uint j = weight_offsets[k]; j < weight_offsets[k + 1U]; j++) {
+      sum += weight_values[j] * output[weight_bins[j]];
+    }
+
+    points[k] = (sum > 0.0F) ? std::max(10.0F * std::log10(sum), util::minimum_db_level) : util::minimum_db_level;
   }
+
+  util::idle_add([this]() {
+    if (bypass) {
+      return;
+    }
+
+    data_mutex.lock();
+
+    const auto serial = axis_serial;
+
+    auto magnitudes = points;
+
+    data_mutex.unlock();
+
+    power.emit(serial, magnitudes);
+  });
+}
+
+auto Spectrum::get_frequencies() -> std::vector<double> {
+  std::scoped_lock<std::mutex> lock(data_mutex);
+
+  return frequencies;
 }
 
 auto Spectrum::get_latency_seconds() -> float {
   return 0.0F;
 }
+
+auto Spectrum::get_tail_seconds() -> float {
+  // The last spectrum sent before the effect stops has to be computed from a silent window.
+
+  return static_cast<float>(n_bands) / static_cast<float>(rate) + notification_time_window;
+}
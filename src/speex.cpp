@@ -23,11 +23,13 @@
 #include <speex/speex_preprocess.h>
 #include <speex/speexdsp_config_types.h>
 #include <algorithm>
-#include <climits>
+#include <array>
 #include <cstddef>
 #include <mutex>
 #include <span>
 #include <string>
+#include "dsp.hpp"
+#include "frame_adapter.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
 #include "tags_plugin_name.hpp"
@@ -164,6 +166,10 @@ Speex::Speex(const std::string& tag,
       }),
       this));
 
+  // The adapter is sized for the largest quantum, so a new one does not need a new setup.
+
+  quantum_independent = true;
+
   setup_input_output_gain();
 }
 
@@ -182,12 +188,30 @@ Speex::~Speex() {
 void Speex::setup() {
   std::scoped_lock<std::mutex> lock(data_mutex);
 
-  latency_n_frames = 0U;
+  /*
+    The preprocessor runs at a fixed frame size, so its states only have to be created again when the rate changes. A
+    new quantum does not need a setup at all because the adapter accepts blocks up to max_quantum.
+  */
+
+  const uint frame_size = rate * frame_size_ms / 1000U;
+
+  adapter.set_frame_size(frame_size);
+  adapter.set_max_block_size(max_quantum);
+
+  latency_n_frames = adapter.get_latency();
+
+  notify_latency = true;
+
+  if (speex_ready && rate == speex_rate) {
+    return;
+  }
 
   speex_ready = false;
 
-  data_L.resize(n_samples);
-  data_R.resize(n_samples);
+  speex_rate = rate;
+
+  data_L.resize(frame_size);
+  data_R.resize(frame_size);
 
   if (state_left != nullptr) {
     speex_preprocess_state_destroy(state_left);
@@ -197,8 +221,8 @@ void Speex::setup() {
     speex_preprocess_state_destroy(state_right);
   }
 
-  state_left = speex_preprocess_state_init(static_cast<int>(n_samples), static_cast<int>(rate));
-  state_right = speex_preprocess_state_init(static_cast<int>(n_samples), static_cast<int>(rate));
+  state_left = speex_preprocess_state_init(static_cast<int>(frame_size), static_cast<int>(rate));
+  state_right = speex_preprocess_state_init(static_cast<int>(frame_size), static_cast<int>(rate));
 
   if (state_left != nullptr) {
     speex_preprocess_ctl(state_left, SPEEX_PREPROCESS_SET_DENOISE, &enable_denoise);
@@ -246,30 +270,33 @@ void Speex::process(std::span<float>& left_in,
     apply_gain(left_in, right_in, input_gain);
   }
 
-  for (size_t i = 0; i < n_samples; i++) {
-    data_L[i] = static_cast<spx_int16_t>(left_in[i] * (SHRT_MAX + 1));
+  const std::array<std::span<float>, 2U> inputs = {left_in, right_in};
+  const std::array<std::span<float>, 2U> outputs = {left_out, right_out};
 
-    data_R[i] = static_cast<spx_int16_t>(right_in[i] * (SHRT_MAX + 1));
-  }
+  adapter.process(inputs, outputs, [this](auto frame_in, auto frame_out) { remove_noise(frame_in, frame_out); });
 
-  if (speex_preprocess_run(state_left, data_L.data()) == 1) {
-    for (size_t i = 0; i < n_samples; i++) {
-      left_out[i] = static_cast<float>(data_L[i]) * inv_short_max;
-    }
-  } else {
-    std::ranges::fill(left_out, 0.0F);
+  if (output_gain != 1.0F) {
+    apply_gain(left_out, right_out, output_gain);
   }
 
-  if (speex_preprocess_run(state_right, data_R.data()) == 1) {
-    for (size_t i = 0; i < n_samples; i++) {
-      right_out[i] = static_cast<float>(data_R[i]) * inv_short_max;
-    }
-  } else {
-    std::ranges::fill(right_out, 0.0F);
-  }
+  if (notify_latency) {
+    latency_value = static_cast<float>(latency_n_frames) / static_cast<float>(rate);
 
-  if (output_gain != 1.0F) {
-    apply_gain(left_out, right_out, output_gain);
+    util::debug(log_tag + name + " latency: " + util::to_string(latency_value, "") + " s");
+
+    util::idle_add([this]() {
+      update_tail();
+
+      if (!post_messages || latency.empty()) {
+        return;
+      }
+
+      latency.emit();
+    });
+
+    update_filter_params();
+
+    notify_latency = false;
   }
 
   if (post_messages) {
@@ -281,6 +308,23 @@ void Speex::process(std::span<float>& left_in,
   }
 }
 
+void Speex::remove_noise(std::span<const std::span<float>> frame_in, std::span<const std::span<float>> frame_out) {
+  dsp::float_to_int16(frame_in[0], data_L);
+  dsp::float_to_int16(frame_in[1], data_R);
+
+  if (speex_preprocess_run(state_left, data_L.data()) == 1) {
+    dsp::int16_to_float(data_L, frame_out[0]);
+  } else {
+    std::ranges::fill(frame_out[0], 0.0F);
+  }
+
+  if (speex_preprocess_run(state_right, data_R.data()) == 1) {
+    dsp::int16_to_float(data_R, frame_out[1]);
+  } else {
+    std::ranges::fill(frame_out[1], 0.0F);
+  }
+}
+
 void Speex::free_speex() {
   if (state_left != nullptr) {
     speex_preprocess_state_destroy(state_left);
@@ -297,3 +341,7 @@ void Speex::free_speex() {
 auto Speex::get_latency_seconds() -> float {
   return latency_value;
 }
+
+auto Speex::get_quantum_preference(const uint& graph_rate) const -> QuantumPreference {
+  return {.frames = graph_rate * frame_size_ms / 1000U};
+}
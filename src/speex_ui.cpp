@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "application.hpp"
+#include "settings_store.hpp"
 #include "speex.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -96,7 +97,7 @@ void setup(SpeexBox* self,
 
   set_ignore_filter_idle_add(serial, false);
 
-  self->settings = g_settings_new_with_path(tags::schema::speex::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::speex::id, schema_path.c_str());
 
   speex->set_post_messages(true);
 
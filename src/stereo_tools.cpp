@@ -26,6 +26,7 @@
 #include <memory>
 #include <span>
 #include <string>
+#include "dsp.hpp"
 #include "lv2_wrapper.hpp"
 #include "pipe_manager.hpp"
 #include "plugin_base.hpp"
@@ -48,6 +49,8 @@ StereoTools::StereoTools(const std::string& tag,
 
   package_installed = lv2_wrapper->found_plugin;
 
+  quantum_independent = true;
+
   if (!package_installed) {
     util::debug(log_tag + "http://calf.sourceforge.net/plugins/StereoTools is not installed");
   }
@@ -153,11 +156,8 @@ void StereoTools::process(std::span<float>& left_in,
   lv2_wrapper->connect_data_ports(left_in, right_in, left_out, right_out);
   lv2_wrapper->run();
 
-  for (size_t n = 0; n < left_out.size(); n++) {
-    left_out[n] = wet * left_out[n] + dry * left_in[n];
-
-    right_out[n] = wet * right_out[n] + dry * right_in[n];
-  }
+  dsp::mix(left_out, wet, left_in, dry, left_out);
+  dsp::mix(right_out, wet, right_in, dry, right_out);
 
   if (output_gain != 1.0F) {
     apply_gain(left_out, right_out, output_gain);
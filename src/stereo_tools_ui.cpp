@@ -29,6 +29,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "settings_store.hpp"
 #include "stereo_tools.hpp"
 #include "tags_resources.hpp"
 #include "tags_schema.hpp"
@@ -90,7 +91,7 @@ void setup(StereoToolsBox* self, std::shared_ptr<StereoTools> stereo_tools, cons
 
   self->data->stereo_tools = stereo_tools;
 
-  self->settings = g_settings_new_with_path(tags::schema::stereo_tools::id, schema_path.c_str());
+  self->settings = settings_store::get(tags::schema::stereo_tools::id, schema_path.c_str());
 
   stereo_tools->set_post_messages(true);
 
@@ -63,11 +63,9 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
 
       if (g_settings_get_boolean(global_settings, "bypass") != 0) {
         g_settings_set_boolean(global_settings, "bypass", 0);
-
-        return;  // filter connected through update_bypass_state
       }
 
-      set_bypass(false);
+      relink();
     }
   }));
 
@@ -83,6 +81,12 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
   connections.push_back(pm->stream_output_added.connect(sigc::mem_fun(*this, &StreamOutputEffects::on_app_added)));
   connections.push_back(pm->link_changed.connect(sigc::mem_fun(*this, &StreamOutputEffects::on_link_changed)));
 
+  connections.push_back(relink_required.connect([this]() {
+    if (!list_proxies.empty()) {
+      relink();
+    }
+  }));
+
   connect_filters();
 
   gconnections.push_back(g_signal_connect(settings, "changed::output-device",
@@ -101,11 +105,9 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
 
                                                 if (g_settings_get_boolean(self->global_settings, "bypass") != 0) {
                                                   g_settings_set_boolean(self->global_settings, "bypass", 0);
-
-                                                  return;  // filter connected through update_bypass_state
                                                 }
 
-                                                self->set_bypass(false);
+                                                self->relink();
 
                                                 break;
                                               }
@@ -119,11 +121,9 @@ StreamOutputEffects::StreamOutputEffects(PipeManager* pipe_manager)
 
                                             if (g_settings_get_boolean(self->global_settings, "bypass") != 0) {
                                               g_settings_set_boolean(self->global_settings, "bypass", 0);
-
-                                              return;  // filter connected through update_bypass_state
                                             }
 
-                                            self->set_bypass(false);
+                                            self->relink();
                                           }),
                                           this));
 }
@@ -135,6 +135,17 @@ StreamOutputEffects::~StreamOutputEffects() {
 }
 
 void StreamOutputEffects::on_app_added(const NodeInfo node_info) {
+  switch (get_route(node_info)) {
+    case Route::effects:
+      pm->connect_stream_output(node_info.id);
+
+      return;
+    case Route::device:
+      return;
+    case Route::none:
+      break;
+  }
+
   const auto blocklist = util::gchar_array_to_vector(g_settings_get_strv(settings, "blocklist"));
 
   auto is_blocklisted = std::ranges::find(blocklist, node_info.application_id) != blocklist.end();
@@ -159,14 +170,6 @@ void StreamOutputEffects::on_link_changed(const LinkInfo link_info) {
     return;
   }
 
-  /*
-    If bypass is enabled do not touch the plugin pipeline
-  */
-
-  if (bypass) {
-    return;
-  }
-
   if (apps_want_to_play()) {
     if (list_proxies.empty()) {
       util::debug("At least one app linked to our device wants to play. Linking our filters.");
@@ -199,7 +202,7 @@ void StreamOutputEffects::on_link_changed(const LinkInfo link_info) {
   };
 }
 
-void StreamOutputEffects::connect_filters(const bool& bypass) {
+void StreamOutputEffects::connect_filters() {
   const auto output_device_name = util::gsettings_get_string(settings, "output-device");
 
   // checking if the output device exists
@@ -228,8 +231,11 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
     return;
   }
 
-  const auto list =
-      (bypass) ? std::vector<std::string>() : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+  const auto list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+
+  // effects merged into a Convolver kernel are not linked
+
+  const auto baked = bake_linear_sections(list);
 
   uint prev_node_id = pm->ee_sink_node.id;
   uint next_node_id = 0U;
@@ -238,7 +244,7 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
 
   if (!list.empty()) {
     for (const auto& name : list) {
-      if (!plugins.contains(name)) {
+      if (!plugins.contains(name) || std::ranges::find(baked, name) != baked.end()) {
         continue;
       }
 
@@ -281,7 +287,7 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
 
   // link spectrum and output level meter
 
-  for (const auto& node_id : {spectrum->get_node_id(), output_level->get_node_id()}) {
+  for (const auto& node_id : get_meter_node_ids()) {
     next_node_id = node_id;
 
     const auto links = pm->link_nodes(prev_node_id, next_node_id);
@@ -334,8 +340,7 @@ void StreamOutputEffects::connect_filters(const bool& bypass) {
 void StreamOutputEffects::disconnect_filters() {
   std::set<uint> link_id_list;
 
-  const auto selected_plugins_list =
-      (bypass) ? std::vector<std::string>() : util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
+  const auto selected_plugins_list = util::gchar_array_to_vector(g_settings_get_strv(settings, "plugins"));
 
   for (const auto& plugin : plugins | std::views::values) {
     for (const auto& link : pm->list_links) {
@@ -343,16 +348,10 @@ void StreamOutputEffects::disconnect_filters() {
         link_id_list.insert(link.id);
       }
     }
-
-    if (plugin->connected_to_pw) {
-      if (std::ranges::find(selected_plugins_list, plugin->name) == selected_plugins_list.end()) {
-        util::debug("disconnecting the " + plugin->name + " filter from PipeWire");
-
-        plugin->disconnect_from_pw();
-      }
-    }
   }
 
+  release_unused_filters(selected_plugins_list);
+
   for (const auto& link : pm->list_links) {
     if (link.input_node_id == spectrum->get_node_id() || link.output_node_id == spectrum->get_node_id() ||
         link.input_node_id == output_level->get_node_id() || link.output_node_id == output_level->get_node_id()) {
@@ -371,10 +370,8 @@ void StreamOutputEffects::disconnect_filters() {
   // remove_unused_filters();
 }
 
-void StreamOutputEffects::set_bypass(const bool& state) {
-  bypass = state;
-
+void StreamOutputEffects::relink() {
   disconnect_filters();
 
-  connect_filters(state);
+  connect_filters();
 }
@@ -0,0 +1,218 @@
+/*
+ *  Copyright © 2017-2024 Wellington Wallace
+ *
+ *  This file is part of Easy Effects.
+ *
+ *  Easy Effects is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Easy Effects is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Easy Effects. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "worker_pool.hpp"
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "util.hpp"
+
+namespace {
+
+constexpr auto max_threads = 4U;
+
+constexpr auto nice_level = 10;
+
+}  // namespace
+
+void WorkerPool::Task::cancel() {
+  cancelled = true;
+}
+
+auto WorkerPool::Task::is_cancelled() const -> bool {
+  return cancelled;
+}
+
+auto WorkerPool::Task::is_finished() const -> bool {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  return finished;
+}
+
+void WorkerPool::Task::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  cv.wait(lock, [this] { return finished; });
+}
+
+void WorkerPool::Task::finish() {
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    finished = true;
+
+    job = nullptr;
+  }
+
+  cv.notify_all();
+}
+
+WorkerPool::WorkerPool() {
+  const auto n_threads = std::clamp(std::thread::hardware_concurrency() / 2U, 1U, max_threads);
+
+  for (uint n = 0U; n < n_threads; n++) {
+    threads.emplace_back([this]() { run(); });
+  }
+
+  util::debug("worker pool started with " + util::to_string(n_threads) + " threads");
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    quit = true;
+  }
+
+  cv.notify_all();
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (auto& task : queue) {
+    task->finish();
+  }
+}
+
+auto WorkerPool::get() -> WorkerPool& {
+  static WorkerPool pool;
+
+  return pool;
+}
+
+auto WorkerPool::submit(const void* owner, std::function<void(const Task&)> job) -> std::shared_ptr<Task> {
+  auto task = std::make_shared<Task>();
+
+  task->owner = owner;
+  task->job = std::move(job);
+
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    queue.push_back(task);
+  }
+
+  cv.notify_all();
+
+  return task;
+}
+
+void WorkerPool::cancel_all(const void* owner) {
+  std::vector<std::shared_ptr<Task>> dropped;
+
+  std::unique_lock<std::mutex> lock(mutex);
+
+  for (auto it = queue.begin(); it != queue.end();) {
+    if ((*it)->owner == owner) {
+      (*it)->cancel();
+
+      dropped.push_back(*it);
+
+      it = queue.erase(it);
+    } else {
+      it++;
+    }
+  }
+
+  cv.wait(lock, [&] { return !busy_owners.contains(owner); });
+
+  lock.unlock();
+
+  for (auto& task : dropped) {
+    task->finish();
+  }
+}
+
+void WorkerPool::wait(const void* owner) {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  cv.wait(lock, [&] {
+    const auto pending = std::ranges::any_of(queue, [&](const auto& t) { return t->owner == owner; });
+
+    return !pending && !busy_owners.contains(owner);
+  });
+}
+
+// The first queued job whose owner is not busy. Cancelled jobs are dropped on the way.
+
+auto WorkerPool::next_task() -> std::shared_ptr<Task> {
+  for (auto it = queue.begin(); it != queue.end(); it++) {
+    const auto owner = (*it)->owner;
+
+    if (owner != nullptr && busy_owners.contains(owner)) {
+      continue;
+    }
+
+    auto task = *it;
+
+    queue.erase(it);
+
+    return task;
+  }
+
+  return nullptr;
+}
+
+void WorkerPool::run() {
+  // Linux keeps a nice value per thread. The realtime threads of PipeWire are not affected by it.
+
+  setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), nice_level);
+
+  while (true) {
+    std::shared_ptr<Task> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      cv.wait(lock, [&] { return quit || (task = next_task()) != nullptr; });
+
+      if (quit) {
+        if (task != nullptr) {
+          queue.push_front(task);
+        }
+
+        return;
+      }
+
+      if (task->owner != nullptr) {
+        busy_owners.insert(task->owner);
+      }
+    }
+
+    if (!task->is_cancelled()) {
+      task->job(*task);
+    }
+
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      busy_owners.erase(task->owner);
+    }
+
+    cv.notify_all();
+
+    task->finish();
+  }
+}